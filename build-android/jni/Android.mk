@@ -155,6 +155,7 @@ LOCAL_MODULE := VkLayerValidationTests
 LOCAL_SRC_FILES += $(SRC_DIR)/tests/layer_validation_tests.cpp \
 				   $(SRC_DIR)/tests/vklayertests.cpp \
 				   $(SRC_DIR)/tests/vkpositivelayertests.cpp \
+				   $(SRC_DIR)/tests/vkcontainertests.cpp \
                    $(SRC_DIR)/tests/vktestbinding.cpp \
                    $(SRC_DIR)/tests/vktestframeworkandroid.cpp \
 				   $(SRC_DIR)/tests/vklayertest.cpp \
@@ -182,6 +183,7 @@ LOCAL_MODULE := VulkanLayerValidationTests
 LOCAL_SRC_FILES += $(SRC_DIR)/tests/layer_validation_tests.cpp \
 				   $(SRC_DIR)/tests/vklayertests.cpp \
 				   $(SRC_DIR)/tests/vkpositivelayertests.cpp \
+				   $(SRC_DIR)/tests/vkcontainertests.cpp \
                    $(SRC_DIR)/tests/vktestbinding.cpp \
                    $(SRC_DIR)/tests/vktestframeworkandroid.cpp \
 				   $(SRC_DIR)/tests/vklayertest.cpp \
@@ -0,0 +1,78 @@
+/* Copyright (c) 2019 The Khronos Group Inc.
+ * Copyright (c) 2019 Valve Corporation
+ * Copyright (c) 2019 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#pragma once
+#ifndef ARENA_ALLOCATOR_H_
+#define ARENA_ALLOCATOR_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Bump allocator whose allocations are all released together.
+//
+// Memory comes from a list of chunks that is only ever appended to. Reset() rewinds to the first chunk without freeing
+// anything, so an owner that fills and resets the arena in a loop (such as a per-frame descriptor pool) stops calling
+// malloc once the arena has grown to its peak size. Nothing allocated here has its destructor run by the arena.
+class ArenaAllocator {
+   public:
+    explicit ArenaAllocator(size_t chunk_size = 64 * 1024) : chunk_size_(chunk_size), current_(0), offset_(0) {}
+    ArenaAllocator(const ArenaAllocator &) = delete;
+    ArenaAllocator &operator=(const ArenaAllocator &) = delete;
+
+    // alignment must be a power of two no larger than alignof(std::max_align_t)
+    void *Allocate(size_t size, size_t alignment) {
+        assert((alignment & (alignment - 1)) == 0 && alignment <= alignof(std::max_align_t));
+        while (current_ < chunks_.size()) {
+            const size_t offset = (offset_ + alignment - 1) & ~(alignment - 1);
+            if (offset + size <= chunks_[current_].size) {
+                offset_ = offset + size;
+                return chunks_[current_].data.get() + offset;
+            }
+            // Skip to the next chunk; what is left of this one is wasted until the next Reset()
+            ++current_;
+            offset_ = 0;
+        }
+        Chunk chunk;
+        chunk.size = (size > chunk_size_) ? size : chunk_size_;
+        chunk.data.reset(new unsigned char[chunk.size]);
+        chunks_.push_back(std::move(chunk));
+        current_ = chunks_.size() - 1;
+        offset_ = size;
+        return chunks_[current_].data.get();
+    }
+
+    void Reset() {
+        current_ = 0;
+        offset_ = 0;
+    }
+
+   private:
+    struct Chunk {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+
+    size_t chunk_size_;
+    std::vector<Chunk> chunks_;
+    size_t current_;  // Chunk being allocated from
+    size_t offset_;   // First free byte in the current chunk
+};
+
+#endif  // ARENA_ALLOCATOR_H_
@@ -148,154 +148,13 @@ VkImageSubresourceRange NormalizeSubresourceRange(const IMAGE_STATE &image_state
     return norm;
 }
 
-template <class OBJECT, class LAYOUT>
-void CoreChecks::SetLayout(OBJECT *pObject, VkImage image, VkImageSubresource range, const LAYOUT &layout) {
-    ImageSubresourcePair imgpair = {image, true, range};
-    SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_COLOR_BIT);
-    SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_DEPTH_BIT);
-    SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_STENCIL_BIT);
-    SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_METADATA_BIT);
-    if (device_extensions.vk_khr_sampler_ycbcr_conversion) {
-        SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_PLANE_0_BIT_KHR);
-        SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_PLANE_1_BIT_KHR);
-        SetLayout(pObject, imgpair, layout, VK_IMAGE_ASPECT_PLANE_2_BIT_KHR);
-    }
-}
-
-template <class OBJECT, class LAYOUT>
-void CoreChecks::SetLayout(OBJECT *pObject, ImageSubresourcePair imgpair, const LAYOUT &layout, VkImageAspectFlags aspectMask) {
-    if (imgpair.subresource.aspectMask & aspectMask) {
-        imgpair.subresource.aspectMask = aspectMask;
-        SetLayout(pObject, imgpair, layout);
-    }
-}
-
-// Set the layout in supplied map
-void CoreChecks::SetLayout(std::unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE> &imageLayoutMap,
-                           ImageSubresourcePair imgpair, VkImageLayout layout) {
-    auto it = imageLayoutMap.find(imgpair);
-    if (it != imageLayoutMap.end()) {
-        it->second.layout = layout;  // Update
-    } else {
-        imageLayoutMap[imgpair].layout = layout;  // Insert
-    }
-}
-
-bool CoreChecks::FindLayoutVerifyLayout(ImageSubresourcePair imgpair, VkImageLayout &layout, const VkImageAspectFlags aspectMask) {
-    if (!(imgpair.subresource.aspectMask & aspectMask)) {
-        return false;
-    }
-    VkImageAspectFlags oldAspectMask = imgpair.subresource.aspectMask;
-    imgpair.subresource.aspectMask = aspectMask;
-    auto imgsubIt = imageLayoutMap.find(imgpair);
-    if (imgsubIt == imageLayoutMap.end()) {
-        return false;
-    }
-    if (layout != VK_IMAGE_LAYOUT_MAX_ENUM && layout != imgsubIt->second.layout) {
-        log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, HandleToUint64(imgpair.image),
-                kVUID_Core_DrawState_InvalidLayout,
-                "Cannot query for VkImage %s layout when combined aspect mask %d has multiple layout types: %s and %s",
-                report_data->FormatHandle(imgpair.image).c_str(), oldAspectMask, string_VkImageLayout(layout),
-                string_VkImageLayout(imgsubIt->second.layout));
-    }
-    layout = imgsubIt->second.layout;
-    return true;
-}
-
-// Find layout(s) on the global level
-bool CoreChecks::FindGlobalLayout(ImageSubresourcePair imgpair, VkImageLayout &layout) {
-    layout = VK_IMAGE_LAYOUT_MAX_ENUM;
-    FindLayoutVerifyLayout(imgpair, layout, VK_IMAGE_ASPECT_COLOR_BIT);
-    FindLayoutVerifyLayout(imgpair, layout, VK_IMAGE_ASPECT_DEPTH_BIT);
-    FindLayoutVerifyLayout(imgpair, layout, VK_IMAGE_ASPECT_STENCIL_BIT);
-    FindLayoutVerifyLayout(imgpair, layout, VK_IMAGE_ASPECT_METADATA_BIT);
-    if (device_extensions.vk_khr_sampler_ycbcr_conversion) {
-        FindLayoutVerifyLayout(imgpair, layout, VK_IMAGE_ASPECT_PLANE_0_BIT_KHR);
-        FindLayoutVerifyLayout(imgpair, layout, VK_IMAGE_ASPECT_PLANE_1_BIT_KHR);
-        FindLayoutVerifyLayout(imgpair, layout, VK_IMAGE_ASPECT_PLANE_2_BIT_KHR);
-    }
-    if (layout == VK_IMAGE_LAYOUT_MAX_ENUM) {
-        imgpair = {imgpair.image, false, VkImageSubresource()};
-        auto imgsubIt = imageLayoutMap.find(imgpair);
-        if (imgsubIt == imageLayoutMap.end()) return false;
-        layout = imgsubIt->second.layout;
-    }
-    return true;
-}
-
 bool CoreChecks::FindLayouts(VkImage image, std::vector<VkImageLayout> &layouts) {
-    auto sub_data = imageSubresourceMap.find(image);
-    if (sub_data == imageSubresourceMap.end()) return false;
     auto image_state = GetImageState(image);
-    if (!image_state) return false;
-    bool ignoreGlobal = false;
-    // TODO: Make this robust for >1 aspect mask. Now it will just say ignore potential errors in this case.
-    if (sub_data->second.size() >= (image_state->createInfo.arrayLayers * image_state->createInfo.mipLevels + 1)) {
-        ignoreGlobal = true;
-    }
-    for (auto imgsubpair : sub_data->second) {
-        if (ignoreGlobal && !imgsubpair.hasSubresource) continue;
-        auto img_data = imageLayoutMap.find(imgsubpair);
-        if (img_data != imageLayoutMap.end()) {
-            layouts.push_back(img_data->second.layout);
-        }
-    }
+    if (!image_state || !image_state->global_layout_map) return false;
+    image_state->global_layout_map->GetLayouts(layouts);
     return true;
 }
 
-bool CoreChecks::FindLayout(const std::unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE> &imageLayoutMap,
-                            ImageSubresourcePair imgpair, VkImageLayout &layout, const VkImageAspectFlags aspectMask) {
-    if (!(imgpair.subresource.aspectMask & aspectMask)) {
-        return false;
-    }
-    imgpair.subresource.aspectMask = aspectMask;
-    auto imgsubIt = imageLayoutMap.find(imgpair);
-    if (imgsubIt == imageLayoutMap.end()) {
-        return false;
-    }
-    layout = imgsubIt->second.layout;
-    return true;
-}
-
-// find layout in supplied map
-bool CoreChecks::FindLayout(const std::unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE> &imageLayoutMap,
-                            ImageSubresourcePair imgpair, VkImageLayout &layout) {
-    layout = VK_IMAGE_LAYOUT_MAX_ENUM;
-    FindLayout(imageLayoutMap, imgpair, layout, VK_IMAGE_ASPECT_COLOR_BIT);
-    FindLayout(imageLayoutMap, imgpair, layout, VK_IMAGE_ASPECT_DEPTH_BIT);
-    FindLayout(imageLayoutMap, imgpair, layout, VK_IMAGE_ASPECT_STENCIL_BIT);
-    FindLayout(imageLayoutMap, imgpair, layout, VK_IMAGE_ASPECT_METADATA_BIT);
-    if (device_extensions.vk_khr_sampler_ycbcr_conversion) {
-        FindLayout(imageLayoutMap, imgpair, layout, VK_IMAGE_ASPECT_PLANE_0_BIT_KHR);
-        FindLayout(imageLayoutMap, imgpair, layout, VK_IMAGE_ASPECT_PLANE_1_BIT_KHR);
-        FindLayout(imageLayoutMap, imgpair, layout, VK_IMAGE_ASPECT_PLANE_2_BIT_KHR);
-    }
-    // Image+subresource not found, look for image handle w/o subresource
-    if (layout == VK_IMAGE_LAYOUT_MAX_ENUM) {
-        imgpair = {imgpair.image, false, VkImageSubresource()};
-        auto imgsubIt = imageLayoutMap.find(imgpair);
-        if (imgsubIt == imageLayoutMap.end()) return false;
-        layout = imgsubIt->second.layout;
-    }
-    return true;
-}
-
-// Set the layout on the global level
-void CoreChecks::SetGlobalLayout(ImageSubresourcePair imgpair, const VkImageLayout &layout) {
-    VkImage &image = imgpair.image;
-    auto data = imageLayoutMap.find(imgpair);
-    if (data != imageLayoutMap.end()) {
-        data->second.layout = layout;  // Update
-    } else {
-        imageLayoutMap[imgpair].layout = layout;  // Insert
-    }
-    auto &image_subresources = imageSubresourceMap[image];
-    auto subresource = std::find(image_subresources.begin(), image_subresources.end(), imgpair);
-    if (subresource == image_subresources.end()) {
-        image_subresources.push_back(imgpair);
-    }
-}
-
 // Set image layout for given VkImageSubresourceRange struct
 void CoreChecks::SetImageLayout(CMD_BUFFER_STATE *cb_node, const IMAGE_STATE &image_state,
                                 const VkImageSubresourceRange &image_subresource_range, VkImageLayout layout,
@@ -1118,6 +977,23 @@ bool CoreChecks::VerifyImageLayout(CMD_BUFFER_STATE const *cb_node, IMAGE_STATE
     }
     return skip;
 }
+
+bool CoreChecks::ImageLayoutMatchesUse(CMD_BUFFER_STATE const *cb_node, const IMAGE_STATE *image_state,
+                                       const VkImageSubresourceRange &range, VkImageAspectFlags aspect_mask,
+                                       VkImageLayout explicit_layout) const {
+    const auto *subresource_map = GetImageSubresourceLayoutMap(cb_node, image_state->image);
+    if (!subresource_map) return true;
+    bool matches = true;
+    LayoutUseCheckAndMessage layout_check(subresource_map, aspect_mask);
+    auto subresource_cb = [explicit_layout, &layout_check, &matches](const VkImageSubresource &subres, VkImageLayout layout,
+                                                                     VkImageLayout initial_layout) {
+        matches = layout_check.Check(subres, explicit_layout, layout, initial_layout);
+        return matches;
+    };
+    subresource_map->ForRange(range, subresource_cb);
+    return matches;
+}
+
 bool CoreChecks::VerifyImageLayout(CMD_BUFFER_STATE const *cb_node, IMAGE_STATE *image_state,
                                    const VkImageSubresourceLayers &subLayers, VkImageLayout explicit_layout,
                                    VkImageLayout optimal_layout, const char *caller, const char *layout_invalid_msg_code,
@@ -1450,18 +1326,13 @@ bool CoreChecks::PreCallValidateCreateImage(VkDevice device, const VkImageCreate
 void CoreChecks::PostCallRecordCreateImage(VkDevice device, const VkImageCreateInfo *pCreateInfo,
                                            const VkAllocationCallbacks *pAllocator, VkImage *pImage, VkResult result) {
     if (VK_SUCCESS != result) return;
-    IMAGE_LAYOUT_STATE image_state;
-    image_state.layout = pCreateInfo->initialLayout;
-    image_state.format = pCreateInfo->format;
     IMAGE_STATE *is_node = new IMAGE_STATE(*pImage, pCreateInfo);
+    is_node->global_layout_map = GlobalImageLayoutMapFactory(*is_node, pCreateInfo->initialLayout);
     if (device_extensions.vk_android_external_memory_android_hardware_buffer) {
         RecordCreateImageANDROID(pCreateInfo, is_node);
     }
     imageMap.insert(std::make_pair(*pImage, std::unique_ptr<IMAGE_STATE>(is_node)));
-    ImageSubresourcePair subpair{*pImage, false, VkImageSubresource()};
-    imageSubresourceMap[*pImage].push_back(subpair);
-    imageLayoutMap[subpair] = image_state;
-    imageLayoutMap[subpair] = image_state;
+    CacheStateInHandle(*pImage, is_node);
 }
 
 bool CoreChecks::PreCallValidateDestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks *pAllocator) {
@@ -1479,6 +1350,7 @@ void CoreChecks::PreCallRecordDestroyImage(VkDevice device, VkImage image, const
     IMAGE_STATE *image_state = GetImageState(image);
     const VulkanTypedHandle obj_struct(image, kVulkanObjectTypeImage);
     InvalidateCommandBuffers(image_state->cb_bindings, obj_struct);
+    ++descriptor_resource_epoch;
     // Clean up memory mapping, bindings and range references for image
     for (auto mem_binding : image_state->GetBoundMemory()) {
         auto mem_info = GetDevMemState(mem_binding);
@@ -1489,15 +1361,8 @@ void CoreChecks::PreCallRecordDestroyImage(VkDevice device, VkImage image, const
     ClearMemoryObjectBindings(obj_struct);
     EraseQFOReleaseBarriers<VkImageMemoryBarrier>(image);
     // Remove image from imageMap
+    ClearStateCachedInHandle(image);
     imageMap.erase(image);
-
-    const auto &sub_entry = imageSubresourceMap.find(image);
-    if (sub_entry != imageSubresourceMap.end()) {
-        for (const auto &pair : sub_entry->second) {
-            imageLayoutMap.erase(pair);
-        }
-        imageSubresourceMap.erase(sub_entry);
-    }
 }
 
 bool CoreChecks::ValidateImageAttributes(IMAGE_STATE *image_state, VkImageSubresourceRange range) {
@@ -3268,9 +3133,7 @@ void CoreChecks::PreCallRecordCmdBlitImage(VkCommandBuffer commandBuffer, VkImag
 }
 
 // This validates that the initial layout specified in the command buffer for the IMAGE is the same as the global IMAGE layout
-bool CoreChecks::ValidateCmdBufImageLayouts(
-    CMD_BUFFER_STATE *pCB, std::unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE> const &globalImageLayoutMap,
-    std::unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE> &overlayLayoutMap) {
+bool CoreChecks::ValidateCmdBufImageLayouts(CMD_BUFFER_STATE *pCB, GlobalImageLayoutMap::OverlayMap &overlayLayoutMap) {
     bool skip = false;
     // Iterate over the layout maps for each referenced image
     for (const auto &layout_map_entry : pCB->image_layout_map) {
@@ -3278,45 +3141,61 @@ bool CoreChecks::ValidateCmdBufImageLayouts(
         const auto *image_state = GetImageState(image);
         if (!image_state) continue;  // Can't check layouts of a dead image
         const auto &subres_map = layout_map_entry.second;
-        ImageSubresourcePair isr_pair;
-        isr_pair.image = image;
-        isr_pair.hasSubresource = true;
-
-        // Validate the initial_uses for each subresource referenced
-        for (auto it_init = subres_map->BeginInitialUse(); !it_init.AtEnd(); ++it_init) {
-            isr_pair.subresource = (*it_init).subresource;
-            VkImageLayout initial_layout = (*it_init).layout;
-            VkImageLayout image_layout;
-            if (FindLayout(overlayLayoutMap, isr_pair, image_layout) || FindLayout(globalImageLayoutMap, isr_pair, image_layout)) {
-                if (initial_layout == VK_IMAGE_LAYOUT_UNDEFINED) {
-                    // TODO: Set memory invalid which is in mem_tracker currently
-                } else if (image_layout != initial_layout) {
-                    // Need to look up the inital layout *state* to get a bit more information
-                    const auto *initial_layout_state = subres_map->GetSubresourceInitialLayoutState(isr_pair.subresource);
-                    assert(initial_layout_state);  // There's no way we should have an initial layout without matching state...
-                    bool matches = ImageLayoutMatches(initial_layout_state->aspect_mask, image_layout, initial_layout);
-                    if (!matches) {
+        const auto &global_map = image_state->global_layout_map;
+
+        // Summaries are made at vkEndCommandBuffer, but a command buffer still being recorded can be submitted in error
+        auto summary_it = pCB->image_layout_summaries.find(image);
+        if (summary_it == pCB->image_layout_summaries.end()) {
+            summary_it = pCB->image_layout_summaries.emplace(image, CMD_BUFFER_STATE::ImageLayoutSummary()).first;
+            subres_map->GetInitialUseRuns(summary_it->second.initial_uses);
+        }
+        auto &summary = summary_it->second;
+
+        // The overlay holds the layouts set by the earlier command buffers of this submission
+        auto overlay_it = overlayLayoutMap.find(image);
+        const bool global_only = (overlay_it == overlayLayoutMap.end());
+        if (global_only) {
+            overlay_it = overlayLayoutMap.emplace(image, GlobalImageLayoutMapFactory(*image_state, kInvalidLayout)).first;
+        }
+        auto &overlay_map = overlay_it->second;
+
+        // A resubmission against unchanged global layouts would find what it found last time
+        if (!global_only || (summary.validated_version != global_map->Version())) {
+            // Validate the initial_uses for each run of subresources referenced
+            bool mismatched = false;
+            for (const auto &run : summary.initial_uses) {
+                VkImageSubresource subresource = run.subresource;
+                const uint32_t end_layer = subresource.arrayLayer + run.layer_count;
+                while (subresource.arrayLayer < end_layer) {
+                    uint32_t layer_count = end_layer - subresource.arrayLayer;
+                    VkImageLayout image_layout = overlay_map->GetSubresourceLayoutRun(subresource, &layer_count);
+                    if (image_layout == kInvalidLayout) {
+                        image_layout = global_map->GetSubresourceLayoutRun(subresource, &layer_count);
+                    }
+                    if ((image_layout != kInvalidLayout) && !ImageLayoutMatches(run.aspect_mask, image_layout, run.layout)) {
+                        mismatched = true;
                         std::string formatted_label = FormatDebugLabel(" ", pCB->debug_label);
-                        skip |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT,
-                                        HandleToUint64(pCB->commandBuffer), kVUID_Core_DrawState_InvalidImageLayout,
-                                        "Submitted command buffer expects image %s  (subresource: aspectMask 0x%X array layer %u, "
-                                        "mip level %u) "
-                                        "to be in layout %s--instead, current layout is %s.%s",
-                                        report_data->FormatHandle(image).c_str(), isr_pair.subresource.aspectMask,
-                                        isr_pair.subresource.arrayLayer, isr_pair.subresource.mipLevel,
-                                        string_VkImageLayout(initial_layout), string_VkImageLayout(image_layout),
-                                        formatted_label.c_str());
+                        const uint32_t end_mismatch = subresource.arrayLayer + layer_count;
+                        for (uint32_t layer = subresource.arrayLayer; layer < end_mismatch; ++layer) {
+                            skip |= log_msg(
+                                report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT,
+                                HandleToUint64(pCB->commandBuffer), kVUID_Core_DrawState_InvalidImageLayout,
+                                "Submitted command buffer expects image %s  (subresource: aspectMask 0x%X array layer %u, "
+                                "mip level %u) "
+                                "to be in layout %s--instead, current layout is %s.%s",
+                                report_data->FormatHandle(image).c_str(), subresource.aspectMask, layer, subresource.mipLevel,
+                                string_VkImageLayout(run.layout), string_VkImageLayout(image_layout), formatted_label.c_str());
+                        }
                     }
+                    subresource.arrayLayer += layer_count;
                 }
             }
+            // Only a clean result is worth remembering, errors are reported at every submission
+            if (global_only && !mismatched) summary.validated_version = global_map->Version();
         }
 
         // Update all layout set operations (which will be a subset of the initial_layouts
-        for (auto it_set = subres_map->BeginSetLayout(); !it_set.AtEnd(); ++it_set) {
-            VkImageLayout layout = (*it_set).layout;
-            isr_pair.subresource = (*it_set).subresource;
-            SetLayout(overlayLayoutMap, isr_pair, layout);
-        }
+        overlay_map->UpdateFrom(*subres_map);
     }
 
     return skip;
@@ -3325,19 +3204,18 @@ bool CoreChecks::ValidateCmdBufImageLayouts(
 void CoreChecks::UpdateCmdBufImageLayouts(CMD_BUFFER_STATE *pCB) {
     for (const auto &layout_map_entry : pCB->image_layout_map) {
         const auto image = layout_map_entry.first;
-        const auto *image_state = GetImageState(image);
+        auto *image_state = GetImageState(image);
         if (!image_state) continue;  // Can't set layouts of a dead image
         const auto &subres_map = layout_map_entry.second;
-        ImageSubresourcePair isr_pair;
-        isr_pair.image = image;
-        isr_pair.hasSubresource = true;
+        auto &global_map = image_state->global_layout_map;
+
+        // Unchanged since this command buffer last set its layouts, so they're all still in place
+        auto &summary = pCB->image_layout_summaries[image];
+        if (summary.applied_version == global_map->Version()) continue;
 
         // Update all layout set operations (which will be a subset of the initial_layouts
-        for (auto it_set = subres_map->BeginSetLayout(); !it_set.AtEnd(); ++it_set) {
-            VkImageLayout layout = (*it_set).layout;
-            isr_pair.subresource = (*it_set).subresource;
-            SetGlobalLayout(isr_pair, layout);
-        }
+        global_map->UpdateFrom(*subres_map);
+        summary.applied_version = global_map->Version();
     }
 }
 
@@ -3855,7 +3733,9 @@ void CoreChecks::PostCallRecordCreateBuffer(VkDevice device, const VkBufferCreat
                                             const VkAllocationCallbacks *pAllocator, VkBuffer *pBuffer, VkResult result) {
     if (result != VK_SUCCESS) return;
     // TODO : This doesn't create deep copy of pQueueFamilyIndices so need to fix that if/when we want that data to be valid
-    bufferMap.insert(std::make_pair(*pBuffer, std::unique_ptr<BUFFER_STATE>(new BUFFER_STATE(*pBuffer, pCreateInfo))));
+    BUFFER_STATE *buffer_state = new BUFFER_STATE(*pBuffer, pCreateInfo);
+    bufferMap.insert(std::make_pair(*pBuffer, std::unique_ptr<BUFFER_STATE>(buffer_state)));
+    CacheStateInHandle(*pBuffer, buffer_state);
 }
 
 bool CoreChecks::PreCallValidateCreateBufferView(VkDevice device, const VkBufferViewCreateInfo *pCreateInfo,
@@ -3902,6 +3782,7 @@ void CoreChecks::PostCallRecordCreateBufferView(VkDevice device, const VkBufferV
                                                 const VkAllocationCallbacks *pAllocator, VkBufferView *pView, VkResult result) {
     if (result != VK_SUCCESS) return;
     bufferViewMap[*pView] = std::unique_ptr<BUFFER_VIEW_STATE>(new BUFFER_VIEW_STATE(*pView, pCreateInfo));
+    CacheStateInHandle(*pView, bufferViewMap[*pView].get());
 }
 
 // For the given format verify that the aspect masks make sense
@@ -4307,6 +4188,7 @@ void CoreChecks::PostCallRecordCreateImageView(VkDevice device, const VkImageVie
     if (result != VK_SUCCESS) return;
     auto image_state = GetImageState(pCreateInfo->image);
     imageViewMap[*pView] = std::unique_ptr<IMAGE_VIEW_STATE>(new IMAGE_VIEW_STATE(image_state, *pView, pCreateInfo));
+    CacheStateInHandle(*pView, imageViewMap[*pView].get());
 }
 
 bool CoreChecks::PreCallValidateCmdCopyBuffer(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, VkBuffer dstBuffer,
@@ -4380,6 +4262,8 @@ void CoreChecks::PreCallRecordDestroyImageView(VkDevice device, VkImageView imag
 
     // Any bound cmd buffers are now invalid
     InvalidateCommandBuffers(image_view_state->cb_bindings, obj_struct);
+    ++descriptor_resource_epoch;
+    ClearStateCachedInHandle(imageView);
     imageViewMap.erase(imageView);
 }
 
@@ -4399,6 +4283,13 @@ void CoreChecks::PreCallRecordDestroyBuffer(VkDevice device, VkBuffer buffer, co
     const VulkanTypedHandle obj_struct(buffer, kVulkanObjectTypeBuffer);
 
     InvalidateCommandBuffers(buffer_state->cb_bindings, obj_struct);
+    ++descriptor_resource_epoch;
+    // Vertex buffers aren't bound to the cmd buffers drawing with them, so find any in flight holding this one in use
+    if (buffer_state->in_use.load()) {
+        for (const auto &cb_entry : commandBufferMap) {
+            if (cb_entry.second->draw_vertex_buffers.count(buffer)) cb_entry.second->in_use_refs_stale = true;
+        }
+    }
     for (auto mem_binding : buffer_state->GetBoundMemory()) {
         auto mem_info = GetDevMemState(mem_binding);
         if (mem_info) {
@@ -4407,6 +4298,7 @@ void CoreChecks::PreCallRecordDestroyBuffer(VkDevice device, VkBuffer buffer, co
     }
     ClearMemoryObjectBindings(obj_struct);
     EraseQFOReleaseBarriers<VkBufferMemoryBarrier>(buffer);
+    ClearStateCachedInHandle(buffer);
     bufferMap.erase(buffer_state->buffer);
 }
 
@@ -4429,6 +4321,8 @@ void CoreChecks::PreCallRecordDestroyBufferView(VkDevice device, VkBufferView bu
 
     // Any bound cmd buffers are now invalid
     InvalidateCommandBuffers(buffer_view_state->cb_bindings, obj_struct);
+    ++descriptor_resource_epoch;
+    ClearStateCachedInHandle(bufferView);
     bufferViewMap.erase(bufferView);
 }
 
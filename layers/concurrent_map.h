@@ -0,0 +1,105 @@
+/* Copyright (c) 2019 The Khronos Group Inc.
+ * Copyright (c) 2019 Valve Corporation
+ * Copyright (c) 2019 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#pragma once
+#ifndef CONCURRENT_MAP_H_
+#define CONCURRENT_MAP_H_
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "cast_utils.h"
+#include "rw_lock.h"
+
+// Unordered map that is safe to use from multiple threads without external locking.
+//
+// The keys are spread over 2^kShardBits shards, each an unordered_map with its own reader/writer lock, so that lookups
+// never contend with each other and updates only contend with operations that land in the same shard. Keys must be
+// handles, unique ids or other values of at most 64 bits, since the shard is picked from their bits.
+//
+// Lookups return copies of the mapped value rather than iterators, since an iterator would outlive the shard lock.
+template <typename Key, typename T, int kShardBits = 4, typename Hash = std::hash<Key>>
+class ConcurrentUnorderedMap {
+   public:
+    // Insert, or overwrite the mapped value if the key is already present
+    void insert_or_assign(const Key &key, const T &value) {
+        Shard &shard = GetShard(key);
+        write_lock_guard_t lock(shard.lock, LockMode::kExclusive);
+        shard.map[key] = value;
+    }
+
+    // Insert only if the key is not present. Returns true if the value was inserted.
+    bool insert(const Key &key, const T &value) {
+        Shard &shard = GetShard(key);
+        write_lock_guard_t lock(shard.lock, LockMode::kExclusive);
+        return shard.map.emplace(key, value).second;
+    }
+
+    // Returns {true, value} if present, or {false, T()} otherwise
+    std::pair<bool, T> find(const Key &key) const {
+        const Shard &shard = GetShard(key);
+        read_lock_guard_t lock(shard.lock, LockMode::kShared);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) return std::make_pair(false, T());
+        return std::make_pair(true, it->second);
+    }
+
+    bool contains(const Key &key) const { return find(key).first; }
+
+    // Remove the key and return what it mapped to, with the same convention as find()
+    std::pair<bool, T> pop(const Key &key) {
+        Shard &shard = GetShard(key);
+        write_lock_guard_t lock(shard.lock, LockMode::kExclusive);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) return std::make_pair(false, T());
+        std::pair<bool, T> result(true, std::move(it->second));
+        shard.map.erase(it);
+        return result;
+    }
+
+    size_t erase(const Key &key) {
+        Shard &shard = GetShard(key);
+        write_lock_guard_t lock(shard.lock, LockMode::kExclusive);
+        return shard.map.erase(key);
+    }
+
+   private:
+    static const int kShardCount = 1 << kShardBits;
+
+    // Shards are cache line aligned so that threads working in different shards don't share lines
+    struct alignas(64) Shard {
+        mutable ReadWriteMutex lock;
+        std::unordered_map<Key, T, Hash> map;
+    };
+
+    // Unique ids are handed out sequentially, so the low bits alone spread them well; the upper half is folded in for
+    // keys that are pointers.
+    static uint32_t ShardIndex(const Key &key) {
+        const uint64_t u64 = CastToUint64(key);
+        uint32_t hash = static_cast<uint32_t>(u64) ^ static_cast<uint32_t>(u64 >> 32);
+        hash ^= (hash >> kShardBits) ^ (hash >> (2 * kShardBits));
+        return hash & (kShardCount - 1);
+    }
+    Shard &GetShard(const Key &key) { return shards_[ShardIndex(key)]; }
+    const Shard &GetShard(const Key &key) const { return shards_[ShardIndex(key)]; }
+
+    Shard shards_[kShardCount];
+};
+
+#endif  // CONCURRENT_MAP_H_
@@ -55,6 +55,16 @@
 #include <string>
 #include <valarray>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define CORE_VALIDATION_USE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "vk_loader_platform.h"
 #include "vk_dispatch_table_helper.h"
 #include "vk_enum_string_helper.h"
@@ -117,6 +127,7 @@ static const VkDeviceMemory MEMORY_UNBOUND = VkDeviceMemory(~((uint64_t)(0)) - 1
 
 // Return buffer state ptr for specified buffer or else NULL
 BUFFER_STATE *CoreChecks::GetBufferState(VkBuffer buffer) {
+    if (auto cached = GetStateCachedInHandle<BUFFER_STATE>(buffer)) return cached;
     auto buff_it = bufferMap.find(buffer);
     if (buff_it == bufferMap.end()) {
         return nullptr;
@@ -126,6 +137,7 @@ BUFFER_STATE *CoreChecks::GetBufferState(VkBuffer buffer) {
 
 // Return IMAGE_VIEW_STATE ptr for specified imageView or else NULL
 IMAGE_VIEW_STATE *CoreChecks::GetImageViewState(VkImageView image_view) {
+    if (auto cached = GetStateCachedInHandle<IMAGE_VIEW_STATE>(image_view)) return cached;
     auto iv_it = imageViewMap.find(image_view);
     if (iv_it == imageViewMap.end()) {
         return nullptr;
@@ -152,6 +164,7 @@ IMAGE_VIEW_STATE *CoreChecks::GetAttachmentImageViewState(FRAMEBUFFER_STATE *fra
 
 // Return sampler node ptr for specified sampler or else NULL
 SAMPLER_STATE *CoreChecks::GetSamplerState(VkSampler sampler) {
+    if (auto cached = GetStateCachedInHandle<SAMPLER_STATE>(sampler)) return cached;
     auto sampler_it = samplerMap.find(sampler);
     if (sampler_it == samplerMap.end()) {
         return nullptr;
@@ -160,6 +173,7 @@ SAMPLER_STATE *CoreChecks::GetSamplerState(VkSampler sampler) {
 }
 // Return image state ptr for specified image or else NULL
 IMAGE_STATE *CoreChecks::GetImageState(VkImage image) {
+    if (auto cached = GetStateCachedInHandle<IMAGE_STATE>(image)) return cached;
     auto img_it = imageMap.find(image);
     if (img_it == imageMap.end()) {
         return nullptr;
@@ -176,6 +190,7 @@ SWAPCHAIN_NODE *CoreChecks::GetSwapchainState(VkSwapchainKHR swapchain) {
 }
 // Return buffer node ptr for specified buffer or else NULL
 BUFFER_VIEW_STATE *CoreChecks::GetBufferViewState(VkBufferView buffer_view) {
+    if (auto cached = GetStateCachedInHandle<BUFFER_VIEW_STATE>(buffer_view)) return cached;
     auto bv_it = bufferViewMap.find(buffer_view);
     if (bv_it == bufferViewMap.end()) {
         return nullptr;
@@ -282,43 +297,53 @@ std::string FormatDebugLabel(const char *prefix, const LoggingLabel &label) {
 }
 
 // the ImageLayoutMap implementation bakes in the number of valid aspects -- we have to choose the correct one at construction time
-template <uint32_t kThreshold>
-static std::unique_ptr<ImageSubresourceLayoutMap> LayoutMapFactoryByAspect(const IMAGE_STATE &image_state) {
-    ImageSubresourceLayoutMap *map = nullptr;
+template <template <typename, size_t> class MapImpl, typename Map, uint32_t kThreshold>
+static std::unique_ptr<Map> LayoutMapFactoryByAspect(const IMAGE_STATE &image_state) {
+    Map *map = nullptr;
     switch (image_state.full_range.aspectMask) {
         case VK_IMAGE_ASPECT_COLOR_BIT:
-            map = new ImageSubresourceLayoutMapImpl<ColorAspectTraits, kThreshold>(image_state);
+            map = new MapImpl<ColorAspectTraits, kThreshold>(image_state);
             break;
         case VK_IMAGE_ASPECT_DEPTH_BIT:
-            map = new ImageSubresourceLayoutMapImpl<DepthAspectTraits, kThreshold>(image_state);
+            map = new MapImpl<DepthAspectTraits, kThreshold>(image_state);
             break;
         case VK_IMAGE_ASPECT_STENCIL_BIT:
-            map = new ImageSubresourceLayoutMapImpl<StencilAspectTraits, kThreshold>(image_state);
+            map = new MapImpl<StencilAspectTraits, kThreshold>(image_state);
             break;
         case VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT:
-            map = new ImageSubresourceLayoutMapImpl<DepthStencilAspectTraits, kThreshold>(image_state);
+            map = new MapImpl<DepthStencilAspectTraits, kThreshold>(image_state);
             break;
         case VK_IMAGE_ASPECT_PLANE_0_BIT | VK_IMAGE_ASPECT_PLANE_1_BIT:
-            map = new ImageSubresourceLayoutMapImpl<Multiplane2AspectTraits, kThreshold>(image_state);
+            map = new MapImpl<Multiplane2AspectTraits, kThreshold>(image_state);
             break;
         case VK_IMAGE_ASPECT_PLANE_0_BIT | VK_IMAGE_ASPECT_PLANE_1_BIT | VK_IMAGE_ASPECT_PLANE_2_BIT:
-            map = new ImageSubresourceLayoutMapImpl<Multiplane3AspectTraits, kThreshold>(image_state);
+            map = new MapImpl<Multiplane3AspectTraits, kThreshold>(image_state);
             break;
     }
 
     assert(map);  // We shouldn't be able to get here null unless the traits cases are incomplete
-    return std::unique_ptr<ImageSubresourceLayoutMap>(map);
+    return std::unique_ptr<Map>(map);
 }
 
-static std::unique_ptr<ImageSubresourceLayoutMap> LayoutMapFactory(const IMAGE_STATE &image_state) {
-    std::unique_ptr<ImageSubresourceLayoutMap> map;
+// The command buffer and global maps of an image must pick the same threshold, as the global map merges from the former
+template <template <typename, size_t> class MapImpl, typename Map>
+static std::unique_ptr<Map> LayoutMapFactory(const IMAGE_STATE &image_state) {
+    std::unique_ptr<Map> map;
     const uint32_t kAlwaysDenseLimit = 16;  // About a cacheline on deskop architectures
     if (image_state.full_range.layerCount <= kAlwaysDenseLimit) {
         // Create a dense row map
-        map = LayoutMapFactoryByAspect<0>(image_state);
+        map = LayoutMapFactoryByAspect<MapImpl, Map, 0>(image_state);
     } else {
         // Create an initially sparse row map
-        map = LayoutMapFactoryByAspect<kAlwaysDenseLimit>(image_state);
+        map = LayoutMapFactoryByAspect<MapImpl, Map, kAlwaysDenseLimit>(image_state);
+    }
+    return map;
+}
+
+std::unique_ptr<GlobalImageLayoutMap> GlobalImageLayoutMapFactory(const IMAGE_STATE &image_state, VkImageLayout layout) {
+    auto map = LayoutMapFactory<GlobalImageLayoutMapImpl, GlobalImageLayoutMap>(image_state);
+    if (layout != kInvalidLayout) {
+        map->SetSubresourceRangeLayout(image_state.full_range, layout);
     }
     return map;
 }
@@ -337,7 +362,8 @@ ImageSubresourceLayoutMap *GetImageSubresourceLayoutMap(CMD_BUFFER_STATE *cb_sta
     auto it = cb_state->image_layout_map.find(image_state.image);
     if (it == cb_state->image_layout_map.end()) {
         // Empty slot... fill it in.
-        auto insert_pair = cb_state->image_layout_map.insert(std::make_pair(image_state.image, LayoutMapFactory(image_state)));
+        auto map = LayoutMapFactory<ImageSubresourceLayoutMapImpl, ImageSubresourceLayoutMap>(image_state);
+        auto insert_pair = cb_state->image_layout_map.insert(std::make_pair(image_state.image, std::move(map)));
         assert(insert_pair.second);
         ImageSubresourceLayoutMap *new_map = insert_pair.first->second.get();
         assert(new_map);
@@ -380,7 +406,7 @@ void CoreChecks::AddCommandBufferBindingSampler(CMD_BUFFER_STATE *cb_node, SAMPL
     auto inserted = cb_node->object_bindings.emplace(sampler_state->sampler, kVulkanObjectTypeSampler);
     if (inserted.second) {
         // Only need to complete the cross-reference if this is a new item
-        sampler_state->cb_bindings.insert(cb_node);
+        sampler_state->AddCbBinding(cb_node);
     }
 }
 
@@ -392,7 +418,7 @@ void CoreChecks::AddCommandBufferBindingImage(CMD_BUFFER_STATE *cb_node, IMAGE_S
         auto image_inserted = cb_node->object_bindings.emplace(image_state->image, kVulkanObjectTypeImage);
         if (image_inserted.second) {
             // Only need to continue if this is a new item (the rest of the work would have be done previous)
-            image_state->cb_bindings.insert(cb_node);
+            image_state->AddCbBinding(cb_node);
             // Now update CB binding in MemObj mini CB list
             for (auto mem_binding : image_state->GetBoundMemory()) {
                 DEVICE_MEMORY_STATE *pMemInfo = GetDevMemState(mem_binding);
@@ -401,7 +427,7 @@ void CoreChecks::AddCommandBufferBindingImage(CMD_BUFFER_STATE *cb_node, IMAGE_S
                     auto mem_inserted = cb_node->memObjs.insert(mem_binding);
                     if (mem_inserted.second) {
                         // Only need to complete the cross-reference if this is a new item
-                        pMemInfo->cb_bindings.insert(cb_node);
+                        pMemInfo->AddCbBinding(cb_node);
                     }
                 }
             }
@@ -415,7 +441,7 @@ void CoreChecks::AddCommandBufferBindingImageView(CMD_BUFFER_STATE *cb_node, IMA
     auto inserted = cb_node->object_bindings.emplace(view_state->image_view, kVulkanObjectTypeImageView);
     if (inserted.second) {
         // Only need to continue if this is a new item
-        view_state->cb_bindings.insert(cb_node);
+        view_state->AddCbBinding(cb_node);
         auto image_state = GetImageState(view_state->create_info.image);
         // Add bindings for image within imageView
         if (image_state) {
@@ -430,7 +456,7 @@ void CoreChecks::AddCommandBufferBindingBuffer(CMD_BUFFER_STATE *cb_node, BUFFER
     auto buffer_inserted = cb_node->object_bindings.emplace(buffer_state->buffer, kVulkanObjectTypeBuffer);
     if (buffer_inserted.second) {
         // Only need to continue if this is a new item
-        buffer_state->cb_bindings.insert(cb_node);
+        buffer_state->AddCbBinding(cb_node);
         // Now update CB binding in MemObj mini CB list
         for (auto mem_binding : buffer_state->GetBoundMemory()) {
             DEVICE_MEMORY_STATE *pMemInfo = GetDevMemState(mem_binding);
@@ -439,7 +465,7 @@ void CoreChecks::AddCommandBufferBindingBuffer(CMD_BUFFER_STATE *cb_node, BUFFER
                 auto inserted = cb_node->memObjs.insert(mem_binding);
                 if (inserted.second) {
                     // Only need to complete the cross-reference if this is a new item
-                    pMemInfo->cb_bindings.insert(cb_node);
+                    pMemInfo->AddCbBinding(cb_node);
                 }
             }
         }
@@ -452,7 +478,7 @@ void CoreChecks::AddCommandBufferBindingBufferView(CMD_BUFFER_STATE *cb_node, BU
     auto inserted = cb_node->object_bindings.emplace(view_state->buffer_view, kVulkanObjectTypeBufferView);
     if (inserted.second) {
         // Only need to complete the cross-reference if this is a new item
-        view_state->cb_bindings.insert(cb_node);
+        view_state->AddCbBinding(cb_node);
         auto buffer_state = GetBufferState(view_state->create_info.buffer);
         // Add bindings for buffer within bufferView
         if (buffer_state) {
@@ -468,7 +494,7 @@ void CoreChecks::ClearCmdBufAndMemReferences(CMD_BUFFER_STATE *cb_node) {
             for (auto mem : cb_node->memObjs) {
                 DEVICE_MEMORY_STATE *pInfo = GetDevMemState(mem);
                 if (pInfo) {
-                    pInfo->cb_bindings.erase(cb_node);
+                    pInfo->RemoveCbBinding(cb_node);
                 }
             }
             cb_node->memObjs.clear();
@@ -710,6 +736,7 @@ bool CoreChecks::ValidateStatus(CMD_BUFFER_STATE *pNode, CBStatusFlags status_ma
 
 // Retrieve pipeline node ptr for given pipeline object
 PIPELINE_STATE *CoreChecks::GetPipelineState(VkPipeline pipeline) {
+    if (auto cached = GetStateCachedInHandle<PIPELINE_STATE>(pipeline)) return cached;
     auto it = pipelineMap.find(pipeline);
     if (it == pipelineMap.end()) {
         return nullptr;
@@ -955,6 +982,7 @@ bool CoreChecks::ValidateRenderPassCompatibility(const char *type1_string, const
 
 // Return Set node ptr for specified set or else NULL
 cvdescriptorset::DescriptorSet *CoreChecks::GetSetNode(VkDescriptorSet set) {
+    if (auto cached = GetStateCachedInHandle<cvdescriptorset::DescriptorSet>(set)) return cached;
     auto set_it = setMap.find(set);
     if (set_it == setMap.end()) {
         return NULL;
@@ -1206,11 +1234,22 @@ static bool VerifySetLayoutCompatibility(const cvdescriptorset::DescriptorSet *d
     return descriptor_set->IsCompatible(layout_node.get(), &errorMsg);
 }
 
+// The draw state a draw or dispatch last validated on this thread with no message logged, if it wasn't remembered already.
+// Validation may run under a shared lock, so rather than writing to the command buffer it leaves the state here, and the
+// record phase of the same call, which holds the command buffer's write lock, remembers it in the command buffer.
+struct ValidatedDrawState {
+    const CMD_BUFFER_STATE *cb_state;
+    VkPipelineBindPoint bind_point;
+    DRAW_STATE_KEY draw_state;
+};
+static thread_local ValidatedDrawState validated_draw_state_on_thread = {};
+
 // Validate overall state at the time of a draw call
 bool CoreChecks::ValidateCmdBufDrawState(CMD_BUFFER_STATE *cb_node, CMD_TYPE cmd_type, const bool indexed,
                                          const VkPipelineBindPoint bind_point, const char *function, const char *pipe_err_code,
                                          const char *state_err_code) {
     bool result = false;
+    validated_draw_state_on_thread.cb_state = nullptr;
     auto const &state = cb_node->lastBound[bind_point];
     PIPELINE_STATE *pPipe = state.pipeline_state;
     if (nullptr == pPipe) {
@@ -1220,6 +1259,28 @@ bool CoreChecks::ValidateCmdBufDrawState(CMD_BUFFER_STATE *cb_node, CMD_TYPE cmd
                        bind_point == VK_PIPELINE_BIND_POINT_GRAPHICS ? "Graphics" : "Compute");
     }
 
+    // Consecutive draws mostly share all of the state validated below, so the first one to pass is remembered and its repeats
+    // skip straight past the checks
+    DRAW_STATE_KEY draw_state = {};
+    draw_state.bound_state_generation = cb_node->bound_state_generation;
+    draw_state.invalidation_count = invalidation_count.load();
+    draw_state.image_layout_change_count = cb_node->image_layout_change_count;
+    for (const auto &set_binding_pair : pPipe->active_slots) {
+        if ((set_binding_pair.first < state.boundDescriptorSets.size()) && state.boundDescriptorSets[set_binding_pair.first]) {
+            draw_state.descriptor_change_count += state.boundDescriptorSets[set_binding_pair.first]->GetChangeCount();
+        }
+    }
+    draw_state.render_pass = cb_node->activeRenderPass;
+    draw_state.framebuffer = cb_node->activeFramebuffer;
+    draw_state.subpass = cb_node->activeSubpass;
+    draw_state.status = cb_node->status;
+    draw_state.viewport_mask = cb_node->viewportMask;
+    draw_state.scissor_mask = cb_node->scissorMask;
+    draw_state.cmd_type = cmd_type;
+    draw_state.indexed = indexed;
+    if (state.has_validated_draw_state && (state.validated_draw_state == draw_state)) return false;
+    const uint64_t message_count = ThreadLogMessageCount();
+
     // First check flag states
     if (VK_PIPELINE_BIND_POINT_GRAPHICS == bind_point) result = ValidateDrawStateFlags(cb_node, pPipe, indexed, state_err_code);
 
@@ -1275,9 +1336,28 @@ bool CoreChecks::ValidateCmdBufDrawState(CMD_BUFFER_STATE *cb_node, CMD_TYPE cmd
     if (VK_PIPELINE_BIND_POINT_GRAPHICS == bind_point)
         result |= ValidatePipelineDrawtimeState(state, cb_node, cmd_type, pPipe, function);
 
+    // Warnings and messages that don't ask for a skip have to be repeated for each draw too, so only state whose checks
+    // logged nothing at all is remembered
+    if (ThreadLogMessageCount() == message_count) {
+        validated_draw_state_on_thread.cb_state = cb_node;
+        validated_draw_state_on_thread.bind_point = bind_point;
+        validated_draw_state_on_thread.draw_state = draw_state;
+    }
+
     return result;
 }
 
+// Remember the draw state this thread's validation of the current draw or dispatch left, s.t. repeats of it needn't be
+// validated again
+void CoreChecks::RecordValidatedDrawState(CMD_BUFFER_STATE *cb_state, const VkPipelineBindPoint bind_point) {
+    ValidatedDrawState &validated = validated_draw_state_on_thread;
+    if ((validated.cb_state != cb_state) || (validated.bind_point != bind_point)) return;
+    auto &state = cb_state->lastBound[bind_point];
+    state.validated_draw_state = validated.draw_state;
+    state.has_validated_draw_state = true;
+    validated.cb_state = nullptr;
+}
+
 void CoreChecks::UpdateDrawState(CMD_BUFFER_STATE *cb_state, const VkPipelineBindPoint bind_point) {
     auto const &state = cb_state->lastBound[bind_point];
     PIPELINE_STATE *pPipe = state.pipeline_state;
@@ -1889,7 +1969,10 @@ bool CoreChecks::ValidateIdleDescriptorSet(VkDescriptorSet set, const char *func
 }
 
 // Remove set from setMap and delete the set
-void CoreChecks::FreeDescriptorSet(cvdescriptorset::DescriptorSet *descriptor_set) { setMap.erase(descriptor_set->GetSet()); }
+void CoreChecks::FreeDescriptorSet(cvdescriptorset::DescriptorSet *descriptor_set) {
+    ClearStateCachedInHandle(descriptor_set->GetSet());
+    setMap.erase(descriptor_set->GetSet());
+}
 
 // Free all DS Pools including their Sets & related sub-structs
 // NOTE : Calls to this function should be wrapped in mutex
@@ -1913,6 +1996,35 @@ CMD_BUFFER_STATE *CoreChecks::GetCBState(const VkCommandBuffer cb) {
     return it->second.get();
 }
 
+// GPU-assisted validation shares its descriptor and buffer pools between command buffers, so it keeps the object-wide lock
+bool CoreChecks::ConcurrentCommandBufferRecording() const { return enabled.concurrent_validation && !enabled.gpu_validation; }
+
+// Take the object-wide lock shared, then the lock carried by the command buffer state. Both the validate and the record phase
+// of the vkCmd* entry points run under this lock, so their record hooks may only write:
+//  - the command buffer's own state: its CMD_BUFFER_STATE fields, image layout maps, QFO barrier sets, event and query
+//    update lambdas, lastBound and push descriptor sets,
+//  - the cb_bindings of the objects it uses, through BASE_NODE::AddCbBinding(), which takes the object's bindings lock,
+//  - debug utils labels, which are guarded by debug_report_mutex,
+//  - descriptor set validation caches, which have their own lock.
+// Records that change the object maps or the state of other command buffers (vkBeginCommandBuffer, vkResetCommandBuffer,
+// vkCmdExecuteCommands) keep the exclusive lock, and GPU-assisted validation turns this path off altogether.
+cb_lock_guard_t CoreChecks::CommandBufferLock(VkCommandBuffer command_buffer) {
+    auto object_lock = read_lock_guard_t(validation_object_mutex, LockMode::kShared);
+    CMD_BUFFER_STATE *cb_state = GetCBState(command_buffer);
+    if (!cb_state) return cb_lock_guard_t(std::move(object_lock));
+    return cb_lock_guard_t(std::move(object_lock), cb_state->command_buffer_lock);
+}
+
+cb_lock_guard_t CoreChecks::cb_read_lock(VkCommandBuffer command_buffer) {
+    if (ConcurrentCommandBufferRecording()) return CommandBufferLock(command_buffer);
+    return cb_lock_guard_t(read_lock());
+}
+
+cb_lock_guard_t CoreChecks::cb_write_lock(VkCommandBuffer command_buffer) {
+    if (ConcurrentCommandBufferRecording()) return CommandBufferLock(command_buffer);
+    return cb_lock_guard_t(write_lock());
+}
+
 // If a renderpass is active, verify that the given command type is appropriate for current subpass state
 bool CoreChecks::ValidateCmdSubpassState(const CMD_BUFFER_STATE *pCB, const CMD_TYPE cmd_type) {
     if (!pCB->activeRenderPass) return false;
@@ -2116,15 +2228,14 @@ BASE_NODE *CoreChecks::GetStateStructPtrFromObject(const VulkanTypedHandle &obje
 // Tie the VulkanTypedHandle to the cmd buffer which includes:
 //  Add object_binding to cmd buffer
 //  Add cb_binding to object
-static void AddCommandBufferBinding(std::unordered_set<CMD_BUFFER_STATE *> *cb_bindings, const VulkanTypedHandle &obj,
-                                    CMD_BUFFER_STATE *cb_node) {
-    cb_bindings->insert(cb_node);
+static void AddCommandBufferBinding(BASE_NODE *base_node, const VulkanTypedHandle &obj, CMD_BUFFER_STATE *cb_node) {
+    base_node->AddCbBinding(cb_node);
     cb_node->object_bindings.insert(obj);
 }
 // For a given object, if cb_node is in that objects cb_bindings, remove cb_node
 void CoreChecks::RemoveCommandBufferBinding(VulkanTypedHandle const &object, CMD_BUFFER_STATE *cb_node) {
     BASE_NODE *base_obj = GetStateStructPtrFromObject(object);
-    if (base_obj) base_obj->cb_bindings.erase(cb_node);
+    if (base_obj) base_obj->RemoveCbBinding(cb_node);
 }
 // Reset the command buffer state
 //  Maintain the createInfo and set state to CB_NEW, but clear all other state
@@ -2142,6 +2253,7 @@ void CoreChecks::ResetCommandBufferState(const VkCommandBuffer cb) {
         pCB->image_layout_change_count = 1;  // Start at 1. 0 is insert value for validation cache versions, s.t. new == dirty
         pCB->status = 0;
         pCB->static_status = 0;
+        pCB->bound_state_generation = 0;
         pCB->viewportMask = 0;
         pCB->scissorMask = 0;
 
@@ -2162,9 +2274,11 @@ void CoreChecks::ResetCommandBufferState(const VkCommandBuffer cb) {
         pCB->activeQueries.clear();
         pCB->startedQueries.clear();
         pCB->image_layout_map.clear();
+        pCB->image_layout_summaries.clear();
         pCB->eventToStageMap.clear();
-        pCB->draw_data.clear();
         pCB->current_draw_data.vertex_buffer_bindings.clear();
+        pCB->draw_vertex_buffers.clear();
+        pCB->current_draw_data_recorded = true;
         pCB->vertex_buffer_used = false;
         pCB->primaryCommandBuffer = VK_NULL_HANDLE;
         // If secondary, invalidate any primary command buffer that may call us.
@@ -2193,7 +2307,7 @@ void CoreChecks::ResetCommandBufferState(const VkCommandBuffer cb) {
         // Remove this cmdBuffer's reference from each FrameBuffer's CB ref list
         for (auto framebuffer : pCB->framebuffers) {
             auto fb_state = GetFramebufferState(framebuffer);
-            if (fb_state) fb_state->cb_bindings.erase(pCB);
+            if (fb_state) fb_state->RemoveCbBinding(pCB);
         }
         pCB->framebuffers.clear();
         pCB->activeFramebuffer = VK_NULL_HANDLE;
@@ -2552,6 +2666,14 @@ void CoreChecks::PostCallRecordCreateDevice(VkPhysicalDevice gpu, const VkDevice
     if (enabled.gpu_validation) {
         core_checks->GpuPostCallRecordCreateDevice(&enabled);
     }
+    if (enabled.background_retirement) {
+        core_checks->StartBackgroundRetirement();
+    }
+    if (enabled.parallel_descriptor_validation) {
+        // The recording thread works through the tasks as well
+        const uint32_t thread_count = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+        core_checks->descriptor_worker_pool.reset(new WorkerPool(thread_count));
+    }
     if (core_checks->device_extensions.vk_nv_cooperative_matrix) {
         // Get the needed cooperative_matrix properties
         auto cooperative_matrix_props = lvl_init_struct<VkPhysicalDeviceCooperativeMatrixPropertiesNV>();
@@ -2579,6 +2701,7 @@ void CoreChecks::PostCallRecordCreateDevice(VkPhysicalDevice gpu, const VkDevice
 
 void CoreChecks::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator) {
     if (!device) return;
+    StopBackgroundRetirement();
     if (enabled.gpu_validation) {
         GpuPreCallRecordDestroyDevice();
     }
@@ -2592,8 +2715,6 @@ void CoreChecks::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationC
     descriptorSetLayoutMap.clear();
     imageViewMap.clear();
     imageMap.clear();
-    imageSubresourceMap.clear();
-    imageLayoutMap.clear();
     bufferViewMap.clear();
     bufferMap.clear();
     // Queues persist until device is destroyed
@@ -2636,32 +2757,39 @@ bool CoreChecks::ValidateStageMaskGsTsEnables(VkPipelineStageFlags stageMask, co
     return skip;
 }
 
-// Loop through bound objects and increment their in_use counts.
-void CoreChecks::IncrementBoundObjects(CMD_BUFFER_STATE const *cb_node) {
-    for (auto obj : cb_node->object_bindings) {
+// Collect the objects still alive that a submission of cb_node holds in use, each once: the "generic" objects bound to the
+// cmd buffer, followed by the vertex buffers of its draws
+void CoreChecks::ResolveInUseRefs(CMD_BUFFER_STATE *cb_node) {
+    auto &in_use_refs = cb_node->in_use_refs;
+    in_use_refs.clear();
+    for (const auto &obj : cb_node->object_bindings) {
         auto base_obj = GetStateStructPtrFromObject(obj);
         if (base_obj) {
-            base_obj->in_use.fetch_add(1);
+            in_use_refs.push_back(base_obj);
+        }
+    }
+    // TODO : We should be able to remove the NULL look-up checks from the code below as long as
+    //  all the corresponding cases are verified to cause CB_INVALID state and the CB_INVALID state
+    //  should then be flagged prior to calling this function
+    for (auto vertex_buffer : cb_node->draw_vertex_buffers) {
+        auto buffer_state = GetBufferState(vertex_buffer);
+        if (buffer_state) {
+            in_use_refs.push_back(buffer_state);
         }
     }
+    std::sort(in_use_refs.begin(), in_use_refs.end());
+    in_use_refs.erase(std::unique(in_use_refs.begin(), in_use_refs.end()), in_use_refs.end());
+    cb_node->in_use_refs_stale = false;
 }
+
 // Track which resources are in-flight by atomically incrementing their "in_use" count
 void CoreChecks::IncrementResources(CMD_BUFFER_STATE *cb_node) {
     cb_node->submitCount++;
     cb_node->in_use.fetch_add(1);
 
-    // First Increment for all "generic" objects bound to cmd buffer, followed by special-case objects below
-    IncrementBoundObjects(cb_node);
-    // TODO : We should be able to remove the NULL look-up checks from the code below as long as
-    //  all the corresponding cases are verified to cause CB_INVALID state and the CB_INVALID state
-    //  should then be flagged prior to calling this function
-    for (auto draw_data_element : cb_node->draw_data) {
-        for (auto &vertex_buffer : draw_data_element.vertex_buffer_bindings) {
-            auto buffer_state = GetBufferState(vertex_buffer.buffer);
-            if (buffer_state) {
-                buffer_state->in_use.fetch_add(1);
-            }
-        }
+    ResolveInUseRefs(cb_node);
+    for (auto base_obj : cb_node->in_use_refs) {
+        base_obj->in_use.fetch_add(1);
     }
     for (auto event : cb_node->writeEventsBeforeWait) {
         auto event_state = GetEventState(event);
@@ -2725,17 +2853,6 @@ bool CoreChecks::VerifyQueueStateToFence(VkFence fence) {
     return false;
 }
 
-// Decrement in-use count for objects bound to command buffer
-void CoreChecks::DecrementBoundResources(CMD_BUFFER_STATE const *cb_node) {
-    BASE_NODE *base_obj = nullptr;
-    for (auto obj : cb_node->object_bindings) {
-        base_obj = GetStateStructPtrFromObject(obj);
-        if (base_obj) {
-            base_obj->in_use.fetch_sub(1);
-        }
-    }
-}
-
 void CoreChecks::RetireWorkOnQueue(QUEUE_STATE *pQueue, uint64_t seq) {
     std::unordered_map<VkQueue, uint64_t> otherQueueSeqs;
 
@@ -2771,15 +2888,12 @@ void CoreChecks::RetireWorkOnQueue(QUEUE_STATE *pQueue, uint64_t seq) {
             if (!cb_node) {
                 continue;
             }
-            // First perform decrement on general case bound objects
-            DecrementBoundResources(cb_node);
-            for (auto draw_data_element : cb_node->draw_data) {
-                for (auto &vertex_buffer_binding : draw_data_element.vertex_buffer_bindings) {
-                    auto buffer_state = GetBufferState(vertex_buffer_binding.buffer);
-                    if (buffer_state) {
-                        buffer_state->in_use.fetch_sub(1);
-                    }
-                }
+            // Drop any objects destroyed in flight before releasing the rest
+            if (cb_node->in_use_refs_stale) {
+                ResolveInUseRefs(cb_node);
+            }
+            for (auto base_obj : cb_node->in_use_refs) {
+                base_obj->in_use.fetch_sub(1);
             }
             for (auto event : cb_node->writeEventsBeforeWait) {
                 auto eventNode = eventMap.find(event);
@@ -2880,15 +2994,11 @@ bool CoreChecks::ValidateResources(CMD_BUFFER_STATE *cb_node) {
     // TODO : We should be able to remove the NULL look-up checks from the code below as long as
     //  all the corresponding cases are verified to cause CB_INVALID state and the CB_INVALID state
     //  should then be flagged prior to calling this function
-    for (const auto &draw_data_element : cb_node->draw_data) {
-        for (const auto &vertex_buffer_binding : draw_data_element.vertex_buffer_bindings) {
-            auto buffer_state = GetBufferState(vertex_buffer_binding.buffer);
-            if ((vertex_buffer_binding.buffer != VK_NULL_HANDLE) && (!buffer_state)) {
-                skip |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT,
-                                HandleToUint64(vertex_buffer_binding.buffer), kVUID_Core_DrawState_InvalidBuffer,
-                                "Cannot submit cmd buffer using deleted buffer %s.",
-                                report_data->FormatHandle(vertex_buffer_binding.buffer).c_str());
-            }
+    for (auto vertex_buffer : cb_node->draw_vertex_buffers) {
+        if (!GetBufferState(vertex_buffer)) {
+            skip |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT,
+                            HandleToUint64(vertex_buffer), kVUID_Core_DrawState_InvalidBuffer,
+                            "Cannot submit cmd buffer using deleted buffer %s.", report_data->FormatHandle(vertex_buffer).c_str());
         }
     }
     return skip;
@@ -3026,6 +3136,9 @@ void CoreChecks::PostCallRecordQueueSubmit(VkQueue queue, uint32_t submitCount,
         if (pFence->scope == kSyncScopeInternal) {
             // Mark fence in use
             SubmitFence(pQueue, pFence, std::max(1u, submitCount));
+            if (enabled.background_retirement) {
+                QueueBackgroundRetirement(queue, fence, pFence->signaler.second);
+            }
             if (!submitCount) {
                 // If no submissions, but just dropping a fence on the end of the queue,
                 // record an empty submission with just the fence, so we can determine
@@ -3137,7 +3250,7 @@ bool CoreChecks::PreCallValidateQueueSubmit(VkQueue queue, uint32_t submitCount,
     unordered_set<VkSemaphore> unsignaled_semaphores;
     unordered_set<VkSemaphore> internal_semaphores;
     vector<VkCommandBuffer> current_cmds;
-    unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE> localImageLayoutMap;
+    GlobalImageLayoutMap::OverlayMap localImageLayoutMap;
     // Now verify each individual submit
     for (uint32_t submit_idx = 0; submit_idx < submitCount; submit_idx++) {
         const VkSubmitInfo *submit = &pSubmits[submit_idx];
@@ -3187,7 +3300,7 @@ bool CoreChecks::PreCallValidateQueueSubmit(VkQueue queue, uint32_t submitCount,
         for (uint32_t i = 0; i < submit->commandBufferCount; i++) {
             auto cb_node = GetCBState(submit->pCommandBuffers[i]);
             if (cb_node) {
-                skip |= ValidateCmdBufImageLayouts(cb_node, imageLayoutMap, localImageLayoutMap);
+                skip |= ValidateCmdBufImageLayouts(cb_node, localImageLayoutMap);
                 current_cmds.push_back(submit->pCommandBuffers[i]);
                 skip |= ValidatePrimaryCommandBufferState(
                     cb_node, (int)std::count(current_cmds.begin(), current_cmds.end(), submit->pCommandBuffers[i]),
@@ -3804,6 +3917,7 @@ void CoreChecks::PreCallRecordFreeMemory(VkDevice device, VkDeviceMemory mem, co
     }
     // Any bound cmd buffers are now invalid
     InvalidateCommandBuffers(mem_info->cb_bindings, obj_struct);
+    ++descriptor_resource_epoch;
     memObjMap.erase(mem);
 }
 
@@ -3863,6 +3977,152 @@ void CoreChecks::StoreMemRanges(VkDeviceMemory mem, VkDeviceSize offset, VkDevic
 // Guard value for pad data
 static char NoncoherentMemoryFillValue = 0xb;
 
+// Whether the size bytes at data all still hold the guard value, compared 16 at a time where SSE2 is available
+static bool NoncoherentGuardIntact(const char *data, uint64_t size) {
+    uint64_t i = 0;
+#if defined(CORE_VALIDATION_USE_SSE2)
+    const __m128i fill = _mm_set1_epi8(NoncoherentMemoryFillValue);
+    for (; (i + 16) <= size; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, fill)) != 0xFFFF) return false;
+    }
+#endif
+    for (; i < size; ++i) {
+        if (data[i] != NoncoherentMemoryFillValue) return false;
+    }
+    return true;
+}
+
+// Size of the currently mapped region of mem_info
+static VkDeviceSize MappedSize(const DEVICE_MEMORY_STATE *mem_info) {
+    return (mem_info->mem_range.size != VK_WHOLE_SIZE) ? mem_info->mem_range.size
+                                                       : (mem_info->alloc_info.allocationSize - mem_info->mem_range.offset);
+}
+
+// The part of the mapped region a flush or invalidate range covers, as an offset from the start of the mapping and a size.
+// Ranges reaching outside of the mapping are reported by ValidateMemoryIsMapped, and only their mapped part is returned.
+static MemRange MappedExtent(const DEVICE_MEMORY_STATE *mem_info, const VkMappedMemoryRange &range) {
+    const VkDeviceSize mapped_size = MappedSize(mem_info);
+    const VkDeviceSize map_offset = mem_info->mem_range.offset;
+    const VkDeviceSize begin = std::min(std::max(range.offset, map_offset) - map_offset, mapped_size);
+    VkDeviceSize end = mapped_size;
+    if (range.size != VK_WHOLE_SIZE) {
+        const VkDeviceSize range_end = range.offset + range.size;
+        end = (range_end > map_offset) ? std::min(range_end - map_offset, mapped_size) : 0;
+    }
+    MemRange extent = {begin, (end > begin) ? (end - begin) : 0};
+    return extent;
+}
+
+#if defined(__linux__)
+// Place the shadow copy between PROT_NONE guard pages, ending as close to the trailing guard page as the map alignment allows,
+// s.t. most overruns fault at the offending store rather than being found at the next flush.  Only the guard-band slack is
+// filled, and anonymous pages are committed when first touched, so the shadow only costs memory for the parts of the mapping
+// that the app writes or invalidates.  Returns false to fall back to a malloc'd shadow.
+static bool AllocateGuardPageShadow(DEVICE_MEMORY_STATE *mem_info, uint64_t map_alignment, uint64_t start_offset,
+                                    VkDeviceSize size) {
+    const long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) return false;
+    const uint64_t page_mask = static_cast<uint64_t>(page_size) - 1;
+    const uint64_t data_size = (size + map_alignment + start_offset + page_mask) & ~page_mask;
+    if (data_size > (SIZE_MAX - 2 * static_cast<uint64_t>(page_size))) return false;
+    const size_t map_size = static_cast<size_t>(data_size + 2 * page_size);
+    void *base = mmap(nullptr, map_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return false;
+    char *data_begin = static_cast<char *>(base) + page_size;
+    if (mprotect(data_begin, static_cast<size_t>(data_size), PROT_READ | PROT_WRITE) != 0) {
+        munmap(base, map_size);
+        return false;
+    }
+
+    // (ppData - offset) must be aligned to at least minMemoryMapAlignment
+    const uintptr_t data_end = reinterpret_cast<uintptr_t>(data_begin) + static_cast<uintptr_t>(data_size);
+    const uintptr_t app_data = ((data_end - size - start_offset) & ~(map_alignment - 1)) + start_offset;
+    const uint64_t pad_size = data_end - (app_data + size);
+    mem_info->shadow_copy_base = base;
+    mem_info->shadow_map_size = map_size;
+    mem_info->shadow_pad_size = pad_size;
+    mem_info->shadow_copy = reinterpret_cast<char *>(app_data) - pad_size;
+    char *shadow = static_cast<char *>(mem_info->shadow_copy);
+    memset(shadow, NoncoherentMemoryFillValue, static_cast<size_t>(pad_size));
+    memset(shadow + pad_size + size, NoncoherentMemoryFillValue, static_cast<size_t>(pad_size));
+    return true;
+}
+
+// The pagemap of this process, opened on first use and kept open for the life of the layer, or -1 if it can't be read
+static int ShadowPagemap() {
+    static const int pagemap = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    return pagemap;
+}
+
+// Whether the app may have written a page of a guard page shadow, given its /proc/self/pagemap entry.  A page that is only
+// read maps the shared zero page, which is neither exclusively mapped nor anything but zeros.  A page of zeros shared with a
+// forked child can't be told apart from it, and is taken as unwritten too.
+static bool ShadowPageMayBeWritten(uint64_t pagemap_entry, const char *page, size_t page_size) {
+    const uint64_t kPresent = 1ULL << 63;
+    const uint64_t kSwapped = 1ULL << 62;
+    const uint64_t kExclusive = 1ULL << 56;
+    if (pagemap_entry & kSwapped) return true;
+    if (!(pagemap_entry & kPresent)) return false;
+    if (pagemap_entry & kExclusive) return true;
+    for (size_t i = 0; i < page_size; ++i) {
+        if (page[i]) return true;
+    }
+    return false;
+}
+
+// Copy the pages of [src, src + size) that the app may have written since the guard page shadow was mapped to dst.  Pages the
+// app never touched or only read are skipped: the driver's copy of them is already the current one, while the shadow only
+// holds zeros for them.  Everything is copied if the pagemap can't be read.
+//
+// This is not dirty tracking: a page counts as written from its first write until the memory is unmapped, so flushing the
+// same range again copies the same pages again.  The soft-dirty bit could tell writes since the last flush apart, but it can
+// only be cleared for the whole process at once, which would lose writes other threads make meanwhile to other shadows.
+static void CopyTouchedShadowPages(char *dst, const char *src, size_t size) {
+    const int pagemap = ShadowPagemap();
+    if (pagemap < 0) {
+        memcpy(dst, src, size);
+        return;
+    }
+    const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(src);
+    const uintptr_t end = begin + size;
+    uintptr_t copy_begin = begin;  // Start of the run of written pages not yet copied
+    uint64_t entries[512];
+    for (uintptr_t page = begin / page_size; (page * page_size) < end;) {
+        const size_t count = static_cast<size_t>(std::min<uintptr_t>(512, (end - 1) / page_size + 1 - page));
+        const ssize_t bytes = pread(pagemap, entries, count * sizeof(uint64_t), static_cast<off_t>(page * sizeof(uint64_t)));
+        const size_t read_count = (bytes > 0) ? static_cast<size_t>(bytes) / sizeof(uint64_t) : 0;
+        for (size_t i = 0; i < count; ++i, ++page) {
+            if ((i < read_count) &&
+                !ShadowPageMayBeWritten(entries[i], reinterpret_cast<const char *>(page * page_size), page_size)) {
+                const uintptr_t page_begin = std::max(page * page_size, begin);
+                if (page_begin > copy_begin) {
+                    memcpy(dst + (copy_begin - begin), src + (copy_begin - begin), page_begin - copy_begin);
+                }
+                copy_begin = std::min((page + 1) * page_size, end);
+            }
+        }
+    }
+    if (end > copy_begin) memcpy(dst + (copy_begin - begin), src + (copy_begin - begin), end - copy_begin);
+}
+#endif  // __linux__
+
+// Release the shadow copy, if any, of a mapped non-coherent memory object
+static void FreeShadowCopy(DEVICE_MEMORY_STATE *mem_info) {
+#if defined(__linux__)
+    if (mem_info->shadow_map_size) {
+        munmap(mem_info->shadow_copy_base, mem_info->shadow_map_size);
+        mem_info->shadow_map_size = 0;
+    } else
+#endif
+    {
+        free(mem_info->shadow_copy_base);
+    }
+    mem_info->shadow_copy_base = 0;
+    mem_info->shadow_copy = 0;
+}
+
 void CoreChecks::InitializeAndTrackMemory(VkDeviceMemory mem, VkDeviceSize offset, VkDeviceSize size, void **ppData) {
     auto mem_info = GetDevMemState(mem);
     if (mem_info) {
@@ -3881,6 +4141,12 @@ void CoreChecks::InitializeAndTrackMemory(VkDeviceMemory mem, VkDeviceSize offse
 
             // From spec: (ppData - offset) must be aligned to at least limits::minMemoryMapAlignment.
             uint64_t start_offset = offset % map_alignment;
+#if defined(__linux__)
+            if (enabled.shadow_guard_pages && AllocateGuardPageShadow(mem_info, map_alignment, start_offset, size)) {
+                *ppData = static_cast<char *>(mem_info->shadow_copy) + mem_info->shadow_pad_size;
+                return;
+            }
+#endif
             // Data passed to driver will be wrapped by a guardband of data to detect over- or under-writes.
             mem_info->shadow_copy_base =
                 malloc(static_cast<size_t>(2 * mem_info->shadow_pad_size + size + map_alignment + start_offset));
@@ -3930,6 +4196,103 @@ void CoreChecks::RetireFence(VkFence fence) {
     }
 }
 
+CoreChecks::~CoreChecks() {
+    if (retire_thread.joinable()) {
+        StopBackgroundRetirement();
+        retire_thread.join();
+    }
+}
+
+void CoreChecks::StartBackgroundRetirement() { retire_thread = std::thread(&CoreChecks::BackgroundRetirementLoop, this); }
+
+// Keep the worker from touching the device again. It may still be blocked on the object lock, in which case it finds
+// retire_thread_exit set once it gets the lock. It is joined when the object is deleted.
+void CoreChecks::StopBackgroundRetirement() {
+    std::unique_lock<std::mutex> lock(retire_mutex);
+    retire_thread_exit = true;
+    pending_retirements.clear();
+    retire_cv.notify_all();
+    retire_cv.wait(lock, [this] { return polled_fences.empty(); });
+}
+
+void CoreChecks::QueueBackgroundRetirement(VkQueue queue, VkFence fence, uint64_t seq) {
+    std::lock_guard<std::mutex> lock(retire_mutex);
+    if (retire_thread_exit) return;
+    pending_retirements.push_back({fence, queue, seq});
+    retire_cv.notify_all();
+}
+
+// Stop waiting on fence, which is about to be reset or destroyed. The app has either waited on it already, or the fence
+// is still in flight, which is invalid and flagged at validation.
+void CoreChecks::DropBackgroundRetirement(VkFence fence) {
+    if (!enabled.background_retirement) return;
+    std::unique_lock<std::mutex> lock(retire_mutex);
+    pending_retirements.erase(std::remove_if(pending_retirements.begin(), pending_retirements.end(),
+                                             [fence](const PendingRetirement &pending) { return pending.fence == fence; }),
+                              pending_retirements.end());
+    retire_cv.wait(lock, [this, fence] {
+        return std::find(polled_fences.begin(), polled_fences.end(), fence) == polled_fences.end();
+    });
+}
+
+// Wait for any of the pending fences without holding a lock, then retire the queues they signal under the object lock, s.t.
+// the wait entry points usually find the work they would retire already done.
+void CoreChecks::BackgroundRetirementLoop() {
+    // Bounds how long a fence submitted during a wait goes unpolled
+    const uint64_t kPollTimeoutNs = 1000000;
+    std::vector<PendingRetirement> polled;
+    std::vector<PendingRetirement> signaled;
+    std::unique_lock<std::mutex> lock(retire_mutex);
+    while (true) {
+        retire_cv.wait(lock, [this] { return retire_thread_exit || !pending_retirements.empty(); });
+        if (retire_thread_exit) break;
+        polled = pending_retirements;
+        polled_fences.clear();
+        for (const auto &pending : polled) polled_fences.push_back(pending.fence);
+        lock.unlock();
+
+        signaled.clear();
+        VkResult result = DispatchWaitForFences(device, static_cast<uint32_t>(polled_fences.size()), polled_fences.data(),
+                                                VK_FALSE, kPollTimeoutNs);
+        if (result == VK_SUCCESS) {
+            for (const auto &pending : polled) {
+                if (DispatchGetFenceStatus(device, pending.fence) == VK_SUCCESS) signaled.push_back(pending);
+            }
+        }
+
+        lock.lock();
+        polled_fences.clear();
+        retire_cv.notify_all();
+        if ((result != VK_SUCCESS) && (result != VK_TIMEOUT)) {
+            // Most likely VK_ERROR_DEVICE_LOST. Leave the retirement to the app's own waits.
+            pending_retirements.clear();
+            continue;
+        }
+        if (signaled.empty()) continue;
+        for (const auto &done : signaled) {
+            auto it = std::find_if(
+                pending_retirements.begin(), pending_retirements.end(),
+                [&done](const PendingRetirement &pending) { return (pending.fence == done.fence) && (pending.seq == done.seq); });
+            if (it != pending_retirements.end()) pending_retirements.erase(it);
+        }
+        lock.unlock();
+
+        {
+            auto object_lock = write_lock();
+            std::unique_lock<std::mutex> exit_lock(retire_mutex);
+            const bool exiting = retire_thread_exit;
+            exit_lock.unlock();
+            if (!exiting) {
+                for (const auto &done : signaled) {
+                    auto queue_state = GetQueueState(done.queue);
+                    if (queue_state) RetireWorkOnQueue(queue_state, done.seq);
+                }
+            }
+        }
+        lock.lock();
+    }
+}
+
 bool CoreChecks::PreCallValidateWaitForFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences, VkBool32 waitAll,
                                               uint64_t timeout) {
     // Verify fence status of submitted fences
@@ -4047,6 +4410,7 @@ bool CoreChecks::PreCallValidateDestroyFence(VkDevice device, VkFence fence, con
 
 void CoreChecks::PreCallRecordDestroyFence(VkDevice device, VkFence fence, const VkAllocationCallbacks *pAllocator) {
     if (!fence) return;
+    DropBackgroundRetirement(fence);
     fenceMap.erase(fence);
 }
 
@@ -4126,7 +4490,7 @@ void CoreChecks::PostCallRecordGetQueryPoolResults(VkDevice device, VkQueryPool
     if ((VK_SUCCESS != result) && (VK_NOT_READY != result)) return;
     // TODO: clean this up, it's insanely wasteful.
     unordered_map<QueryObject, std::vector<VkCommandBuffer>> queries_in_flight;
-    for (auto &cmd_buffer : commandBufferMap) {
+    for (const auto &cmd_buffer : commandBufferMap) {
         if (cmd_buffer.second->in_use.load()) {
             for (auto query_state_pair : cmd_buffer.second->queryToStateMap) {
                 queries_in_flight[query_state_pair.first].push_back(cmd_buffer.first);
@@ -4204,6 +4568,12 @@ bool CoreChecks::RangesIntersect(MEMORY_RANGE const *range1, VkDeviceSize offset
     return RangesIntersect(range1, &range_wrap, &tmp_bool, true);
 }
 
+// Mask of the offset bits that RangesIntersect may pad away when comparing linear and non-linear ranges
+VkDeviceSize CoreChecks::BoundRangePadMask() const {
+    const VkDeviceSize granularity = phys_dev_props.limits.bufferImageGranularity;
+    return granularity ? (granularity - 1) : 0;
+}
+
 bool CoreChecks::ValidateInsertMemoryRange(uint64_t handle, DEVICE_MEMORY_STATE *mem_info, VkDeviceSize memoryOffset,
                                            VkMemoryRequirements memRequirements, bool is_image, bool is_linear,
                                            const char *api_name) {
@@ -4217,17 +4587,18 @@ bool CoreChecks::ValidateInsertMemoryRange(uint64_t handle, DEVICE_MEMORY_STATE
     range.start = memoryOffset;
     range.size = memRequirements.size;
     range.end = memoryOffset + memRequirements.size - 1;
-    range.aliases.clear();
 
-    // Check for aliasing problems.
-    for (auto &obj_range_pair : mem_info->bound_ranges) {
-        auto check_range = &obj_range_pair.second;
-        bool intersection_error = false;
-        if (RangesIntersect(&range, check_range, &intersection_error, false)) {
-            skip |= intersection_error;
-            range.aliases.insert(check_range);
-        }
-    }
+    // Check for aliasing problems.  Padding is at most bufferImageGranularity, so only the bound ranges overlapping this one
+    // widened to that granularity can intersect it.
+    const VkDeviceSize pad_mask = BoundRangePadMask();
+    mem_info->bound_range_tree.ForEachOverlap(range.start & ~pad_mask, range.end | pad_mask,
+                                              [&](VkDeviceSize, VkDeviceSize, MEMORY_RANGE *check_range) {
+                                                  bool intersection_error = false;
+                                                  if (RangesIntersect(&range, check_range, &intersection_error, false)) {
+                                                      skip |= intersection_error;
+                                                  }
+                                                  return true;
+                                              });
 
     if (memoryOffset >= mem_info->alloc_info.allocationSize) {
         const char *error_code =
@@ -4244,11 +4615,28 @@ bool CoreChecks::ValidateInsertMemoryRange(uint64_t handle, DEVICE_MEMORY_STATE
     return skip;
 }
 
+// Remove MEMORY_RANGE struct for give handle from bound_ranges of mem_info
+//  is_image indicates if handle is for image or buffer
+//  This function will also remove the handle-to-index mapping from the appropriate
+//  map and the bound_range_tree.
+static void RemoveMemoryRange(uint64_t handle, DEVICE_MEMORY_STATE *mem_info, bool is_image) {
+    auto range_it = mem_info->bound_ranges.find(handle);
+    if (range_it != mem_info->bound_ranges.end()) {
+        auto erase_range = &range_it->second;
+        mem_info->bound_range_tree.Erase(erase_range->start, erase_range);
+        mem_info->bound_ranges.erase(range_it);
+    }
+    if (is_image) {
+        mem_info->bound_images.erase(handle);
+    } else {
+        mem_info->bound_buffers.erase(handle);
+    }
+}
+
 // Object with given handle is being bound to memory w/ given mem_info struct.
 //  Track the newly bound memory range with given memoryOffset
-//  Also scan any previous ranges, track aliased ranges with new range, and flag an error if a linear
-//  and non-linear range incorrectly overlap.
-// Return true if an error is flagged and the user callback returns "true", otherwise false
+//  Aliasing isn't tracked per range, the ranges aliasing any other are found on demand from the bound_range_tree, as
+//  ValidateInsertMemoryRange does to flag linear and non-linear ranges that incorrectly overlap.
 // is_image indicates an image object, otherwise handle is for a buffer
 // is_linear indicates a buffer or linear image
 void CoreChecks::InsertMemoryRange(uint64_t handle, DEVICE_MEMORY_STATE *mem_info, VkDeviceSize memoryOffset,
@@ -4262,22 +4650,13 @@ void CoreChecks::InsertMemoryRange(uint64_t handle, DEVICE_MEMORY_STATE *mem_inf
     range.start = memoryOffset;
     range.size = memRequirements.size;
     range.end = memoryOffset + memRequirements.size - 1;
-    range.aliases.clear();
-    // Update Memory aliasing
-    // Save aliased ranges so we can copy into final map entry below. Can't do it in loop b/c we don't yet have final ptr. If we
-    // inserted into map before loop to get the final ptr, then we may enter loop when not needed & we check range against itself
-    std::unordered_set<MEMORY_RANGE *> tmp_alias_ranges;
-    for (auto &obj_range_pair : mem_info->bound_ranges) {
-        auto check_range = &obj_range_pair.second;
-        bool intersection_error = false;
-        if (RangesIntersect(&range, check_range, &intersection_error, true)) {
-            range.aliases.insert(check_range);
-            tmp_alias_ranges.insert(check_range);
-        }
-    }
-    mem_info->bound_ranges[handle] = std::move(range);
-    for (auto tmp_range : tmp_alias_ranges) {
-        tmp_range->aliases.insert(&mem_info->bound_ranges[handle]);
+    // A second bind of the object (already reported by validation) replaces its range
+    RemoveMemoryRange(handle, mem_info, is_image);
+    auto *bound_range = &mem_info->bound_ranges[handle];
+    *bound_range = range;
+    // Zero sized ranges (an error reported by validation) have end < start and can't overlap anything
+    if (bound_range->start <= bound_range->end) {
+        mem_info->bound_range_tree.Insert(bound_range->start, bound_range->end, bound_range);
     }
     if (is_image)
         mem_info->bound_images.insert(handle);
@@ -4303,24 +4682,6 @@ void CoreChecks::InsertBufferMemoryRange(VkBuffer buffer, DEVICE_MEMORY_STATE *m
     InsertMemoryRange(HandleToUint64(buffer), mem_info, mem_offset, mem_reqs, false, true);
 }
 
-// Remove MEMORY_RANGE struct for give handle from bound_ranges of mem_info
-//  is_image indicates if handle is for image or buffer
-//  This function will also remove the handle-to-index mapping from the appropriate
-//  map and clean up any aliases for range being removed.
-static void RemoveMemoryRange(uint64_t handle, DEVICE_MEMORY_STATE *mem_info, bool is_image) {
-    auto erase_range = &mem_info->bound_ranges[handle];
-    for (auto alias_range : erase_range->aliases) {
-        alias_range->aliases.erase(erase_range);
-    }
-    erase_range->aliases.clear();
-    mem_info->bound_ranges.erase(handle);
-    if (is_image) {
-        mem_info->bound_images.erase(handle);
-    } else {
-        mem_info->bound_buffers.erase(handle);
-    }
-}
-
 void CoreChecks::RemoveBufferMemoryRange(uint64_t handle, DEVICE_MEMORY_STATE *mem_info) {
     RemoveMemoryRange(handle, mem_info, false);
 }
@@ -4625,6 +4986,7 @@ void CoreChecks::PreCallRecordDestroyPipeline(VkDevice device, VkPipeline pipeli
     if (enabled.gpu_validation) {
         GpuPreCallRecordDestroyPipeline(pipeline);
     }
+    ClearStateCachedInHandle(pipeline);
     pipelineMap.erase(pipeline);
 }
 
@@ -4652,6 +5014,8 @@ void CoreChecks::PreCallRecordDestroySampler(VkDevice device, VkSampler sampler,
     if (sampler_state) {
         InvalidateCommandBuffers(sampler_state->cb_bindings, obj_struct);
     }
+    ++descriptor_resource_epoch;
+    ClearStateCachedInHandle(sampler);
     samplerMap.erase(sampler);
 }
 
@@ -4852,6 +5216,13 @@ bool CoreChecks::PreCallValidateResetFences(VkDevice device, uint32_t fenceCount
     return skip;
 }
 
+// The fences must not be waited on by the background retirement worker while the driver resets them
+void CoreChecks::PreCallRecordResetFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences) {
+    for (uint32_t i = 0; i < fenceCount; ++i) {
+        DropBackgroundRetirement(pFences[i]);
+    }
+}
+
 void CoreChecks::PostCallRecordResetFences(VkDevice device, uint32_t fenceCount, const VkFence *pFences, VkResult result) {
     for (uint32_t i = 0; i < fenceCount; ++i) {
         auto pFence = GetFenceState(pFences[i]);
@@ -4867,6 +5238,7 @@ void CoreChecks::PostCallRecordResetFences(VkDevice device, uint32_t fenceCount,
 
 // For given cb_nodes, invalidate them and track object causing invalidation
 void CoreChecks::InvalidateCommandBuffers(std::unordered_set<CMD_BUFFER_STATE *> const &cb_nodes, const VulkanTypedHandle &obj) {
+    invalidation_count++;
     for (auto cb_node : cb_nodes) {
         if (cb_node->state == CB_RECORDING) {
             log_msg(report_data, VK_DEBUG_REPORT_WARNING_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT,
@@ -4878,6 +5250,8 @@ void CoreChecks::InvalidateCommandBuffers(std::unordered_set<CMD_BUFFER_STATE *>
             cb_node->state = CB_INVALID_COMPLETE;
         }
         cb_node->broken_bindings.push_back(obj);
+        // obj may be about to be destroyed while it's still in in_use_refs
+        cb_node->in_use_refs_stale = true;
 
         // if secondary, then propagate the invalidation to the primaries that will call us.
         if (cb_node->createInfo.level == VK_COMMAND_BUFFER_LEVEL_SECONDARY) {
@@ -5101,6 +5475,9 @@ void CoreChecks::PostCallRecordCreateGraphicsPipelines(VkDevice device, VkPipeli
     for (uint32_t i = 0; i < count; i++) {
         if (pPipelines[i] != VK_NULL_HANDLE) {
             (cgpl_state->pipe_state)[i]->pipeline = pPipelines[i];
+            // Derived pipeline state is computed once here, so binding never writes to the shared PIPELINE_STATE
+            SetPipelineState((cgpl_state->pipe_state)[i].get());
+            CacheStateInHandle(pPipelines[i], (cgpl_state->pipe_state)[i].get());
             pipelineMap[pPipelines[i]] = std::move((cgpl_state->pipe_state)[i]);
         }
     }
@@ -5156,6 +5533,7 @@ void CoreChecks::PostCallRecordCreateComputePipelines(VkDevice device, VkPipelin
     for (uint32_t i = 0; i < count; i++) {
         if (pPipelines[i] != VK_NULL_HANDLE) {
             (ccpl_state->pipe_state)[i]->pipeline = pPipelines[i];
+            CacheStateInHandle(pPipelines[i], (ccpl_state->pipe_state)[i].get());
             pipelineMap[pPipelines[i]] = std::move((ccpl_state->pipe_state)[i]);
         }
     }
@@ -5201,6 +5579,8 @@ void CoreChecks::PostCallRecordCreateRayTracingPipelinesNV(VkDevice device, VkPi
     for (uint32_t i = 0; i < count; i++) {
         if (pPipelines[i] != VK_NULL_HANDLE) {
             (*pipe_state)[i]->pipeline = pPipelines[i];
+            // Failed creations are not wrapped, so only successful ones can carry their state
+            if (VK_SUCCESS == result) CacheStateInHandle(pPipelines[i], (*pipe_state)[i].get());
             pipelineMap[pPipelines[i]] = std::move((*pipe_state)[i]);
         }
     }
@@ -5208,7 +5588,9 @@ void CoreChecks::PostCallRecordCreateRayTracingPipelinesNV(VkDevice device, VkPi
 
 void CoreChecks::PostCallRecordCreateSampler(VkDevice device, const VkSamplerCreateInfo *pCreateInfo,
                                              const VkAllocationCallbacks *pAllocator, VkSampler *pSampler, VkResult result) {
+    if (VK_SUCCESS != result) return;
     samplerMap[*pSampler] = unique_ptr<SAMPLER_STATE>(new SAMPLER_STATE(pSampler, pCreateInfo));
+    CacheStateInHandle(*pSampler, samplerMap[*pSampler].get());
 }
 
 bool CoreChecks::PreCallValidateCreateDescriptorSetLayout(VkDevice device, const VkDescriptorSetLayoutCreateInfo *pCreateInfo,
@@ -5974,6 +6356,8 @@ void CoreChecks::PostCallRecordResetDescriptorPool(VkDevice device, VkDescriptor
         FreeDescriptorSet(ds);
     }
     pPool->sets.clear();
+    // With every set gone, the storage of all their descriptors is released at once
+    if (pPool->descriptor_arena) pPool->descriptor_arena->Reset();
     // Reset available count for each type and available sets for this pool
     for (auto it = pPool->availableDescriptorTypeCount.begin(); it != pPool->availableDescriptorTypeCount.end(); ++it) {
         pPool->availableDescriptorTypeCount[it->first] = pPool->maxDescriptorTypeCount[it->first];
@@ -6088,8 +6472,7 @@ void CoreChecks::PostCallRecordAllocateCommandBuffers(VkDevice device, const VkC
 
 // Add bindings between the given cmd buffer & framebuffer and the framebuffer's children
 void CoreChecks::AddFramebufferBinding(CMD_BUFFER_STATE *cb_state, FRAMEBUFFER_STATE *fb_state) {
-    AddCommandBufferBinding(&fb_state->cb_bindings, VulkanTypedHandle(fb_state->framebuffer, kVulkanObjectTypeFramebuffer),
-                            cb_state);
+    AddCommandBufferBinding(fb_state, VulkanTypedHandle(fb_state->framebuffer, kVulkanObjectTypeFramebuffer), cb_state);
 
     const uint32_t attachmentCount = fb_state->createInfo.attachmentCount;
     for (uint32_t attachment = 0; attachment < attachmentCount; ++attachment) {
@@ -6262,6 +6645,12 @@ void CoreChecks::PostCallRecordEndCommandBuffer(VkCommandBuffer commandBuffer, V
     cb_state->validated_descriptor_sets.clear();
     if (VK_SUCCESS == result) {
         cb_state->state = CB_RECORDED;
+        // The layout maps are final, summarize them once rather than at every submission
+        cb_state->image_layout_summaries.clear();
+        for (const auto &layout_map_entry : cb_state->image_layout_map) {
+            auto &summary = cb_state->image_layout_summaries[layout_map_entry.first];
+            layout_map_entry.second->GetInitialUseRuns(summary.initial_uses);
+        }
     }
 }
 
@@ -6357,8 +6746,8 @@ void CoreChecks::PreCallRecordCmdBindPipeline(VkCommandBuffer commandBuffer, VkP
         cb_state->status |= cb_state->static_status;
     }
     cb_state->lastBound[pipelineBindPoint].pipeline_state = pipe_state;
-    SetPipelineState(pipe_state);
-    AddCommandBufferBinding(&pipe_state->cb_bindings, VulkanTypedHandle(pipeline, kVulkanObjectTypePipeline), cb_state);
+    cb_state->bound_state_generation++;
+    AddCommandBufferBinding(pipe_state, VulkanTypedHandle(pipeline, kVulkanObjectTypePipeline), cb_state);
 }
 
 bool CoreChecks::PreCallValidateCmdSetViewport(VkCommandBuffer commandBuffer, uint32_t firstViewport, uint32_t viewportCount,
@@ -6711,6 +7100,7 @@ void CoreChecks::UpdateLastBoundDescriptorSets(CMD_BUFFER_STATE *cb_state, VkPip
     if (0 == set_count) return;
     assert(pipeline_layout);
     if (!pipeline_layout) return;
+    cb_state->bound_state_generation++;
 
     uint32_t required_size = first_set + set_count;
     const uint32_t last_binding_index = required_size - 1;
@@ -7134,6 +7524,8 @@ void CoreChecks::PreCallRecordCmdBindVertexBuffers(VkCommandBuffer commandBuffer
         vertex_buffer_binding.buffer = pBuffers[i];
         vertex_buffer_binding.offset = pOffsets[i];
     }
+    cb_state->current_draw_data_recorded = false;
+    cb_state->bound_state_generation++;
 }
 
 // Validate that an image's sampleCount matches the requirement for a specific API call
@@ -7209,8 +7601,7 @@ void CoreChecks::PreCallRecordCmdSetEvent(VkCommandBuffer commandBuffer, VkEvent
     CMD_BUFFER_STATE *cb_state = GetCBState(commandBuffer);
     auto event_state = GetEventState(event);
     if (event_state) {
-        AddCommandBufferBinding(&event_state->cb_bindings, VulkanTypedHandle(event, kVulkanObjectTypeEvent), cb_state);
-        event_state->cb_bindings.insert(cb_state);
+        AddCommandBufferBinding(event_state, VulkanTypedHandle(event, kVulkanObjectTypeEvent), cb_state);
     }
     cb_state->events.push_back(event);
     if (!cb_state->waitedEvents.count(event)) {
@@ -7237,8 +7628,7 @@ void CoreChecks::PreCallRecordCmdResetEvent(VkCommandBuffer commandBuffer, VkEve
     CMD_BUFFER_STATE *cb_state = GetCBState(commandBuffer);
     auto event_state = GetEventState(event);
     if (event_state) {
-        AddCommandBufferBinding(&event_state->cb_bindings, VulkanTypedHandle(event, kVulkanObjectTypeEvent), cb_state);
-        event_state->cb_bindings.insert(cb_state);
+        AddCommandBufferBinding(event_state, VulkanTypedHandle(event, kVulkanObjectTypeEvent), cb_state);
     }
     cb_state->events.push_back(event);
     if (!cb_state->waitedEvents.count(event)) {
@@ -8241,8 +8631,7 @@ void CoreChecks::PreCallRecordCmdWaitEvents(VkCommandBuffer commandBuffer, uint3
     for (uint32_t i = 0; i < eventCount; ++i) {
         auto event_state = GetEventState(pEvents[i]);
         if (event_state) {
-            AddCommandBufferBinding(&event_state->cb_bindings, VulkanTypedHandle(pEvents[i], kVulkanObjectTypeEvent), cb_state);
-            event_state->cb_bindings.insert(cb_state);
+            AddCommandBufferBinding(event_state, VulkanTypedHandle(pEvents[i], kVulkanObjectTypeEvent), cb_state);
         }
         cb_state->waitedEvents.insert(pEvents[i]);
         cb_state->events.push_back(pEvents[i]);
@@ -8376,8 +8765,8 @@ bool CoreChecks::ValidateBeginQuery(const CMD_BUFFER_STATE *cb_state, const Quer
 void CoreChecks::RecordBeginQuery(CMD_BUFFER_STATE *cb_state, const QueryObject &query_obj) {
     cb_state->activeQueries.insert(query_obj);
     cb_state->startedQueries.insert(query_obj);
-    AddCommandBufferBinding(&GetQueryPoolState(query_obj.pool)->cb_bindings,
-                            VulkanTypedHandle(query_obj.pool, kVulkanObjectTypeQueryPool), cb_state);
+    AddCommandBufferBinding(GetQueryPoolState(query_obj.pool), VulkanTypedHandle(query_obj.pool, kVulkanObjectTypeQueryPool),
+                            cb_state);
 }
 
 bool CoreChecks::PreCallValidateCmdBeginQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t slot, VkFlags flags) {
@@ -8423,8 +8812,8 @@ bool CoreChecks::PreCallValidateCmdEndQuery(VkCommandBuffer commandBuffer, VkQue
 void CoreChecks::RecordCmdEndQuery(CMD_BUFFER_STATE *cb_state, const QueryObject &query_obj) {
     cb_state->activeQueries.erase(query_obj);
     cb_state->queryUpdates.emplace_back([=](VkQueue q) { return SetQueryState(q, cb_state->commandBuffer, query_obj, true); });
-    AddCommandBufferBinding(&GetQueryPoolState(query_obj.pool)->cb_bindings,
-                            VulkanTypedHandle(query_obj.pool, kVulkanObjectTypeQueryPool), cb_state);
+    AddCommandBufferBinding(GetQueryPoolState(query_obj.pool), VulkanTypedHandle(query_obj.pool, kVulkanObjectTypeQueryPool),
+                            cb_state);
 }
 
 void CoreChecks::PostCallRecordCmdEndQuery(VkCommandBuffer commandBuffer, VkQueryPool queryPool, uint32_t slot) {
@@ -8454,7 +8843,7 @@ void CoreChecks::PostCallRecordCmdResetQueryPool(VkCommandBuffer commandBuffer,
         cb_state->waitedEventsBeforeQueryReset[query] = cb_state->waitedEvents;
         cb_state->queryUpdates.emplace_back([=](VkQueue q) { return SetQueryState(q, commandBuffer, query, false); });
     }
-    AddCommandBufferBinding(&GetQueryPoolState(queryPool)->cb_bindings, VulkanTypedHandle(queryPool, kVulkanObjectTypeQueryPool),
+    AddCommandBufferBinding(GetQueryPoolState(queryPool), VulkanTypedHandle(queryPool, kVulkanObjectTypeQueryPool),
                             cb_state);
 }
 
@@ -8515,7 +8904,7 @@ void CoreChecks::PostCallRecordCmdCopyQueryPoolResults(VkCommandBuffer commandBu
     auto dst_buff_state = GetBufferState(dstBuffer);
     AddCommandBufferBindingBuffer(cb_state, dst_buff_state);
     cb_state->queryUpdates.emplace_back([=](VkQueue q) { return ValidateQuery(q, cb_state, queryPool, firstQuery, queryCount); });
-    AddCommandBufferBinding(&GetQueryPoolState(queryPool)->cb_bindings, VulkanTypedHandle(queryPool, kVulkanObjectTypeQueryPool),
+    AddCommandBufferBinding(GetQueryPoolState(queryPool), VulkanTypedHandle(queryPool, kVulkanObjectTypeQueryPool),
                             cb_state);
 }
 
@@ -9987,8 +10376,8 @@ void CoreChecks::RecordCmdBeginRenderPassState(VkCommandBuffer commandBuffer, co
         // Connect this framebuffer and its children to this cmdBuffer
         AddFramebufferBinding(cb_state, framebuffer);
         // Connect this RP to cmdBuffer
-        AddCommandBufferBinding(&render_pass_state->cb_bindings,
-                                VulkanTypedHandle(render_pass_state->renderPass, kVulkanObjectTypeRenderPass), cb_state);
+        AddCommandBufferBinding(render_pass_state, VulkanTypedHandle(render_pass_state->renderPass, kVulkanObjectTypeRenderPass),
+                                cb_state);
         // transition attachments to the correct layouts for beginning of renderPass and first subpass
         TransitionBeginRenderPassLayouts(cb_state, render_pass_state, framebuffer);
 
@@ -10424,9 +10813,7 @@ void CoreChecks::PreCallRecordUnmapMemory(VkDevice device, VkDeviceMemory mem) {
     auto mem_info = GetDevMemState(mem);
     mem_info->mem_range.size = 0;
     if (mem_info->shadow_copy) {
-        free(mem_info->shadow_copy_base);
-        mem_info->shadow_copy_base = 0;
-        mem_info->shadow_copy = 0;
+        FreeShadowCopy(mem_info);
     }
 }
 
@@ -10469,27 +10856,32 @@ bool CoreChecks::ValidateAndCopyNoncoherentMemoryToDriver(uint32_t mem_range_cou
         auto mem_info = GetDevMemState(mem_ranges[i].memory);
         if (mem_info) {
             if (mem_info->shadow_copy) {
-                VkDeviceSize size = (mem_info->mem_range.size != VK_WHOLE_SIZE)
-                                        ? mem_info->mem_range.size
-                                        : (mem_info->alloc_info.allocationSize - mem_info->mem_range.offset);
+                VkDeviceSize size = MappedSize(mem_info);
                 char *data = static_cast<char *>(mem_info->shadow_copy);
-                for (uint64_t j = 0; j < mem_info->shadow_pad_size; ++j) {
-                    if (data[j] != NoncoherentMemoryFillValue) {
-                        skip |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_MEMORY_EXT,
-                                        HandleToUint64(mem_ranges[i].memory), kVUID_Core_MemTrack_InvalidMap,
-                                        "Memory underflow was detected on mem obj %s.",
-                                        report_data->FormatHandle(mem_ranges[i].memory).c_str());
-                    }
+                if (!NoncoherentGuardIntact(data, mem_info->shadow_pad_size)) {
+                    skip |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_MEMORY_EXT,
+                                    HandleToUint64(mem_ranges[i].memory), kVUID_Core_MemTrack_InvalidMap,
+                                    "Memory underflow was detected on mem obj %s.",
+                                    report_data->FormatHandle(mem_ranges[i].memory).c_str());
                 }
-                for (uint64_t j = (size + mem_info->shadow_pad_size); j < (2 * mem_info->shadow_pad_size + size); ++j) {
-                    if (data[j] != NoncoherentMemoryFillValue) {
-                        skip |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_MEMORY_EXT,
-                                        HandleToUint64(mem_ranges[i].memory), kVUID_Core_MemTrack_InvalidMap,
-                                        "Memory overflow was detected on mem obj %s.",
-                                        report_data->FormatHandle(mem_ranges[i].memory).c_str());
-                    }
+                if (!NoncoherentGuardIntact(data + mem_info->shadow_pad_size + size, mem_info->shadow_pad_size)) {
+                    skip |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_MEMORY_EXT,
+                                    HandleToUint64(mem_ranges[i].memory), kVUID_Core_MemTrack_InvalidMap,
+                                    "Memory overflow was detected on mem obj %s.",
+                                    report_data->FormatHandle(mem_ranges[i].memory).c_str());
+                }
+                // Only the flushed range is made available to the device, so that's all that needs to reach the driver's copy
+                const MemRange extent = MappedExtent(mem_info, mem_ranges[i]);
+                char *driver_data = static_cast<char *>(mem_info->p_driver_data);
+#if defined(__linux__)
+                if (mem_info->shadow_map_size) {
+                    CopyTouchedShadowPages(driver_data + extent.offset, data + mem_info->shadow_pad_size + extent.offset,
+                                           static_cast<size_t>(extent.size));
+                    continue;
                 }
-                memcpy(mem_info->p_driver_data, static_cast<void *>(data + mem_info->shadow_pad_size), (size_t)(size));
+#endif
+                memcpy(driver_data + extent.offset, data + mem_info->shadow_pad_size + extent.offset,
+                       static_cast<size_t>(extent.size));
             }
         }
     }
@@ -10500,11 +10892,11 @@ void CoreChecks::CopyNoncoherentMemoryFromDriver(uint32_t mem_range_count, const
     for (uint32_t i = 0; i < mem_range_count; ++i) {
         auto mem_info = GetDevMemState(mem_ranges[i].memory);
         if (mem_info && mem_info->shadow_copy) {
-            VkDeviceSize size = (mem_info->mem_range.size != VK_WHOLE_SIZE)
-                                    ? mem_info->mem_range.size
-                                    : (mem_info->alloc_info.allocationSize - mem_ranges[i].offset);
+            // Likewise, only the invalidated range is made visible to the host
+            const MemRange extent = MappedExtent(mem_info, mem_ranges[i]);
             char *data = static_cast<char *>(mem_info->shadow_copy);
-            memcpy(data + mem_info->shadow_pad_size, mem_info->p_driver_data, (size_t)(size));
+            memcpy(data + mem_info->shadow_pad_size + extent.offset, static_cast<char *>(mem_info->p_driver_data) + extent.offset,
+                   static_cast<size_t>(extent.size));
         }
     }
 }
@@ -10885,6 +11277,9 @@ void CoreChecks::PostCallRecordQueueBindSparse(VkQueue queue, uint32_t bindInfoC
     if (pFence) {
         if (pFence->scope == kSyncScopeInternal) {
             SubmitFence(pQueue, pFence, std::max(1u, bindInfoCount));
+            if (enabled.background_retirement) {
+                QueueBackgroundRetirement(queue, fence, pFence->signaler.second);
+            }
             if (!bindInfoCount) {
                 // No work to do, just dropping a fence in the queue by itself.
                 pQueue->submissions.emplace_back(std::vector<VkCommandBuffer>(), std::vector<SEMAPHORE_WAIT>(),
@@ -11508,19 +11903,12 @@ void CoreChecks::PreCallRecordDestroySwapchainKHR(VkDevice device, VkSwapchainKH
     auto swapchain_data = GetSwapchainState(swapchain);
     if (swapchain_data) {
         if (swapchain_data->images.size() > 0) {
+            // As with vkDestroyImage, descriptors found valid while the images existed must be validated again
+            ++descriptor_resource_epoch;
             for (auto swapchain_image : swapchain_data->images) {
-                auto image_sub = imageSubresourceMap.find(swapchain_image);
-                if (image_sub != imageSubresourceMap.end()) {
-                    for (auto imgsubpair : image_sub->second) {
-                        auto image_item = imageLayoutMap.find(imgsubpair);
-                        if (image_item != imageLayoutMap.end()) {
-                            imageLayoutMap.erase(image_item);
-                        }
-                    }
-                    imageSubresourceMap.erase(image_sub);
-                }
                 ClearMemoryObjectBindings(VulkanTypedHandle(swapchain_image, kVulkanObjectTypeImage));
                 EraseQFOImageRelaseBarriers(swapchain_image);
+                ClearStateCachedInHandle(swapchain_image);
                 imageMap.erase(swapchain_image);
             }
         }
@@ -11571,9 +11959,6 @@ void CoreChecks::PostCallRecordGetSwapchainImagesKHR(VkDevice device, VkSwapchai
         for (uint32_t i = 0; i < *pSwapchainImageCount; ++i) {
             if (swapchain_state->images[i] != VK_NULL_HANDLE) continue;  // Already retrieved this.
 
-            IMAGE_LAYOUT_STATE image_layout_node;
-            image_layout_node.layout = VK_IMAGE_LAYOUT_UNDEFINED;
-            image_layout_node.format = swapchain_state->createInfo.imageFormat;
             // Add imageMap entries for each swapchain image
             VkImageCreateInfo image_ci = {};
             image_ci.flags = 0;
@@ -11590,12 +11975,11 @@ void CoreChecks::PostCallRecordGetSwapchainImagesKHR(VkDevice device, VkSwapchai
             image_ci.sharingMode = swapchain_state->createInfo.imageSharingMode;
             imageMap[pSwapchainImages[i]] = unique_ptr<IMAGE_STATE>(new IMAGE_STATE(pSwapchainImages[i], &image_ci));
             auto &image_state = imageMap[pSwapchainImages[i]];
+            CacheStateInHandle(pSwapchainImages[i], image_state.get());
             image_state->valid = false;
             image_state->binding.mem = MEMTRACKER_SWAP_CHAIN_IMAGE_KEY;
+            image_state->global_layout_map = GlobalImageLayoutMapFactory(*image_state, VK_IMAGE_LAYOUT_UNDEFINED);
             swapchain_state->images[i] = pSwapchainImages[i];
-            ImageSubresourcePair subpair = {pSwapchainImages[i], false, VkImageSubresource()};
-            imageSubresourceMap[pSwapchainImages[i]].push_back(subpair);
-            imageLayoutMap[subpair] = image_layout_node;
         }
     }
 
@@ -12427,8 +12811,16 @@ void CoreChecks::PreCallRecordDestroyDescriptorUpdateTemplateKHR(VkDevice device
 
 void CoreChecks::RecordCreateDescriptorUpdateTemplateState(const VkDescriptorUpdateTemplateCreateInfoKHR *pCreateInfo,
                                                            VkDescriptorUpdateTemplateKHR *pDescriptorUpdateTemplate) {
-    safe_VkDescriptorUpdateTemplateCreateInfo *local_create_info = new safe_VkDescriptorUpdateTemplateCreateInfo(pCreateInfo);
-    std::unique_ptr<TEMPLATE_STATE> template_state(new TEMPLATE_STATE(*pDescriptorUpdateTemplate, local_create_info));
+    safe_VkDescriptorUpdateTemplateCreateInfo local_create_info(pCreateInfo);
+    std::unique_ptr<UPDATE_TEMPLATE_STATE> template_state(
+        new UPDATE_TEMPLATE_STATE(*pDescriptorUpdateTemplate, &local_create_info));
+    if (pCreateInfo->templateType == VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET) {
+        // Decode the entries into writes now, rather than on every update with the template
+        auto layout = GetDescriptorSetLayout(this, pCreateInfo->descriptorSetLayout);
+        if (layout) {
+            template_state->writes.reset(new cvdescriptorset::TemplateUpdateWrites(layout.get(), template_state->create_info));
+        }
+    }
     desc_template_map[*pDescriptorUpdateTemplate] = std::move(template_state);
 }
 
@@ -12460,7 +12852,7 @@ bool CoreChecks::ValidateUpdateDescriptorSetWithTemplate(VkDescriptorSet descrip
         // but retaining the assert as template support is new enough to want to investigate these in debug builds.
         assert(0);
     } else {
-        const TEMPLATE_STATE *template_state = template_map_entry->second.get();
+        const UPDATE_TEMPLATE_STATE *template_state = template_map_entry->second.get();
         // TODO: Validate template push descriptor updates
         if (template_state->create_info.templateType == VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET) {
             skip = ValidateUpdateDescriptorSetsWithTemplateKHR(descriptorSet, template_state, pData);
@@ -12488,7 +12880,7 @@ void CoreChecks::RecordUpdateDescriptorSetWithTemplateState(VkDescriptorSet desc
     if ((template_map_entry == desc_template_map.end()) || (template_map_entry->second.get() == nullptr)) {
         assert(0);
     } else {
-        const TEMPLATE_STATE *template_state = template_map_entry->second.get();
+        const UPDATE_TEMPLATE_STATE *template_state = template_map_entry->second.get();
         // TODO: Record template push descriptor updates
         if (template_state->create_info.templateType == VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET) {
             PerformUpdateDescriptorSetsWithTemplateKHR(descriptorSet, template_state, pData);
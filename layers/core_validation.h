@@ -26,13 +26,16 @@
 #include "core_validation_error_enums.h"
 #include "core_validation_types.h"
 #include "descriptor_sets.h"
+#include "flat_hash_map.h"
 #include "shader_validation.h"
 #include "gpu_validation.h"
 #include "vk_layer_logging.h"
 #include "vulkan/vk_layer.h"
 #include "vk_typemap_helper.h"
 #include "vk_layer_data.h"
+#include "worker_pool.h"
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <unordered_map>
@@ -40,6 +43,8 @@
 #include <vector>
 #include <list>
 #include <deque>
+#include <mutex>
+#include <thread>
 
 enum SyncScope {
     kSyncScopeInternal,
@@ -173,37 +178,49 @@ struct SURFACE_STATE {
 using std::unordered_map;
 struct GpuValidationState;
 
+// Descriptor update template state, with the writes of a descriptor set template decoded when it's created
+struct UPDATE_TEMPLATE_STATE : public TEMPLATE_STATE {
+    // Null for push descriptor templates, whose set layout comes with each command
+    std::unique_ptr<const cvdescriptorset::TemplateUpdateWrites> writes;
+
+    UPDATE_TEMPLATE_STATE(VkDescriptorUpdateTemplateKHR update_template, safe_VkDescriptorUpdateTemplateCreateInfo *pCreateInfo)
+        : TEMPLATE_STATE(update_template, pCreateInfo) {}
+};
+
+// Tables of state objects looked up by handle. Only the owning pointers live in the map, so the state objects themselves
+// never move when the table grows.
+template <typename Handle, typename StatePointer>
+using state_map = FlatHashMap<Handle, StatePointer>;
+
 class CoreChecks : public ValidationObject {
    public:
-    unordered_map<VkSampler, std::unique_ptr<SAMPLER_STATE>> samplerMap;
-    unordered_map<VkImageView, std::unique_ptr<IMAGE_VIEW_STATE>> imageViewMap;
-    unordered_map<VkImage, std::unique_ptr<IMAGE_STATE>> imageMap;
-    unordered_map<VkBufferView, std::unique_ptr<BUFFER_VIEW_STATE>> bufferViewMap;
-    unordered_map<VkBuffer, std::unique_ptr<BUFFER_STATE>> bufferMap;
-    unordered_map<VkPipeline, std::unique_ptr<PIPELINE_STATE>> pipelineMap;
-    unordered_map<VkDeviceMemory, std::unique_ptr<DEVICE_MEMORY_STATE>> memObjMap;
-    unordered_map<VkFramebuffer, std::unique_ptr<FRAMEBUFFER_STATE>> frameBufferMap;
-    unordered_map<VkShaderModule, std::unique_ptr<SHADER_MODULE_STATE>> shaderModuleMap;
-    unordered_map<VkDescriptorUpdateTemplateKHR, std::unique_ptr<TEMPLATE_STATE>> desc_template_map;
-    unordered_map<VkSwapchainKHR, std::unique_ptr<SWAPCHAIN_NODE>> swapchainMap;
-    unordered_map<VkDescriptorPool, std::unique_ptr<DESCRIPTOR_POOL_STATE>> descriptorPoolMap;
-    unordered_map<VkDescriptorSet, std::unique_ptr<cvdescriptorset::DescriptorSet>> setMap;
-    unordered_map<VkCommandBuffer, std::unique_ptr<CMD_BUFFER_STATE>> commandBufferMap;
-    unordered_map<VkCommandPool, std::unique_ptr<COMMAND_POOL_STATE>> commandPoolMap;
-    unordered_map<VkPipelineLayout, std::unique_ptr<PIPELINE_LAYOUT_STATE>> pipelineLayoutMap;
-    unordered_map<VkFence, std::unique_ptr<FENCE_STATE>> fenceMap;
-    unordered_map<VkQueryPool, std::unique_ptr<QUERY_POOL_STATE>> queryPoolMap;
-    unordered_map<VkSemaphore, std::unique_ptr<SEMAPHORE_STATE>> semaphoreMap;
-    unordered_map<VkSurfaceKHR, std::unique_ptr<SURFACE_STATE>> surface_map;
+    state_map<VkSampler, std::unique_ptr<SAMPLER_STATE>> samplerMap;
+    state_map<VkImageView, std::unique_ptr<IMAGE_VIEW_STATE>> imageViewMap;
+    state_map<VkImage, std::unique_ptr<IMAGE_STATE>> imageMap;
+    state_map<VkBufferView, std::unique_ptr<BUFFER_VIEW_STATE>> bufferViewMap;
+    state_map<VkBuffer, std::unique_ptr<BUFFER_STATE>> bufferMap;
+    state_map<VkPipeline, std::unique_ptr<PIPELINE_STATE>> pipelineMap;
+    state_map<VkDeviceMemory, std::unique_ptr<DEVICE_MEMORY_STATE>> memObjMap;
+    state_map<VkFramebuffer, std::unique_ptr<FRAMEBUFFER_STATE>> frameBufferMap;
+    state_map<VkShaderModule, std::unique_ptr<SHADER_MODULE_STATE>> shaderModuleMap;
+    state_map<VkDescriptorUpdateTemplateKHR, std::unique_ptr<UPDATE_TEMPLATE_STATE>> desc_template_map;
+    state_map<VkSwapchainKHR, std::unique_ptr<SWAPCHAIN_NODE>> swapchainMap;
+    state_map<VkDescriptorPool, std::unique_ptr<DESCRIPTOR_POOL_STATE>> descriptorPoolMap;
+    state_map<VkDescriptorSet, std::unique_ptr<cvdescriptorset::DescriptorSet>> setMap;
+    state_map<VkCommandBuffer, std::unique_ptr<CMD_BUFFER_STATE>> commandBufferMap;
+    state_map<VkCommandPool, std::unique_ptr<COMMAND_POOL_STATE>> commandPoolMap;
+    state_map<VkPipelineLayout, std::unique_ptr<PIPELINE_LAYOUT_STATE>> pipelineLayoutMap;
+    state_map<VkFence, std::unique_ptr<FENCE_STATE>> fenceMap;
+    state_map<VkQueryPool, std::unique_ptr<QUERY_POOL_STATE>> queryPoolMap;
+    state_map<VkSemaphore, std::unique_ptr<SEMAPHORE_STATE>> semaphoreMap;
+    state_map<VkSurfaceKHR, std::unique_ptr<SURFACE_STATE>> surface_map;
     unordered_map<VkQueue, QUEUE_STATE> queueMap;
     unordered_map<VkEvent, EVENT_STATE> eventMap;
-    unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE> imageLayoutMap;
 
-    unordered_map<VkRenderPass, std::shared_ptr<RENDER_PASS_STATE>> renderPassMap;
-    unordered_map<VkDescriptorSetLayout, std::shared_ptr<cvdescriptorset::DescriptorSetLayout>> descriptorSetLayoutMap;
+    state_map<VkRenderPass, std::shared_ptr<RENDER_PASS_STATE>> renderPassMap;
+    state_map<VkDescriptorSetLayout, std::shared_ptr<cvdescriptorset::DescriptorSetLayout>> descriptorSetLayoutMap;
 
     std::unordered_set<VkQueue> queues;  // All queues under given device
-    unordered_map<VkImage, std::vector<ImageSubresourcePair>> imageSubresourceMap;
     unordered_map<QueryObject, bool> queryToStateMap;
     unordered_map<VkSamplerYcbcrConversion, uint64_t> ycbcr_conversion_ahb_fmt_map;
     std::unordered_set<uint64_t> ahb_ext_formats_set;
@@ -239,9 +256,69 @@ class CoreChecks : public ValidationObject {
     DeviceExtensionProperties phys_dev_ext_props = {};
     std::vector<VkCooperativeMatrixPropertiesNV> cooperative_matrix_properties;
     bool external_sync_warning = false;
+    // Bumped whenever InvalidateCommandBuffers runs, i.e. an object is destroyed or a bound descriptor set updated
+    std::atomic<uint64_t> invalidation_count{0};
+    // Bumped whenever an object that descriptors refer to is destroyed, i.e. an image (swapchain images included), view, buffer,
+    // buffer view, sampler or memory object. Descriptor contents found valid at an older epoch are validated again when next
+    // written.
+    std::atomic<uint64_t> descriptor_resource_epoch{1};
     std::unique_ptr<GpuValidationState> gpu_validation_state;
+
+    // With background_retirement enabled, a worker thread waits on the fences of submissions and retires them as they
+    // complete. In-use errors for objects of completed submissions that the app hasn't waited on are then timing-dependent:
+    // they are only reported if the worker hasn't got to the submission yet. Everything below is guarded by retire_mutex,
+    // which may be taken while holding the object lock, never the reverse.
+    struct PendingRetirement {
+        VkFence fence;
+        VkQueue queue;
+        uint64_t seq;  // Queue seq the fence signals
+    };
+    std::thread retire_thread;
+    std::mutex retire_mutex;
+    std::condition_variable retire_cv;
+    std::vector<PendingRetirement> pending_retirements;
+    std::vector<VkFence> polled_fences;  // The fences the worker is waiting on, outside of any lock
+    bool retire_thread_exit = false;
+
+    // With parallel_descriptor_validation enabled, the threads that validate large descriptor arrays at draw time
+    std::unique_ptr<WorkerPool> descriptor_worker_pool;
+
+    ~CoreChecks();
     uint32_t physical_device_count;
 
+    // Override chassis command buffer locks, so that vkCmd* calls on different command buffers can run concurrently
+    cb_lock_guard_t cb_read_lock(VkCommandBuffer command_buffer);
+    cb_lock_guard_t cb_write_lock(VkCommandBuffer command_buffer);
+    bool ConcurrentCommandBufferRecording() const;
+    cb_lock_guard_t CommandBufferLock(VkCommandBuffer command_buffer);
+
+    // With embedded wrapped handles, the states of the most frequently looked up objects are also kept in the handle's
+    // record, which lets the Get*State functions below skip the map lookup. Destroyed, unknown and unwrapped handles have no
+    // record, so their lookups fall back to the maps; clear the cached state when erasing it from a map, as the record
+    // outlives the state until the chassis retires the handle.
+    template <typename HandleType, typename State>
+    static void CacheStateInHandle(HandleType handle, State* state) {
+#if defined(LAYER_CHASSIS_EMBED_HANDLES)
+        WrappedHandleRecord* record = GetWrappedHandleRecord(handle);
+        if (record) record->core_state = state;
+#endif
+    }
+    template <typename HandleType>
+    static void ClearStateCachedInHandle(HandleType handle) {
+#if defined(LAYER_CHASSIS_EMBED_HANDLES)
+        WrappedHandleRecord* record = GetWrappedHandleRecord(handle);
+        if (record) record->core_state = nullptr;
+#endif
+    }
+    template <typename State, typename HandleType>
+    static State* GetStateCachedInHandle(HandleType handle) {
+#if defined(LAYER_CHASSIS_EMBED_HANDLES)
+        WrappedHandleRecord* record = GetWrappedHandleRecord(handle);
+        if (record) return static_cast<State*>(record->core_state);
+#endif
+        return nullptr;
+    }
+
     // Class Declarations for helper functions
     cvdescriptorset::DescriptorSet* GetSetNode(VkDescriptorSet);
     DESCRIPTOR_POOL_STATE* GetDescriptorPoolState(const VkDescriptorPool);
@@ -304,9 +381,13 @@ class CoreChecks : public ValidationObject {
     bool CheckCommandBuffersInFlight(COMMAND_POOL_STATE* pPool, const char* action, const char* error_code);
     bool CheckCommandBufferInFlight(const CMD_BUFFER_STATE* cb_node, const char* action, const char* error_code);
     bool VerifyQueueStateToFence(VkFence fence);
-    void DecrementBoundResources(CMD_BUFFER_STATE const* cb_node);
     bool VerifyWaitFenceState(VkFence fence, const char* apiCall);
     void RetireFence(VkFence fence);
+    void StartBackgroundRetirement();
+    void StopBackgroundRetirement();
+    void BackgroundRetirementLoop();
+    void QueueBackgroundRetirement(VkQueue queue, VkFence fence, uint64_t seq);
+    void DropBackgroundRetirement(VkFence fence);
     void StoreMemRanges(VkDeviceMemory mem, VkDeviceSize offset, VkDeviceSize size);
     bool ValidateIdleDescriptorSet(VkDescriptorSet set, const char* func_str);
     void InitializeAndTrackMemory(VkDeviceMemory mem, VkDeviceSize offset, VkDeviceSize size, void** ppData);
@@ -339,6 +420,7 @@ class CoreChecks : public ValidationObject {
     bool ValidateRenderPassCompatibility(const char* type1_string, const RENDER_PASS_STATE* rp1_state, const char* type2_string,
                                          const RENDER_PASS_STATE* rp2_state, const char* caller, const char* error_code);
     void UpdateDrawState(CMD_BUFFER_STATE* cb_state, const VkPipelineBindPoint bind_point);
+    void RecordValidatedDrawState(CMD_BUFFER_STATE* cb_state, const VkPipelineBindPoint bind_point);
     bool ReportInvalidCommandBuffer(const CMD_BUFFER_STATE* cb_state, const char* call_source);
     void InitGpuValidation();
     bool ValidatePhysicalDeviceQueueFamily(const PHYSICAL_DEVICE_STATE* pd_state, uint32_t requested_queue_family,
@@ -448,6 +530,7 @@ class CoreChecks : public ValidationObject {
     bool ValidateCmdNextSubpass(RenderPassCreateVersion rp_version, VkCommandBuffer commandBuffer);
     bool RangesIntersect(MEMORY_RANGE const* range1, VkDeviceSize offset, VkDeviceSize end);
     bool RangesIntersect(MEMORY_RANGE const* range1, MEMORY_RANGE const* range2, bool* skip, bool skip_checks);
+    VkDeviceSize BoundRangePadMask() const;
     void RecordCreateSwapchainState(VkResult result, const VkSwapchainCreateInfoKHR* pCreateInfo, VkSwapchainKHR* pSwapchain,
                                     SURFACE_STATE* surface_state, SWAPCHAIN_NODE* old_swapchain_state);
     void RecordVulkanSurface(VkSurfaceKHR* pSurface);
@@ -512,9 +595,6 @@ class CoreChecks : public ValidationObject {
     bool InsideRenderPass(const CMD_BUFFER_STATE* pCB, const char* apiName, const char* msgCode);
     bool OutsideRenderPass(CMD_BUFFER_STATE* pCB, const char* apiName, const char* msgCode);
 
-    void SetLayout(std::unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE>& imageLayoutMap, ImageSubresourcePair imgpair,
-                   VkImageLayout layout);
-
     bool ValidateImageSampleCount(IMAGE_STATE* image_state, VkSampleCountFlagBits sample_count, const char* location,
                                   const std::string& msgCode);
     bool ValidateCmdSubpassState(const CMD_BUFFER_STATE* pCB, const CMD_TYPE cmd_type);
@@ -569,7 +649,7 @@ class CoreChecks : public ValidationObject {
     bool ValidateCmdBufDrawState(CMD_BUFFER_STATE* cb_node, CMD_TYPE cmd_type, const bool indexed,
                                  const VkPipelineBindPoint bind_point, const char* function, const char* pipe_err_code,
                                  const char* state_err_code);
-    void IncrementBoundObjects(CMD_BUFFER_STATE const* cb_node);
+    void ResolveInUseRefs(CMD_BUFFER_STATE* cb_node);
     void IncrementResources(CMD_BUFFER_STATE* cb_node);
     bool ValidateEventStageMask(VkQueue queue, CMD_BUFFER_STATE* pCB, uint32_t eventCount, size_t firstEventIndex,
                                 VkPipelineStageFlags sourceStageMask);
@@ -586,10 +666,11 @@ class CoreChecks : public ValidationObject {
                                                 void* pData);
 
     // Descriptor Set Validation Functions
-    bool ValidateUpdateDescriptorSetsWithTemplateKHR(VkDescriptorSet descriptorSet, const TEMPLATE_STATE* template_state,
+    bool ValidateUpdateDescriptorSetsWithTemplateKHR(VkDescriptorSet descriptorSet, const UPDATE_TEMPLATE_STATE* template_state,
                                                      const void* pData);
-    void PerformUpdateDescriptorSetsWithTemplateKHR(VkDescriptorSet descriptorSet, const TEMPLATE_STATE* template_state,
+    void PerformUpdateDescriptorSetsWithTemplateKHR(VkDescriptorSet descriptorSet, const UPDATE_TEMPLATE_STATE* template_state,
                                                     const void* pData);
+    bool ValidateWriteUpdate(cvdescriptorset::DescriptorSet* set_node, const VkWriteDescriptorSet* update, const char* func_name);
     void UpdateAllocateDescriptorSetsData(const VkDescriptorSetAllocateInfo*, cvdescriptorset::AllocateDescriptorSetsData*);
     bool ValidateAllocateDescriptorSets(const VkDescriptorSetAllocateInfo*, const cvdescriptorset::AllocateDescriptorSetsData*);
     void PerformAllocateDescriptorSets(const VkDescriptorSetAllocateInfo*, const VkDescriptorSet*,
@@ -670,10 +751,6 @@ class CoreChecks : public ValidationObject {
     void ReportSetupProblem(VkDebugReportObjectTypeEXT object_type, uint64_t object_handle, const char* const specific_message);
 
     // Buffer Validation Functions
-    template <class OBJECT, class LAYOUT>
-    void SetLayout(OBJECT* pObject, VkImage image, VkImageSubresource range, const LAYOUT& layout);
-    template <class OBJECT, class LAYOUT>
-    void SetLayout(OBJECT* pObject, ImageSubresourcePair imgpair, const LAYOUT& layout, VkImageAspectFlags aspectMask);
     // Remove the pending QFO release records from the global set
     // Note that the type of the handle argument constrained to match Barrier type
     // The defaulted BarrierRecord argument allows use to declare the type once, but is not intended to be specified by the caller
@@ -734,6 +811,11 @@ class CoreChecks : public ValidationObject {
                            const char* caller, const char* layout_invalid_msg_code, const char* layout_mismatch_msg_code,
                            bool* error);
 
+    // The subresource layout test of VerifyImageLayout, without reporting, so that worker threads can run it
+    bool ImageLayoutMatchesUse(CMD_BUFFER_STATE const* cb_node, const IMAGE_STATE* image_state,
+                               const VkImageSubresourceRange& range, VkImageAspectFlags view_aspect,
+                               VkImageLayout explicit_layout) const;
+
     bool VerifyImageLayout(CMD_BUFFER_STATE const* cb_node, IMAGE_STATE* image_state, const VkImageSubresourceRange& range,
                            VkImageLayout explicit_layout, VkImageLayout optimal_layout, const char* caller,
                            const char* layout_invalid_msg_code, const char* layout_mismatch_msg_code, bool* error) {
@@ -778,20 +860,8 @@ class CoreChecks : public ValidationObject {
                                                 const VkClearDepthStencilValue* pDepthStencil, uint32_t rangeCount,
                                                 const VkImageSubresourceRange* pRanges);
 
-    bool FindLayoutVerifyLayout(ImageSubresourcePair imgpair, VkImageLayout& layout, const VkImageAspectFlags aspectMask);
-
-    bool FindGlobalLayout(ImageSubresourcePair imgpair, VkImageLayout& layout);
-
     bool FindLayouts(VkImage image, std::vector<VkImageLayout>& layouts);
 
-    bool FindLayout(const std::unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE>& imageLayoutMap,
-                    ImageSubresourcePair imgpair, VkImageLayout& layout);
-
-    bool FindLayout(const std::unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE>& imageLayoutMap,
-                    ImageSubresourcePair imgpair, VkImageLayout& layout, const VkImageAspectFlags aspectMask);
-
-    void SetGlobalLayout(ImageSubresourcePair imgpair, const VkImageLayout& layout);
-
     void SetImageViewLayout(CMD_BUFFER_STATE* pCB, VkImageView imageView, const VkImageLayout& layout);
 
     void SetImageViewLayout(CMD_BUFFER_STATE* cb_node, const IMAGE_VIEW_STATE& view_state, VkImageLayout layout);
@@ -858,9 +928,7 @@ class CoreChecks : public ValidationObject {
                                    VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageBlit* pRegions,
                                    VkFilter filter);
 
-    bool ValidateCmdBufImageLayouts(CMD_BUFFER_STATE* pCB,
-                                    std::unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE> const& globalImageLayoutMap,
-                                    std::unordered_map<ImageSubresourcePair, IMAGE_LAYOUT_STATE>& overlayLayoutMap);
+    bool ValidateCmdBufImageLayouts(CMD_BUFFER_STATE* pCB, GlobalImageLayoutMap::OverlayMap& overlayLayoutMap);
 
     void UpdateCmdBufImageLayouts(CMD_BUFFER_STATE* pCB);
 
@@ -1159,6 +1227,7 @@ class CoreChecks : public ValidationObject {
     bool PreCallValidateResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetFlags flags);
     void PostCallRecordResetCommandPool(VkDevice device, VkCommandPool commandPool, VkCommandPoolResetFlags flags, VkResult result);
     bool PreCallValidateResetFences(VkDevice device, uint32_t fenceCount, const VkFence* pFences);
+    void PreCallRecordResetFences(VkDevice device, uint32_t fenceCount, const VkFence* pFences);
     void PostCallRecordResetFences(VkDevice device, uint32_t fenceCount, const VkFence* pFences, VkResult result);
     bool PreCallValidateDestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer, const VkAllocationCallbacks* pAllocator);
     void PreCallRecordDestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer, const VkAllocationCallbacks* pAllocator);
@@ -25,8 +25,11 @@
 #ifndef CORE_VALIDATION_TYPES_H_
 #define CORE_VALIDATION_TYPES_H_
 
+#include "arena_allocator.h"
 #include "cast_utils.h"
 #include "hash_vk_types.h"
+#include "interval_tree.h"
+#include "slab_allocator.h"
 #include "sparse_containers.h"
 #include "vk_safe_struct.h"
 #include "vulkan/vulkan.h"
@@ -37,12 +40,14 @@
 #include "convert_to_renderpass2.h"
 #include "layer_chassis_dispatch.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string.h>
 #include <unordered_map>
@@ -80,8 +85,19 @@ class BASE_NODE {
     //  binding removed when command buffer is reset or destroyed
     // When an object is destroyed, any bound cbs are set to INVALID
     std::unordered_set<CMD_BUFFER_STATE *> cb_bindings;
+    // Command buffers may be recorded concurrently, so cb_bindings is only updated through these
+    std::mutex cb_bindings_lock;
 
     BASE_NODE() { in_use.store(0); };
+
+    void AddCbBinding(CMD_BUFFER_STATE *cb_node) {
+        std::lock_guard<std::mutex> lock(cb_bindings_lock);
+        cb_bindings.insert(cb_node);
+    }
+    void RemoveCbBinding(CMD_BUFFER_STATE *cb_node) {
+        std::lock_guard<std::mutex> lock(cb_bindings_lock);
+        cb_bindings.erase(cb_node);
+    }
 };
 
 // Track command pools and their command buffers
@@ -145,6 +161,9 @@ enum descriptor_req {
     DESCRIPTOR_REQ_COMPONENT_TYPE_UINT = DESCRIPTOR_REQ_COMPONENT_TYPE_SINT << 1,
 };
 
+// The requirements on the bindings of one descriptor set, as (binding#, requirements) pairs sorted by binding#
+typedef std::vector<std::pair<uint32_t, descriptor_req>> BindingReqMap;
+
 struct DESCRIPTOR_POOL_STATE : BASE_NODE {
     VkDescriptorPool pool;
     uint32_t maxSets;        // Max descriptor sets allowed in this pool
@@ -154,6 +173,9 @@ struct DESCRIPTOR_POOL_STATE : BASE_NODE {
     std::unordered_set<cvdescriptorset::DescriptorSet *> sets;  // Collection of all sets in this pool
     std::map<uint32_t, uint32_t> maxDescriptorTypeCount;        // Max # of descriptors of each type in this pool
     std::map<uint32_t, uint32_t> availableDescriptorTypeCount;  // Available # of descriptors of each type in this pool
+    // Backing store for the descriptors of this pool's sets. Only pools without FREE_DESCRIPTOR_SET_BIT have one, since
+    // their sets can only be released all together by resetting or destroying the pool.
+    std::unique_ptr<ArenaAllocator> descriptor_arena;
 
     DESCRIPTOR_POOL_STATE(const VkDescriptorPool pool, const VkDescriptorPoolCreateInfo *pCreateInfo)
         : pool(pool),
@@ -161,7 +183,9 @@ struct DESCRIPTOR_POOL_STATE : BASE_NODE {
           availableSets(pCreateInfo->maxSets),
           createInfo(pCreateInfo),
           maxDescriptorTypeCount(),
-          availableDescriptorTypeCount() {
+          availableDescriptorTypeCount(),
+          descriptor_arena() {
+        if (!(pCreateInfo->flags & VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT)) descriptor_arena.reset(new ArenaAllocator());
         // Collect maximums per descriptor type.
         for (uint32_t i = 0; i < createInfo.poolSizeCount; ++i) {
             uint32_t typeIndex = static_cast<uint32_t>(createInfo.pPoolSizes[i].type);
@@ -239,7 +263,7 @@ class BINDABLE : public BASE_NODE {
     const std::unordered_set<VkDeviceMemory> &GetBoundMemory() const { return bound_memory_set_; }
 };
 
-class BUFFER_STATE : public BINDABLE {
+class BUFFER_STATE : public BINDABLE, public SlabAllocated<BUFFER_STATE> {
    public:
     VkBuffer buffer;
     VkBufferCreateInfo createInfo;
@@ -267,7 +291,7 @@ class BUFFER_STATE : public BINDABLE {
     };
 };
 
-class BUFFER_VIEW_STATE : public BASE_NODE {
+class BUFFER_VIEW_STATE : public BASE_NODE, public SlabAllocated<BUFFER_VIEW_STATE> {
    public:
     VkBufferView buffer_view;
     VkBufferViewCreateInfo create_info;
@@ -275,7 +299,7 @@ class BUFFER_VIEW_STATE : public BASE_NODE {
     BUFFER_VIEW_STATE(const BUFFER_VIEW_STATE &rh_obj) = delete;
 };
 
-struct SAMPLER_STATE : public BASE_NODE {
+struct SAMPLER_STATE : public BASE_NODE, public SlabAllocated<SAMPLER_STATE> {
     VkSampler sampler;
     VkSamplerCreateInfo createInfo;
     VkSamplerYcbcrConversion samplerConversion = VK_NULL_HANDLE;
@@ -286,7 +310,36 @@ struct SAMPLER_STATE : public BASE_NODE {
     }
 };
 
-class IMAGE_STATE : public BINDABLE {
+class ImageSubresourceLayoutMap;
+// Interface class for the layouts an image's subresources are in as of the last recorded queue submission. Layouts are range
+// encoded per aspect, mip level, and array layer, such that a transition of the whole image is a single entry.
+class GlobalImageLayoutMap {
+   public:
+    typedef std::unordered_map<VkImage, std::unique_ptr<GlobalImageLayoutMap>> OverlayMap;
+
+    virtual bool SetSubresourceRangeLayout(const VkImageSubresourceRange &range, VkImageLayout layout) = 0;
+    virtual VkImageLayout GetSubresourceLayout(const VkImageSubresource &subresource) const = 0;
+    // As GetSubresourceLayout, additionally lowering *layer_count to the number of layers from subresource.arrayLayer on
+    // that share the layout
+    virtual VkImageLayout GetSubresourceLayoutRun(const VkImageSubresource &subresource, uint32_t *layer_count) const = 0;
+    // Append each distinct layout any subresource is in
+    virtual void GetLayouts(std::vector<VkImageLayout> &layouts) const = 0;
+    // Apply the layouts set by a command buffer
+    virtual bool UpdateFrom(const ImageSubresourceLayoutMap &from) = 0;
+    // Changes whenever any layout does.  Versions are unique across all maps, s.t. a version recorded against one image can't
+    // match a map created later for a reused handle.
+    virtual uint64_t Version() const = 0;
+    GlobalImageLayoutMap() {}
+    virtual ~GlobalImageLayoutMap() {}
+
+   protected:
+    static uint64_t NextVersion() {
+        static std::atomic<uint64_t> next_version(1);
+        return next_version++;
+    }
+};
+
+class IMAGE_STATE : public BINDABLE, public SlabAllocated<IMAGE_STATE> {
    public:
     VkImage image;
     VkImageCreateInfo createInfo;
@@ -307,6 +360,8 @@ class IMAGE_STATE : public BINDABLE {
 #endif  // VK_USE_PLATFORM_ANDROID_KHR
 
     std::vector<VkSparseImageMemoryRequirements> sparse_requirements;
+    // Layouts as of the last queue submission referencing the image, see UpdateCmdBufImageLayouts
+    std::unique_ptr<GlobalImageLayoutMap> global_layout_map;
     IMAGE_STATE(VkImage img, const VkImageCreateInfo *pCreateInfo);
     IMAGE_STATE(IMAGE_STATE const &rh_obj) = delete;
 
@@ -318,7 +373,7 @@ class IMAGE_STATE : public BINDABLE {
     };
 };
 
-class IMAGE_VIEW_STATE : public BASE_NODE {
+class IMAGE_VIEW_STATE : public BASE_NODE, public SlabAllocated<IMAGE_VIEW_STATE> {
    public:
     VkImageView image_view;
     VkImageViewCreateInfo create_info;
@@ -341,8 +396,6 @@ struct MEMORY_RANGE {
     VkDeviceSize start;
     VkDeviceSize size;
     VkDeviceSize end;  // Store this pre-computed for simplicity
-    // Set of ptrs to every range aliased with this one
-    std::unordered_set<MEMORY_RANGE *> aliases;
 };
 
 static inline VulkanTypedHandle MemoryRangeTypedHandle(const MEMORY_RANGE &range) {
@@ -354,7 +407,7 @@ static inline VulkanTypedHandle MemoryRangeTypedHandle(const MEMORY_RANGE &range
 }
 
 // Data struct for tracking memory object
-struct DEVICE_MEMORY_STATE : public BASE_NODE {
+struct DEVICE_MEMORY_STATE : public BASE_NODE, public SlabAllocated<DEVICE_MEMORY_STATE> {
     void *object;  // Dispatchable object used to create this memory (device of swapchain)
     VkDeviceMemory mem;
     VkMemoryAllocateInfo alloc_info;
@@ -365,6 +418,8 @@ struct DEVICE_MEMORY_STATE : public BASE_NODE {
     VkExternalMemoryHandleTypeFlags export_handle_type_flags;
     std::unordered_set<VulkanTypedHandle> obj_bindings;       // objects bound to this memory
     std::unordered_map<uint64_t, MEMORY_RANGE> bound_ranges;  // Map of object to its binding range
+    // The bound_ranges by [start, end], for finding the ones that overlap a range without visiting them all
+    IntervalTree<VkDeviceSize, MEMORY_RANGE *> bound_range_tree;
     // Convenience vectors image/buff handles to speed up iterating over images or buffers independently
     std::unordered_set<uint64_t> bound_images;
     std::unordered_set<uint64_t> bound_buffers;
@@ -373,7 +428,8 @@ struct DEVICE_MEMORY_STATE : public BASE_NODE {
     void *shadow_copy_base;    // Base of layer's allocation for guard band, data, and alignment space
     void *shadow_copy;         // Pointer to start of guard-band data before mapped region
     uint64_t shadow_pad_size;  // Size of the guard-band data before and after actual data. It MUST be a
-                               // multiple of limits.minMemoryMapAlignment
+                               // multiple of limits.minMemoryMapAlignment, unless the shadow is between guard pages
+    size_t shadow_map_size;    // Size of the guard page mapping at shadow_copy_base, or 0 if the shadow was malloc'd
     void *p_driver_data;       // Pointer to application's actual memory
 
     DEVICE_MEMORY_STATE(void *disp_object, const VkDeviceMemory in_mem, const VkMemoryAllocateInfo *p_alloc_info)
@@ -389,6 +445,7 @@ struct DEVICE_MEMORY_STATE : public BASE_NODE {
           shadow_copy_base(0),
           shadow_copy(0),
           shadow_pad_size(0),
+          shadow_map_size(0),
           p_driver_data(0){};
 };
 
@@ -514,6 +571,15 @@ class ImageSubresourceLayoutMap {
         VkImageLayout layout;
     };
 
+    // A run of array layers, within one aspect and mip level, with the same initial use
+    struct InitialUseRun {
+        VkImageSubresource subresource;  // Of the first layer of the run
+        uint32_t layer_count;
+        VkImageLayout layout;
+        VkImageAspectFlags aspect_mask;  // From the InitialLayoutState, for ImageLayoutMatches
+    };
+    typedef std::vector<InitialUseRun> InitialUseRuns;
+
     class ConstIteratorInterface {
        public:
         // Make the value accessor non virtual
@@ -550,6 +616,8 @@ class ImageSubresourceLayoutMap {
                                                   VkImageLayout layout, const IMAGE_VIEW_STATE *view_state = nullptr) = 0;
     virtual bool ForRange(const VkImageSubresourceRange &range, const Callback &callback, bool skip_invalid = true,
                           bool always_get_initial = false) const = 0;
+    // Append the initial uses that constrain the layout at submit time, i.e. all but VK_IMAGE_LAYOUT_UNDEFINED
+    virtual void GetInitialUseRuns(InitialUseRuns &runs) const = 0;
     virtual VkImageLayout GetSubresourceLayout(const VkImageSubresource subresource) const = 0;
     virtual VkImageLayout GetSubresourceInitialLayout(const VkImageSubresource subresource) const = 0;
     virtual const InitialLayoutState *GetSubresourceInitialLayoutState(const VkImageSubresource subresource) const = 0;
@@ -565,8 +633,9 @@ class ImageSubresourceLayoutMapImpl : public ImageSubresourceLayoutMap {
     typedef ImageSubresourceLayoutMap Base;
     typedef AspectTraits_ AspectTraits;
     typedef Base::SubresourceLayout SubresourceLayout;
-    typedef sparse_container::SparseVector<size_t, VkImageLayout, true, kInvalidLayout, kSparseThreshold> LayoutMap;
-    typedef sparse_container::SparseVector<size_t, VkImageLayout, false, kInvalidLayout, kSparseThreshold> InitialLayoutMap;
+    // Layouts change in runs of array layers (and whole mips), so the large maps are kept range encoded
+    typedef sparse_container::SparseVector<size_t, VkImageLayout, true, kInvalidLayout, kSparseThreshold, true> LayoutMap;
+    typedef sparse_container::SparseVector<size_t, VkImageLayout, false, kInvalidLayout, kSparseThreshold, true> InitialLayoutMap;
 
     struct Layouts {
         LayoutMap current;
@@ -678,7 +747,9 @@ class ImageSubresourceLayoutMapImpl : public ImageSubresourceLayoutMap {
 
     // Loop over the given range calling the callback, primarily for
     // validation checks.  By default the initial_value is only looked
-    // up if the set value isn't found.
+    // up if the set value isn't found.  The maps are read a run of
+    // equal values at a time, and runs that are invalid are skipped
+    // without visiting each subresource.
     bool ForRange(const VkImageSubresourceRange &range, const Callback &callback, bool skip_invalid = true,
                   bool always_get_initial = false) const override {
         if (!InRange(range)) return false;  // Don't even try to process bogus subreources
@@ -696,16 +767,22 @@ class ImageSubresourceLayoutMapImpl : public ImageSubresourceLayoutMap {
             aspect = aspects[aspect_index];  // noting that this and the following loop indices are references
             size_t array_offset = Encode(aspect_index, range.baseMipLevel);
             for (level = range.baseMipLevel; level < end_mip; ++level, array_offset += mip_size_) {
-                for (layer = range.baseArrayLayer; layer < end_layer; layer++) {
-                    // TODO -- would an interator with range check be faster?
+                const size_t level_end = array_offset + end_layer;
+                layer = range.baseArrayLayer;
+                while (layer < end_layer) {
                     size_t index = array_offset + layer;
-                    VkImageLayout layout = layouts_.current.Get(index);
+                    size_t run_end = level_end;
+                    VkImageLayout layout = layouts_.current.GetRun(index, &run_end);
                     VkImageLayout initial_layout = kInvalidLayout;
                     if (always_get_initial || (layout == kInvalidLayout)) {
-                        initial_layout = layouts_.initial.Get(index);
+                        initial_layout = layouts_.initial.GetRun(index, &run_end);
                     }
 
-                    if (!skip_invalid || (layout != kInvalidLayout) || (initial_layout != kInvalidLayout)) {
+                    if (skip_invalid && (layout == kInvalidLayout) && (initial_layout == kInvalidLayout)) {
+                        layer += static_cast<uint32_t>(run_end - index);
+                        continue;
+                    }
+                    for (; index < run_end; ++index, ++layer) {
                         keep_on = callback(subres, layout, initial_layout);
                         if (!keep_on) return keep_on;  // False value from the callback aborts the range traversal
                     }
@@ -714,6 +791,31 @@ class ImageSubresourceLayoutMapImpl : public ImageSubresourceLayoutMap {
         }
         return keep_on;
     }
+    void GetInitialUseRuns(InitialUseRuns &runs) const override {
+        const auto &aspects = AspectTraits::AspectBits();
+        for (uint32_t aspect_index = 0; aspect_index < AspectTraits::kAspectCount; aspect_index++) {
+            for (uint32_t mip_level = 0; mip_level < image_state_.full_range.levelCount; ++mip_level) {
+                size_t index = Encode(aspect_index, mip_level);
+                const size_t level_end = index + mip_size_;
+                while (index < level_end) {
+                    size_t run_end = level_end;
+                    VkImageLayout layout = layouts_.initial.GetRun(index, &run_end);
+                    if ((layout != kInvalidLayout) && (layout != VK_IMAGE_LAYOUT_UNDEFINED)) {
+                        const auto *initial_layout_state = initial_layout_state_map_.GetRun(index, &run_end);
+                        assert(initial_layout_state);  // There's no way we should have an initial layout without matching state...
+                        const uint32_t layer = static_cast<uint32_t>(index - Encode(aspect_index, mip_level));
+                        InitialUseRun run = {{aspects[aspect_index], mip_level, layer},
+                                             static_cast<uint32_t>(run_end - index),
+                                             layout,
+                                             initial_layout_state->aspect_mask};
+                        runs.push_back(run);
+                    }
+                    index = run_end;
+                }
+            }
+        }
+    }
+
     VkImageLayout GetSubresourceInitialLayout(const VkImageSubresource subresource) const override {
         if (!InRange(subresource)) return kInvalidLayout;
         uint32_t aspect_index = AspectTraits::Index(subresource.aspectMask);
@@ -753,6 +855,8 @@ class ImageSubresourceLayoutMapImpl : public ImageSubresourceLayoutMap {
         return updated;
     }
 
+    const LayoutMap &GetCurrentLayouts() const { return layouts_.current; }
+
     ImageSubresourceLayoutMapImpl() : Base() {}
     ImageSubresourceLayoutMapImpl(const IMAGE_STATE &image_state)
         : Base(),
@@ -843,7 +947,8 @@ class ImageSubresourceLayoutMapImpl : public ImageSubresourceLayoutMap {
 
     typedef std::vector<std::unique_ptr<InitialLayoutState>> InitialLayoutStates;
     // This map *also* needs "write once" semantics
-    typedef sparse_container::SparseVector<size_t, InitialLayoutState *, false, nullptr, kSparseThreshold> InitialLayoutStateMap;
+    typedef sparse_container::SparseVector<size_t, InitialLayoutState *, false, nullptr, kSparseThreshold, true>
+        InitialLayoutStateMap;
 
     const IMAGE_STATE &image_state_;
     const size_t mip_size_;
@@ -855,6 +960,124 @@ class ImageSubresourceLayoutMapImpl : public ImageSubresourceLayoutMap {
     std::array<size_t, AspectTraits::kAspectCount> aspect_offsets_;
 };
 
+template <typename AspectTraits_, size_t kSparseThreshold = 64U>
+class GlobalImageLayoutMapImpl : public GlobalImageLayoutMap {
+   public:
+    typedef AspectTraits_ AspectTraits;
+    // Must match the command buffer map of the same image for UpdateFrom to be able to merge from it
+    typedef ImageSubresourceLayoutMapImpl<AspectTraits, kSparseThreshold> CommandBufferMap;
+    typedef typename CommandBufferMap::LayoutMap LayoutMap;
+
+    bool SetSubresourceRangeLayout(const VkImageSubresourceRange &range, VkImageLayout layout) override {
+        if (!InRange(range)) return false;  // Don't even try to track bogus subreources
+
+        // Coalesce the mip levels (and aspects) that are contiguous in the encoding, s.t. a whole image transition becomes a
+        // single full range update
+        bool updated = false;
+        size_t run_start = 0;
+        size_t run_end = 0;
+        const auto &aspects = AspectTraits::AspectBits();
+        for (uint32_t aspect_index = 0; aspect_index < AspectTraits::kAspectCount; aspect_index++) {
+            if (0 == (range.aspectMask & aspects[aspect_index])) continue;
+            size_t start = Encode(aspect_index, range.baseMipLevel) + range.baseArrayLayer;
+            for (uint32_t mip_index = 0; mip_index < range.levelCount; ++mip_index, start += mip_size_) {
+                if (start != run_end) {
+                    if (run_end > run_start) updated |= layouts_.SetRange(run_start, run_end, layout);
+                    run_start = start;
+                }
+                run_end = start + range.layerCount;
+            }
+        }
+        if (run_end > run_start) updated |= layouts_.SetRange(run_start, run_end, layout);
+        if (updated) version_ = NextVersion();
+        return updated;
+    }
+
+    VkImageLayout GetSubresourceLayout(const VkImageSubresource &subresource) const override {
+        if (!InRange(subresource)) return kInvalidLayout;
+        const uint32_t aspect_index = AspectTraits::Index(subresource.aspectMask);
+        return layouts_.Get(Encode(aspect_index, subresource.mipLevel) + subresource.arrayLayer);
+    }
+
+    VkImageLayout GetSubresourceLayoutRun(const VkImageSubresource &subresource, uint32_t *layer_count) const override {
+        if (!InRange(subresource)) return kInvalidLayout;
+        const uint32_t aspect_index = AspectTraits::Index(subresource.aspectMask);
+        const size_t index = Encode(aspect_index, subresource.mipLevel) + subresource.arrayLayer;
+        size_t run_end = index + *layer_count;
+        const VkImageLayout layout = layouts_.GetRun(index, &run_end);
+        *layer_count = static_cast<uint32_t>(run_end - index);
+        return layout;
+    }
+
+    void GetLayouts(std::vector<VkImageLayout> &layouts) const override {
+        auto add_layout = [&layouts](VkImageLayout layout) {
+            if ((layout != kInvalidLayout) && (std::find(layouts.cbegin(), layouts.cend(), layout) == layouts.cend())) {
+                layouts.push_back(layout);
+            }
+        };
+        // Visit each run once, rather than each subresource
+        const size_t range_max = layouts_.RangeMax();
+        size_t index = layouts_.RangeMin();
+        while (index < range_max) {
+            size_t run_end = range_max;
+            add_layout(layouts_.GetRun(index, &run_end));
+            index = run_end;
+        }
+    }
+
+    bool UpdateFrom(const ImageSubresourceLayoutMap &other) override {
+        // Must be from matching images for the reinterpret cast to be valid
+        assert(CompatibilityKey() == other.CompatibilityKey());
+        if (CompatibilityKey() != other.CompatibilityKey()) return false;
+
+        const auto &from = reinterpret_cast<const CommandBufferMap &>(other);
+        const bool updated = layouts_.Merge(from.GetCurrentLayouts());
+        if (updated) version_ = NextVersion();
+        return updated;
+    }
+
+    uint64_t Version() const override { return version_; }
+
+    GlobalImageLayoutMapImpl(const IMAGE_STATE &image_state)
+        : GlobalImageLayoutMap(),
+          image_state_(image_state),
+          mip_size_(image_state.full_range.layerCount),
+          aspect_size_(mip_size_ * image_state.full_range.levelCount),
+          layouts_(0, aspect_size_ * AspectTraits::kAspectCount),
+          version_(NextVersion()) {}
+    ~GlobalImageLayoutMapImpl() override {}
+
+   protected:
+    // Matches ImageSubresourceLayoutMapImpl::CompatibilityKey for the same image
+    uintptr_t CompatibilityKey() const {
+        return (reinterpret_cast<const uintptr_t>(&image_state_) ^ AspectTraits::AspectMask() ^ kSparseThreshold);
+    }
+
+    bool InRange(const VkImageSubresource &subres) const {
+        return (subres.mipLevel < image_state_.full_range.levelCount) && (subres.arrayLayer < image_state_.full_range.layerCount) &&
+               (subres.aspectMask & AspectTraits::AspectMask());
+    }
+
+    bool InRange(const VkImageSubresourceRange &range) const {
+        return (range.baseMipLevel < image_state_.full_range.levelCount) &&
+               ((range.baseMipLevel + range.levelCount) <= image_state_.full_range.levelCount) &&
+               (range.baseArrayLayer < image_state_.full_range.layerCount) &&
+               ((range.baseArrayLayer + range.layerCount) <= image_state_.full_range.layerCount) &&
+               (range.aspectMask & AspectTraits::AspectMask());
+    }
+
+    // Same encoding as ImageSubresourceLayoutMapImpl, aspects are laid out back to back
+    inline size_t Encode(uint32_t aspect_index, uint32_t mip_level) const {
+        return aspect_index * aspect_size_ + mip_level * mip_size_;
+    }
+
+    const IMAGE_STATE &image_state_;
+    const size_t mip_size_;
+    const size_t aspect_size_;
+    LayoutMap layouts_;
+    uint64_t version_;
+};
+
 static VkImageLayout NormalizeImageLayout(VkImageLayout layout, VkImageLayout non_normal, VkImageLayout normal) {
     return (layout == non_normal) ? normal : layout;
 }
@@ -990,35 +1213,6 @@ struct DrawData {
     std::vector<BufferBinding> vertex_buffer_bindings;
 };
 
-struct ImageSubresourcePair {
-    VkImage image;
-    bool hasSubresource;
-    VkImageSubresource subresource;
-};
-
-inline bool operator==(const ImageSubresourcePair &img1, const ImageSubresourcePair &img2) {
-    if (img1.image != img2.image || img1.hasSubresource != img2.hasSubresource) return false;
-    return !img1.hasSubresource ||
-           (img1.subresource.aspectMask == img2.subresource.aspectMask && img1.subresource.mipLevel == img2.subresource.mipLevel &&
-            img1.subresource.arrayLayer == img2.subresource.arrayLayer);
-}
-
-namespace std {
-template <>
-struct hash<ImageSubresourcePair> {
-    size_t operator()(ImageSubresourcePair img) const throw() {
-        size_t hashVal = hash<uint64_t>()(reinterpret_cast<uint64_t &>(img.image));
-        hashVal ^= hash<bool>()(img.hasSubresource);
-        if (img.hasSubresource) {
-            hashVal ^= hash<uint32_t>()(reinterpret_cast<uint32_t &>(img.subresource.aspectMask));
-            hashVal ^= hash<uint32_t>()(img.subresource.mipLevel);
-            hashVal ^= hash<uint32_t>()(img.subresource.arrayLayer);
-        }
-        return hashVal;
-    }
-};
-}  // namespace std
-
 // Canonical dictionary for PushConstantRanges
 using PushConstantRangesDict = hash_util::Dictionary<PushConstantRanges>;
 using PushConstantRangesId = PushConstantRangesDict::Id;
@@ -1090,7 +1284,7 @@ class PIPELINE_STATE : public BASE_NODE {
     uint32_t active_shaders;
     uint32_t duplicate_shaders;
     // Capture which slots (set#->bindings) are actually used by the shaders of this pipeline
-    std::unordered_map<uint32_t, std::map<uint32_t, descriptor_req>> active_slots;
+    std::unordered_map<uint32_t, BindingReqMap> active_slots;
     // Vtx input info (if any)
     std::vector<VkVertexInputBindingDescription> vertex_binding_descriptions_;
     std::vector<VkVertexInputAttributeDescription> vertex_attribute_descriptions_;
@@ -1235,6 +1429,31 @@ class PIPELINE_STATE : public BASE_NODE {
 };
 
 // Track last states that are bound per pipeline bind point (Gfx & Compute)
+// What draw-time validation at a bind point depends on, beyond the state of the objects involved
+struct DRAW_STATE_KEY {
+    uint64_t bound_state_generation;     // CMD_BUFFER_STATE::bound_state_generation
+    uint64_t invalidation_count;         // CoreChecks::invalidation_count
+    uint64_t image_layout_change_count;  // CMD_BUFFER_STATE::image_layout_change_count
+    uint64_t descriptor_change_count;    // Sum of the change counts of the bound descriptor sets the pipeline uses
+    const RENDER_PASS_STATE *render_pass;
+    VkFramebuffer framebuffer;
+    uint32_t subpass;
+    CBStatusFlags status;
+    uint32_t viewport_mask;
+    uint32_t scissor_mask;
+    CMD_TYPE cmd_type;
+    bool indexed;
+
+    bool operator==(const DRAW_STATE_KEY &rhs) const {
+        return (bound_state_generation == rhs.bound_state_generation) && (invalidation_count == rhs.invalidation_count) &&
+               (image_layout_change_count == rhs.image_layout_change_count) &&
+               (descriptor_change_count == rhs.descriptor_change_count) && (render_pass == rhs.render_pass) &&
+               (framebuffer == rhs.framebuffer) && (subpass == rhs.subpass) && (status == rhs.status) &&
+               (viewport_mask == rhs.viewport_mask) && (scissor_mask == rhs.scissor_mask) && (cmd_type == rhs.cmd_type) &&
+               (indexed == rhs.indexed);
+    }
+};
+
 struct LAST_BOUND_STATE {
     LAST_BOUND_STATE() { reset(); }  // must define default constructor for portability reasons
     PIPELINE_STATE *pipeline_state;
@@ -1246,6 +1465,9 @@ struct LAST_BOUND_STATE {
     // one dynamic offset per dynamic descriptor bound to this CB
     std::vector<std::vector<uint32_t>> dynamicOffsets;
     std::vector<PipelineLayoutCompatId> compat_id_for_set;
+    // State the last draw or dispatch validated without error against, s.t. repeats of it needn't be validated again
+    DRAW_STATE_KEY validated_draw_state;
+    bool has_validated_draw_state;
 
     void reset() {
         pipeline_state = nullptr;
@@ -1254,6 +1476,7 @@ struct LAST_BOUND_STATE {
         push_descriptor_set = nullptr;
         dynamicOffsets.clear();
         compat_id_for_set.clear();
+        has_validated_draw_state = false;
     }
 };
 
@@ -1387,6 +1610,8 @@ struct QFOTransferCBScoreboards {
 
 // Cmd Buffer Wrapper Struct - TODO : This desperately needs its own class
 struct CMD_BUFFER_STATE : public BASE_NODE {
+    // Serializes vkCmd* validation and recording on this command buffer when concurrent validation is enabled
+    std::mutex command_buffer_lock;
     VkCommandBuffer commandBuffer;
     VkCommandBufferAllocateInfo createInfo = {};
     VkCommandBufferBeginInfo beginInfo;
@@ -1400,6 +1625,7 @@ struct CMD_BUFFER_STATE : public BASE_NODE {
     CBStatusFlags status;                              // Track status of various bindings on cmd buffer
     CBStatusFlags static_status;                       // All state bits provided by current graphics pipeline
                                                        // rather than dynamic state
+    uint64_t bound_state_generation;                   // Bumped by each change to the bound pipelines, sets or vertex buffers
     // Currently storing "lastBound" objects on per-CB basis
     //  long-term may want to create caches of "lastBound" states and could have
     //  each individual CMD_NODE referencing its own "lastBound" state
@@ -1434,9 +1660,22 @@ struct CMD_BUFFER_STATE : public BASE_NODE {
     std::unordered_set<QueryObject> startedQueries;
     typedef std::unordered_map<VkImage, std::unique_ptr<ImageSubresourceLayoutMap>> ImageLayoutMap;
     ImageLayoutMap image_layout_map;
+    // What image_layout_map expects and sets, summarized at vkEndCommandBuffer for the checks at each queue submission
+    struct ImageLayoutSummary {
+        ImageSubresourceLayoutMap::InitialUseRuns initial_uses;
+        uint64_t validated_version = 0;  // Global layout map version the initial uses last matched, 0 if never
+        uint64_t applied_version = 0;    // Global layout map version once the set layouts were last applied, 0 if never
+    };
+    std::unordered_map<VkImage, ImageLayoutSummary> image_layout_summaries;
     std::unordered_map<VkEvent, VkPipelineStageFlags> eventToStageMap;
-    std::vector<DrawData> draw_data;
     DrawData current_draw_data;
+    // Every vertex buffer bound at a draw, added from current_draw_data at the first draw after each vkCmdBindVertexBuffers
+    std::unordered_set<VkBuffer> draw_vertex_buffers;
+    bool current_draw_data_recorded = false;  // Whether draw_vertex_buffers already holds the current_draw_data bindings
+    // Objects whose in_use counts a submission of this CB holds, resolved once at submit s.t. retirement is a plain walk.
+    // Stale once one of the objects may have been destroyed, in which case retirement resolves them again.
+    std::vector<BASE_NODE *> in_use_refs;
+    bool in_use_refs_stale = false;
     bool vertex_buffer_used;  // Track for perf warning to make sure any bound vtx buffer used
     VkCommandBuffer primaryCommandBuffer;
     // Track images and buffers that are updated by this CB at the point of a draw
@@ -1492,11 +1731,6 @@ struct CB_SUBMISSION {
     VkFence fence;
 };
 
-struct IMAGE_LAYOUT_STATE {
-    VkImageLayout layout;
-    VkFormat format;
-};
-
 struct MT_FB_ATTACHMENT_INFO {
     IMAGE_VIEW_STATE *view_state;
     VkImage image;
@@ -1550,5 +1784,6 @@ std::shared_ptr<cvdescriptorset::DescriptorSetLayout const> const GetDescriptorS
 
 ImageSubresourceLayoutMap *GetImageSubresourceLayoutMap(CMD_BUFFER_STATE *cb_state, const IMAGE_STATE &image_state);
 const ImageSubresourceLayoutMap *GetImageSubresourceLayoutMap(const CMD_BUFFER_STATE *cb_state, VkImage image);
+std::unique_ptr<GlobalImageLayoutMap> GlobalImageLayoutMapFactory(const IMAGE_STATE &image_state, VkImageLayout layout);
 
 #endif  // CORE_VALIDATION_TYPES_H_
@@ -593,6 +593,7 @@ cvdescriptorset::DescriptorSet::DescriptorSet(const VkDescriptorSet set, const V
                                               const std::shared_ptr<DescriptorSetLayout const> &layout, uint32_t variable_count,
                                               CoreChecks *dev_data)
     : some_update_(false),
+      change_count_(0),
       set_(set),
       pool_state_(nullptr),
       p_layout_(layout),
@@ -601,7 +602,7 @@ cvdescriptorset::DescriptorSet::DescriptorSet(const VkDescriptorSet set, const V
       variable_count_(variable_count) {
     pool_state_ = dev_data->GetDescriptorPoolState(pool);
     // Foreach binding, create default descriptors of given type
-    descriptors_.reserve(p_layout_->GetTotalDescriptorCount());
+    descriptors_.reserve(p_layout_->GetTotalDescriptorCount(), pool_state_ ? pool_state_->descriptor_arena.get() : nullptr);
     for (uint32_t i = 0; i < p_layout_->GetBindingCount(); ++i) {
         auto type = p_layout_->GetTypeFromIndex(i);
         switch (type) {
@@ -609,10 +610,10 @@ cvdescriptorset::DescriptorSet::DescriptorSet(const VkDescriptorSet set, const V
                 auto immut_sampler = p_layout_->GetImmutableSamplerPtrFromIndex(i);
                 for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di) {
                     if (immut_sampler) {
-                        descriptors_.emplace_back(new SamplerDescriptor(immut_sampler + di));
+                        descriptors_.emplace_back<SamplerDescriptor>(immut_sampler + di);
                         some_update_ = true;  // Immutable samplers are updated at creation
                     } else
-                        descriptors_.emplace_back(new SamplerDescriptor(nullptr));
+                        descriptors_.emplace_back<SamplerDescriptor>(nullptr);
                 }
                 break;
             }
@@ -620,10 +621,10 @@ cvdescriptorset::DescriptorSet::DescriptorSet(const VkDescriptorSet set, const V
                 auto immut = p_layout_->GetImmutableSamplerPtrFromIndex(i);
                 for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di) {
                     if (immut) {
-                        descriptors_.emplace_back(new ImageSamplerDescriptor(immut + di));
+                        descriptors_.emplace_back<ImageSamplerDescriptor>(immut + di);
                         some_update_ = true;  // Immutable samplers are updated at creation
                     } else
-                        descriptors_.emplace_back(new ImageSamplerDescriptor(nullptr));
+                        descriptors_.emplace_back<ImageSamplerDescriptor>(nullptr);
                 }
                 break;
             }
@@ -632,27 +633,27 @@ cvdescriptorset::DescriptorSet::DescriptorSet(const VkDescriptorSet set, const V
             case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
             case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
                 for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di)
-                    descriptors_.emplace_back(new ImageDescriptor(type));
+                    descriptors_.emplace_back<ImageDescriptor>(type);
                 break;
             case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
             case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
                 for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di)
-                    descriptors_.emplace_back(new TexelDescriptor(type));
+                    descriptors_.emplace_back<TexelDescriptor>(type);
                 break;
             case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
             case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
             case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
             case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
                 for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di)
-                    descriptors_.emplace_back(new BufferDescriptor(type));
+                    descriptors_.emplace_back<BufferDescriptor>(type);
                 break;
             case VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT:
                 for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di)
-                    descriptors_.emplace_back(new InlineUniformDescriptor(type));
+                    descriptors_.emplace_back<InlineUniformDescriptor>(type);
                 break;
             case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_NV:
                 for (uint32_t di = 0; di < p_layout_->GetDescriptorCountFromIndex(i); ++di)
-                    descriptors_.emplace_back(new AccelerationStructureDescriptor(type));
+                    descriptors_.emplace_back<AccelerationStructureDescriptor>(type);
                 break;
             default:
                 assert(0);  // Bad descriptor type specified
@@ -698,15 +699,21 @@ static unsigned DescriptorRequirementsBitsFromFormat(VkFormat fmt) {
     return DESCRIPTOR_REQ_COMPONENT_TYPE_FLOAT;
 }
 
+// With a worker pool, bindings with more descriptors than this are validated in tasks of kDrawStateDescriptorsPerTask.
+// Handing a task to a worker costs a wakeup and a merge, which only pays for itself when the task has many descriptors to
+// check, so each task gets 1024. A binding is only split once it fills four tasks, so that a split keeps several workers busy.
+static const uint32_t kParallelDrawStateDescriptors = 4096;
+static const uint32_t kDrawStateDescriptorsPerTask = 1024;
+
 // Validate that the state of this set is appropriate for the given bindings and dynamic_offsets at Draw time
 //  This includes validating that all descriptors in the given bindings are updated,
 //  that any update buffers are valid, and that any dynamic offsets are within the bounds of their buffers.
 // Return true if state is acceptable, or false and write an error message into error string
-bool cvdescriptorset::DescriptorSet::ValidateDrawState(const std::map<uint32_t, descriptor_req> &bindings,
+bool cvdescriptorset::DescriptorSet::ValidateDrawState(const BindingReqMap &bindings,
                                                        const std::vector<uint32_t> &dynamic_offsets, CMD_BUFFER_STATE *cb_node,
                                                        const char *caller, std::string *error) const {
-    for (auto binding_pair : bindings) {
-        auto binding = binding_pair.first;
+    for (const auto &binding_pair : bindings) {
+        const auto binding = binding_pair.first;
         if (!p_layout_->HasBinding(binding)) {
             std::stringstream error_str;
             error_str << "Attempting to validate DrawState for binding #" << binding
@@ -714,216 +721,291 @@ bool cvdescriptorset::DescriptorSet::ValidateDrawState(const std::map<uint32_t,
             *error = error_str.str();
             return false;
         }
+        if (p_layout_->GetDescriptorBindingFlagsFromBinding(binding) &
+            (VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT)) {
+            // Can't validate the descriptors because they may not have been updated,
+            // or the views could have been destroyed
+            continue;
+        }
         IndexRange index_range = p_layout_->GetGlobalIndexRangeFromBinding(binding);
-        auto array_idx = 0;  // Track array idx if we're dealing with array descriptors
-
         if (IsVariableDescriptorCount(binding)) {
             // Only validate the first N descriptors if it uses variable_count
             index_range.end = index_range.start + GetVariableDescriptorCount();
         }
 
-        for (uint32_t i = index_range.start; i < index_range.end; ++i, ++array_idx) {
-            uint32_t index = i - index_range.start;
-
-            if ((p_layout_->GetDescriptorBindingFlagsFromBinding(binding) &
-                 (VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT)) ||
-                descriptors_[i]->GetClass() == InlineUniform) {
-                // Can't validate the descriptor because it may not have been updated,
-                // or the view could have been destroyed
-                continue;
-            } else if (!descriptors_[i]->updated) {
-                std::stringstream error_str;
-                error_str << "Descriptor in binding #" << binding << " index " << index
-                          << " is being used in draw but has not been updated.";
-                *error = error_str.str();
+        WorkerPool *worker_pool = device_data_->descriptor_worker_pool.get();
+        if (worker_pool && ((index_range.end - index_range.start) > kParallelDrawStateDescriptors)) {
+            if (!ValidateDrawStateDescriptors(worker_pool, binding_pair, index_range, dynamic_offsets, cb_node, caller, error)) {
                 return false;
+            }
+        } else {
+            for (uint32_t i = index_range.start; i < index_range.end; ++i) {
+                if (!ValidateDrawStateDescriptor(binding_pair, i - index_range.start, i, dynamic_offsets, cb_node, caller, false,
+                                                 error)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Split the descriptors of one binding across the worker pool. Each task checks its slice of the binding without reporting,
+// stopping at its first error and noting the last descriptor that only left a message. The descriptor a serial loop would
+// have stopped at, or taken the message from, is then checked again with reporting, so the errors match a serial check.
+bool cvdescriptorset::DescriptorSet::ValidateDrawStateDescriptors(WorkerPool *worker_pool,
+                                                                  const BindingReqMap::value_type &binding_pair,
+                                                                  const IndexRange &index_range,
+                                                                  const std::vector<uint32_t> &dynamic_offsets,
+                                                                  CMD_BUFFER_STATE *cb_node, const char *caller,
+                                                                  std::string *error) const {
+    static const uint32_t kNoDescriptor = UINT32_MAX;
+    struct SliceResult {
+        uint32_t first_error;
+        uint32_t last_message;
+    };
+    const uint32_t count = index_range.end - index_range.start;
+    const uint32_t task_count = (count + kDrawStateDescriptorsPerTask - 1) / kDrawStateDescriptorsPerTask;
+    std::vector<SliceResult> results(task_count, SliceResult{kNoDescriptor, kNoDescriptor});
+    worker_pool->Run(task_count, [&](uint32_t task) {
+        const uint32_t begin = task * kDrawStateDescriptorsPerTask;
+        const uint32_t end = std::min(begin + kDrawStateDescriptorsPerTask, count);
+        std::string slice_error;
+        for (uint32_t index = begin; index < end; ++index) {
+            if (!ValidateDrawStateDescriptor(binding_pair, index, index_range.start + index, dynamic_offsets, cb_node, caller, true,
+                                             &slice_error)) {
+                results[task].first_error = index;
+                return;
+            }
+            if (!slice_error.empty()) {
+                results[task].last_message = index;
+                slice_error.clear();
+            }
+        }
+    });
+
+    uint32_t last_message = kNoDescriptor;
+    for (const auto &result : results) {
+        if (result.first_error != kNoDescriptor) {
+            return ValidateDrawStateDescriptor(binding_pair, result.first_error, index_range.start + result.first_error,
+                                               dynamic_offsets, cb_node, caller, false, error);
+        }
+        if (result.last_message != kNoDescriptor) last_message = result.last_message;
+    }
+    if (last_message != kNoDescriptor) {
+        ValidateDrawStateDescriptor(binding_pair, last_message, index_range.start + last_message, dynamic_offsets, cb_node,
+                                    caller, false, error);
+    }
+    return true;
+}
+
+// Validate descriptor index of the given binding, at global_index in the set, at draw time. Returns false and writes the error
+// into error string on failure. A quiet check doesn't report image layout mismatches to the debug callback, so that it can
+// run on worker threads.
+bool cvdescriptorset::DescriptorSet::ValidateDrawStateDescriptor(const BindingReqMap::value_type &binding_pair, uint32_t index,
+                                                                 uint32_t global_index,
+                                                                 const std::vector<uint32_t> &dynamic_offsets,
+                                                                 CMD_BUFFER_STATE *cb_node, const char *caller, bool quiet,
+                                                                 std::string *error) const {
+    const auto binding = binding_pair.first;
+    auto descriptor = descriptors_[global_index];
+    auto descriptor_class = descriptor->GetClass();
+    if (descriptor_class == InlineUniform) {
+        // Can't validate the descriptor because it may not have been updated
+        return true;
+    } else if (!descriptor->updated) {
+        std::stringstream error_str;
+        error_str << "Descriptor in binding #" << binding << " index " << index
+                  << " is being used in draw but has not been updated.";
+        *error = error_str.str();
+        return false;
+    }
+    if (descriptor_class == GeneralBuffer) {
+        // Verify that buffers are valid
+        auto buffer = static_cast<BufferDescriptor *>(descriptor)->GetBuffer();
+        auto buffer_node = device_data_->GetBufferState(buffer);
+        if (!buffer_node) {
+            std::stringstream error_str;
+            error_str << "Descriptor in binding #" << binding << " index " << index << " references invalid buffer "
+                      << buffer << ".";
+            *error = error_str.str();
+            return false;
+        } else if (!buffer_node->sparse) {
+            for (auto mem_binding : buffer_node->GetBoundMemory()) {
+                if (!device_data_->GetDevMemState(mem_binding)) {
+                    std::stringstream error_str;
+                    error_str << "Descriptor in binding #" << binding << " index " << index << " uses buffer " << buffer
+                              << " that references invalid memory " << mem_binding << ".";
+                    *error = error_str.str();
+                    return false;
+                }
+            }
+        }
+        if (descriptor->IsDynamic()) {
+            // Validate that dynamic offsets are within the buffer
+            auto buffer_size = buffer_node->createInfo.size;
+            auto range = static_cast<BufferDescriptor *>(descriptor)->GetRange();
+            auto desc_offset = static_cast<BufferDescriptor *>(descriptor)->GetOffset();
+            auto dyn_offset = dynamic_offsets[GetDynamicOffsetIndexFromBinding(binding) + index];
+            if (VK_WHOLE_SIZE == range) {
+                if ((dyn_offset + desc_offset) > buffer_size) {
+                    std::stringstream error_str;
+                    error_str << "Dynamic descriptor in binding #" << binding << " index " << index << " uses buffer "
+                              << buffer << " with update range of VK_WHOLE_SIZE has dynamic offset " << dyn_offset
+                              << " combined with offset " << desc_offset << " that oversteps the buffer size of "
+                              << buffer_size << ".";
+                    *error = error_str.str();
+                    return false;
+                }
             } else {
-                auto descriptor_class = descriptors_[i]->GetClass();
-                if (descriptor_class == GeneralBuffer) {
-                    // Verify that buffers are valid
-                    auto buffer = static_cast<BufferDescriptor *>(descriptors_[i].get())->GetBuffer();
-                    auto buffer_node = device_data_->GetBufferState(buffer);
-                    if (!buffer_node) {
-                        std::stringstream error_str;
-                        error_str << "Descriptor in binding #" << binding << " index " << index << " references invalid buffer "
-                                  << buffer << ".";
-                        *error = error_str.str();
-                        return false;
-                    } else if (!buffer_node->sparse) {
-                        for (auto mem_binding : buffer_node->GetBoundMemory()) {
-                            if (!device_data_->GetDevMemState(mem_binding)) {
-                                std::stringstream error_str;
-                                error_str << "Descriptor in binding #" << binding << " index " << index << " uses buffer " << buffer
-                                          << " that references invalid memory " << mem_binding << ".";
-                                *error = error_str.str();
-                                return false;
-                            }
-                        }
-                    }
-                    if (descriptors_[i]->IsDynamic()) {
-                        // Validate that dynamic offsets are within the buffer
-                        auto buffer_size = buffer_node->createInfo.size;
-                        auto range = static_cast<BufferDescriptor *>(descriptors_[i].get())->GetRange();
-                        auto desc_offset = static_cast<BufferDescriptor *>(descriptors_[i].get())->GetOffset();
-                        auto dyn_offset = dynamic_offsets[GetDynamicOffsetIndexFromBinding(binding) + array_idx];
-                        if (VK_WHOLE_SIZE == range) {
-                            if ((dyn_offset + desc_offset) > buffer_size) {
-                                std::stringstream error_str;
-                                error_str << "Dynamic descriptor in binding #" << binding << " index " << index << " uses buffer "
-                                          << buffer << " with update range of VK_WHOLE_SIZE has dynamic offset " << dyn_offset
-                                          << " combined with offset " << desc_offset << " that oversteps the buffer size of "
-                                          << buffer_size << ".";
-                                *error = error_str.str();
-                                return false;
-                            }
-                        } else {
-                            if ((dyn_offset + desc_offset + range) > buffer_size) {
-                                std::stringstream error_str;
-                                error_str << "Dynamic descriptor in binding #" << binding << " index " << index << " uses buffer "
-                                          << buffer << " with dynamic offset " << dyn_offset << " combined with offset "
-                                          << desc_offset << " and range " << range << " that oversteps the buffer size of "
-                                          << buffer_size << ".";
-                                *error = error_str.str();
-                                return false;
-                            }
-                        }
-                    }
-                } else if (descriptor_class == ImageSampler || descriptor_class == Image) {
-                    VkImageView image_view;
-                    VkImageLayout image_layout;
-                    if (descriptor_class == ImageSampler) {
-                        image_view = static_cast<ImageSamplerDescriptor *>(descriptors_[i].get())->GetImageView();
-                        image_layout = static_cast<ImageSamplerDescriptor *>(descriptors_[i].get())->GetImageLayout();
-                    } else {
-                        image_view = static_cast<ImageDescriptor *>(descriptors_[i].get())->GetImageView();
-                        image_layout = static_cast<ImageDescriptor *>(descriptors_[i].get())->GetImageLayout();
-                    }
-                    auto reqs = binding_pair.second;
+                if ((dyn_offset + desc_offset + range) > buffer_size) {
+                    std::stringstream error_str;
+                    error_str << "Dynamic descriptor in binding #" << binding << " index " << index << " uses buffer "
+                              << buffer << " with dynamic offset " << dyn_offset << " combined with offset "
+                              << desc_offset << " and range " << range << " that oversteps the buffer size of "
+                              << buffer_size << ".";
+                    *error = error_str.str();
+                    return false;
+                }
+            }
+        }
+    } else if (descriptor_class == ImageSampler || descriptor_class == Image) {
+        VkImageView image_view;
+        VkImageLayout image_layout;
+        if (descriptor_class == ImageSampler) {
+            image_view = static_cast<ImageSamplerDescriptor *>(descriptor)->GetImageView();
+            image_layout = static_cast<ImageSamplerDescriptor *>(descriptor)->GetImageLayout();
+        } else {
+            image_view = static_cast<ImageDescriptor *>(descriptor)->GetImageView();
+            image_layout = static_cast<ImageDescriptor *>(descriptor)->GetImageLayout();
+        }
+        auto reqs = binding_pair.second;
 
-                    auto image_view_state = device_data_->GetImageViewState(image_view);
-                    if (nullptr == image_view_state) {
-                        // Image view must have been destroyed since initial update. Could potentially flag the descriptor
-                        //  as "invalid" (updated = false) at DestroyImageView() time and detect this error at bind time
-                        std::stringstream error_str;
-                        error_str << "Descriptor in binding #" << binding << " index " << index << " is using imageView "
-                                  << image_view << " that has been destroyed.";
-                        *error = error_str.str();
-                        return false;
-                    }
-                    auto image_view_ci = image_view_state->create_info;
+        auto image_view_state = device_data_->GetImageViewState(image_view);
+        if (nullptr == image_view_state) {
+            // Image view must have been destroyed since initial update. Could potentially flag the descriptor
+            //  as "invalid" (updated = false) at DestroyImageView() time and detect this error at bind time
+            std::stringstream error_str;
+            error_str << "Descriptor in binding #" << binding << " index " << index << " is using imageView "
+                      << image_view << " that has been destroyed.";
+            *error = error_str.str();
+            return false;
+        }
+        auto image_view_ci = image_view_state->create_info;
 
-                    if ((reqs & DESCRIPTOR_REQ_ALL_VIEW_TYPE_BITS) && (~reqs & (1 << image_view_ci.viewType))) {
-                        // bad view type
-                        std::stringstream error_str;
-                        error_str << "Descriptor in binding #" << binding << " index " << index
-                                  << " requires an image view of type " << StringDescriptorReqViewType(reqs) << " but got "
-                                  << string_VkImageViewType(image_view_ci.viewType) << ".";
-                        *error = error_str.str();
-                        return false;
-                    }
+        if ((reqs & DESCRIPTOR_REQ_ALL_VIEW_TYPE_BITS) && (~reqs & (1 << image_view_ci.viewType))) {
+            // bad view type
+            std::stringstream error_str;
+            error_str << "Descriptor in binding #" << binding << " index " << index
+                      << " requires an image view of type " << StringDescriptorReqViewType(reqs) << " but got "
+                      << string_VkImageViewType(image_view_ci.viewType) << ".";
+            *error = error_str.str();
+            return false;
+        }
 
-                    auto format_bits = DescriptorRequirementsBitsFromFormat(image_view_ci.format);
-                    if (!(reqs & format_bits)) {
-                        // bad component type
-                        std::stringstream error_str;
-                        error_str << "Descriptor in binding #" << binding << " index " << index << " requires "
-                                  << StringDescriptorReqComponentType(reqs) << " component type, but bound descriptor format is "
-                                  << string_VkFormat(image_view_ci.format) << ".";
-                        *error = error_str.str();
-                        return false;
-                    }
+        auto format_bits = DescriptorRequirementsBitsFromFormat(image_view_ci.format);
+        if (!(reqs & format_bits)) {
+            // bad component type
+            std::stringstream error_str;
+            error_str << "Descriptor in binding #" << binding << " index " << index << " requires "
+                      << StringDescriptorReqComponentType(reqs) << " component type, but bound descriptor format is "
+                      << string_VkFormat(image_view_ci.format) << ".";
+            *error = error_str.str();
+            return false;
+        }
 
-                    auto image_node = device_data_->GetImageState(image_view_ci.image);
-                    assert(image_node);
-                    // Verify Image Layout
-                    // No "invalid layout" VUID required for this call, since the optimal_layout parameter is UNDEFINED.
-                    bool hit_error = false;
-                    device_data_->VerifyImageLayout(cb_node, image_node, image_view_state->normalized_subresource_range,
-                                                    image_view_ci.subresourceRange.aspectMask, image_layout,
-                                                    VK_IMAGE_LAYOUT_UNDEFINED, caller, kVUIDUndefined,
-                                                    "VUID-VkDescriptorImageInfo-imageLayout-00344", &hit_error);
-                    if (hit_error) {
-                        *error =
-                            "Image layout specified at vkUpdateDescriptorSet* or vkCmdPushDescriptorSet* time "
-                            "doesn't match actual image layout at time descriptor is used. See previous error callback for "
-                            "specific details.";
-                        return false;
-                    }
+        auto image_node = device_data_->GetImageState(image_view_ci.image);
+        assert(image_node);
+        // Verify Image Layout
+        // No "invalid layout" VUID required for this call, since the optimal_layout parameter is UNDEFINED.
+        bool hit_error = false;
+        if (quiet) {
+            hit_error = !device_data_->ImageLayoutMatchesUse(cb_node, image_node, image_view_state->normalized_subresource_range,
+                                                             image_view_ci.subresourceRange.aspectMask, image_layout);
+        } else {
+            device_data_->VerifyImageLayout(cb_node, image_node, image_view_state->normalized_subresource_range,
+                                            image_view_ci.subresourceRange.aspectMask, image_layout, VK_IMAGE_LAYOUT_UNDEFINED,
+                                            caller, kVUIDUndefined, "VUID-VkDescriptorImageInfo-imageLayout-00344", &hit_error);
+        }
+        if (hit_error) {
+            *error =
+                "Image layout specified at vkUpdateDescriptorSet* or vkCmdPushDescriptorSet* time "
+                "doesn't match actual image layout at time descriptor is used. See previous error callback for "
+                "specific details.";
+            return false;
+        }
 
-                    // Verify Sample counts
-                    if ((reqs & DESCRIPTOR_REQ_SINGLE_SAMPLE) && image_node->createInfo.samples != VK_SAMPLE_COUNT_1_BIT) {
-                        std::stringstream error_str;
-                        error_str << "Descriptor in binding #" << binding << " index " << index
-                                  << " requires bound image to have VK_SAMPLE_COUNT_1_BIT but got "
-                                  << string_VkSampleCountFlagBits(image_node->createInfo.samples) << ".";
-                        *error = error_str.str();
-                        return false;
-                    }
-                    if ((reqs & DESCRIPTOR_REQ_MULTI_SAMPLE) && image_node->createInfo.samples == VK_SAMPLE_COUNT_1_BIT) {
-                        std::stringstream error_str;
-                        error_str << "Descriptor in binding #" << binding << " index " << index
-                                  << " requires bound image to have multiple samples, but got VK_SAMPLE_COUNT_1_BIT.";
-                        *error = error_str.str();
-                        return false;
-                    }
-                } else if (descriptor_class == TexelBuffer) {
-                    auto texel_buffer = static_cast<TexelDescriptor *>(descriptors_[i].get());
-                    auto buffer_view = device_data_->GetBufferViewState(texel_buffer->GetBufferView());
+        // Verify Sample counts
+        if ((reqs & DESCRIPTOR_REQ_SINGLE_SAMPLE) && image_node->createInfo.samples != VK_SAMPLE_COUNT_1_BIT) {
+            std::stringstream error_str;
+            error_str << "Descriptor in binding #" << binding << " index " << index
+                      << " requires bound image to have VK_SAMPLE_COUNT_1_BIT but got "
+                      << string_VkSampleCountFlagBits(image_node->createInfo.samples) << ".";
+            *error = error_str.str();
+            return false;
+        }
+        if ((reqs & DESCRIPTOR_REQ_MULTI_SAMPLE) && image_node->createInfo.samples == VK_SAMPLE_COUNT_1_BIT) {
+            std::stringstream error_str;
+            error_str << "Descriptor in binding #" << binding << " index " << index
+                      << " requires bound image to have multiple samples, but got VK_SAMPLE_COUNT_1_BIT.";
+            *error = error_str.str();
+            return false;
+        }
+    } else if (descriptor_class == TexelBuffer) {
+        auto texel_buffer = static_cast<TexelDescriptor *>(descriptor);
+        auto buffer_view = device_data_->GetBufferViewState(texel_buffer->GetBufferView());
 
-                    if (nullptr == buffer_view) {
-                        std::stringstream error_str;
-                        error_str << "Descriptor in binding #" << binding << " index " << index << " is using bufferView "
-                                  << buffer_view << " that has been destroyed.";
-                        *error = error_str.str();
-                        return false;
-                    }
-                    auto buffer = buffer_view->create_info.buffer;
-                    auto buffer_state = device_data_->GetBufferState(buffer);
-                    if (!buffer_state) {
-                        std::stringstream error_str;
-                        error_str << "Descriptor in binding #" << binding << " index " << index << " is using buffer "
-                                  << buffer_state << " that has been destroyed.";
-                        *error = error_str.str();
-                        return false;
-                    }
-                    auto reqs = binding_pair.second;
-                    auto format_bits = DescriptorRequirementsBitsFromFormat(buffer_view->create_info.format);
+        if (nullptr == buffer_view) {
+            std::stringstream error_str;
+            error_str << "Descriptor in binding #" << binding << " index " << index << " is using bufferView "
+                      << buffer_view << " that has been destroyed.";
+            *error = error_str.str();
+            return false;
+        }
+        auto buffer = buffer_view->create_info.buffer;
+        auto buffer_state = device_data_->GetBufferState(buffer);
+        if (!buffer_state) {
+            std::stringstream error_str;
+            error_str << "Descriptor in binding #" << binding << " index " << index << " is using buffer "
+                      << buffer_state << " that has been destroyed.";
+            *error = error_str.str();
+            return false;
+        }
+        auto reqs = binding_pair.second;
+        auto format_bits = DescriptorRequirementsBitsFromFormat(buffer_view->create_info.format);
 
-                    if (!(reqs & format_bits)) {
-                        // bad component type
-                        std::stringstream error_str;
-                        error_str << "Descriptor in binding #" << binding << " index " << index << " requires "
-                                  << StringDescriptorReqComponentType(reqs) << " component type, but bound descriptor format is "
-                                  << string_VkFormat(buffer_view->create_info.format) << ".";
-                        *error = error_str.str();
-                        return false;
-                    }
-                }
-                if (descriptor_class == ImageSampler || descriptor_class == PlainSampler) {
-                    // Verify Sampler still valid
-                    VkSampler sampler;
-                    if (descriptor_class == ImageSampler) {
-                        sampler = static_cast<ImageSamplerDescriptor *>(descriptors_[i].get())->GetSampler();
-                    } else {
-                        sampler = static_cast<SamplerDescriptor *>(descriptors_[i].get())->GetSampler();
-                    }
-                    if (!ValidateSampler(sampler, device_data_)) {
-                        std::stringstream error_str;
-                        error_str << "Descriptor in binding #" << binding << " index " << index << " is using sampler " << sampler
-                                  << " that has been destroyed.";
-                        *error = error_str.str();
-                        return false;
-                    } else {
-                        SAMPLER_STATE *sampler_state = device_data_->GetSamplerState(sampler);
-                        if (sampler_state->samplerConversion && !descriptors_[i].get()->IsImmutableSampler()) {
-                            std::stringstream error_str;
-                            error_str << "sampler (" << sampler << ") in the descriptor set (" << set_
-                                      << ") contains a YCBCR conversion (" << sampler_state->samplerConversion
-                                      << ") , then the sampler MUST also exists as an immutable sampler.";
-                            *error = error_str.str();
-                        }
-                    }
-                }
+        if (!(reqs & format_bits)) {
+            // bad component type
+            std::stringstream error_str;
+            error_str << "Descriptor in binding #" << binding << " index " << index << " requires "
+                      << StringDescriptorReqComponentType(reqs) << " component type, but bound descriptor format is "
+                      << string_VkFormat(buffer_view->create_info.format) << ".";
+            *error = error_str.str();
+            return false;
+        }
+    }
+    if (descriptor_class == ImageSampler || descriptor_class == PlainSampler) {
+        // Verify Sampler still valid
+        VkSampler sampler;
+        if (descriptor_class == ImageSampler) {
+            sampler = static_cast<ImageSamplerDescriptor *>(descriptor)->GetSampler();
+        } else {
+            sampler = static_cast<SamplerDescriptor *>(descriptor)->GetSampler();
+        }
+        if (!ValidateSampler(sampler, device_data_)) {
+            std::stringstream error_str;
+            error_str << "Descriptor in binding #" << binding << " index " << index << " is using sampler " << sampler
+                      << " that has been destroyed.";
+            *error = error_str.str();
+            return false;
+        } else {
+            SAMPLER_STATE *sampler_state = device_data_->GetSamplerState(sampler);
+            if (sampler_state->samplerConversion && !descriptor->IsImmutableSampler()) {
+                std::stringstream error_str;
+                error_str << "sampler (" << sampler << ") in the descriptor set (" << set_
+                          << ") contains a YCBCR conversion (" << sampler_state->samplerConversion
+                          << ") , then the sampler MUST also exists as an immutable sampler.";
+                *error = error_str.str();
             }
         }
     }
@@ -931,7 +1013,7 @@ bool cvdescriptorset::DescriptorSet::ValidateDrawState(const std::map<uint32_t,
 }
 
 // For given bindings, place any update buffers or images into the passed-in unordered_sets
-uint32_t cvdescriptorset::DescriptorSet::GetStorageUpdates(const std::map<uint32_t, descriptor_req> &bindings,
+uint32_t cvdescriptorset::DescriptorSet::GetStorageUpdates(const BindingReqMap &bindings,
                                                            std::unordered_set<VkBuffer> *buffer_set,
                                                            std::unordered_set<VkImageView> *image_set) const {
     auto num_updates = 0;
@@ -946,14 +1028,14 @@ uint32_t cvdescriptorset::DescriptorSet::GetStorageUpdates(const std::map<uint32
             if (Image == descriptors_[start_idx]->descriptor_class) {
                 for (uint32_t i = 0; i < p_layout_->GetDescriptorCountFromBinding(binding); ++i) {
                     if (descriptors_[start_idx + i]->updated) {
-                        image_set->insert(static_cast<ImageDescriptor *>(descriptors_[start_idx + i].get())->GetImageView());
+                        image_set->insert(static_cast<ImageDescriptor *>(descriptors_[start_idx + i])->GetImageView());
                         num_updates++;
                     }
                 }
             } else if (TexelBuffer == descriptors_[start_idx]->descriptor_class) {
                 for (uint32_t i = 0; i < p_layout_->GetDescriptorCountFromBinding(binding); ++i) {
                     if (descriptors_[start_idx + i]->updated) {
-                        auto bufferview = static_cast<TexelDescriptor *>(descriptors_[start_idx + i].get())->GetBufferView();
+                        auto bufferview = static_cast<TexelDescriptor *>(descriptors_[start_idx + i])->GetBufferView();
                         auto bv_state = device_data_->GetBufferViewState(bufferview);
                         if (bv_state) {
                             buffer_set->insert(bv_state->create_info.buffer);
@@ -964,7 +1046,7 @@ uint32_t cvdescriptorset::DescriptorSet::GetStorageUpdates(const std::map<uint32
             } else if (GeneralBuffer == descriptors_[start_idx]->descriptor_class) {
                 for (uint32_t i = 0; i < p_layout_->GetDescriptorCountFromBinding(binding); ++i) {
                     if (descriptors_[start_idx + i]->updated) {
-                        buffer_set->insert(static_cast<BufferDescriptor *>(descriptors_[start_idx + i].get())->GetBuffer());
+                        buffer_set->insert(static_cast<BufferDescriptor *>(descriptors_[start_idx + i])->GetBuffer());
                         num_updates++;
                     }
                 }
@@ -998,7 +1080,10 @@ void cvdescriptorset::DescriptorSet::PerformWriteUpdate(const VkWriteDescriptorS
         auto global_idx = p_layout_->GetGlobalIndexRangeFromBinding(binding_being_updated).start + offset;
         // Loop over the updates for a single binding at a time
         for (uint32_t di = 0; di < update_count; ++di, ++update_index) {
-            descriptors_[global_idx + di]->WriteUpdate(update, update_index);
+            auto descriptor = descriptors_[global_idx + di];
+            // Contents validated for an earlier write stay valid if this write doesn't change them
+            if (!descriptor->MatchesWriteUpdate(update, update_index)) descriptor->validated_epoch = 0;
+            descriptor->WriteUpdate(update, update_index);
         }
         // Roll over to next binding in case of consecutive update
         descriptors_remaining -= update_count;
@@ -1006,6 +1091,7 @@ void cvdescriptorset::DescriptorSet::PerformWriteUpdate(const VkWriteDescriptorS
         binding_being_updated++;
     }
     if (update->descriptorCount) some_update_ = true;
+    ++change_count_;
 
     if (!(p_layout_->GetDescriptorBindingFlagsFromBinding(update->dstBinding) &
           (VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT))) {
@@ -1212,8 +1298,9 @@ void cvdescriptorset::DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet
     auto dst_start_idx = p_layout_->GetGlobalIndexRangeFromBinding(update->dstBinding).start + update->dstArrayElement;
     // Update parameters all look good so perform update
     for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-        auto src = src_set->descriptors_[src_start_idx + di].get();
-        auto dst = descriptors_[dst_start_idx + di].get();
+        auto src = src_set->descriptors_[src_start_idx + di];
+        auto dst = descriptors_[dst_start_idx + di];
+        dst->validated_epoch = 0;
         if (src->updated) {
             dst->CopyUpdate(src);
             some_update_ = true;
@@ -1221,6 +1308,7 @@ void cvdescriptorset::DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet
             dst->updated = false;
         }
     }
+    ++change_count_;
 
     if (!(p_layout_->GetDescriptorBindingFlagsFromBinding(update->dstBinding) &
           (VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT))) {
@@ -1236,12 +1324,12 @@ void cvdescriptorset::DescriptorSet::PerformCopyUpdate(const VkCopyDescriptorSet
 // Prereq: This should be called for a set that has been confirmed to be active for the given cb_node, meaning it's going
 //   to be used in a draw by the given cb_node
 void cvdescriptorset::DescriptorSet::UpdateDrawState(CoreChecks *device_data, CMD_BUFFER_STATE *cb_node,
-                                                     const std::map<uint32_t, descriptor_req> &binding_req_map) {
+                                                     const BindingReqMap &binding_req_map) {
     // bind cb to this descriptor set
-    cb_bindings.insert(cb_node);
+    AddCbBinding(cb_node);
     // Add bindings for descriptor set, the set's pool, and individual objects in the set
     cb_node->object_bindings.emplace(set_, kVulkanObjectTypeDescriptorSet);
-    pool_state_->cb_bindings.insert(cb_node);
+    pool_state_->AddCbBinding(cb_node);
     cb_node->object_bindings.emplace(pool_state_->pool, kVulkanObjectTypeDescriptorPool);
     // For the active slots, use set# to look up descriptorSet from boundDescriptorSets, and bind all of that descriptor set's
     // resources
@@ -1259,72 +1347,59 @@ void cvdescriptorset::DescriptorSet::UpdateDrawState(CoreChecks *device_data, CM
     }
 }
 
-void cvdescriptorset::DescriptorSet::FilterAndTrackOneBindingReq(const BindingReqMap::value_type &binding_req_pair,
-                                                                 const BindingReqMap &in_req, BindingReqMap *out_req,
-                                                                 TrackedBindings *bindings) {
-    assert(out_req);
-    assert(bindings);
-    const auto binding = binding_req_pair.first;
-    // Use insert and look at the boolean ("was inserted") in the returned pair to see if this is a new set member.
-    // Saves one hash lookup vs. find ... compare w/ end ... insert.
-    const auto it_bool_pair = bindings->insert(binding);
-    if (it_bool_pair.second) {
-        out_req->emplace(binding_req_pair);
+const BindingReqMap &cvdescriptorset::DescriptorSet::FilterAndTrackBindingReqs(CMD_BUFFER_STATE *cb_state,
+                                                                             const BindingReqMap &in_req) {
+    auto &validated = GetCachedValidation(cb_state);
+    auto &out_req = validated.filtered_reqs;
+    out_req.clear();
+    TrackedBindings &bound = validated.command_binding_and_usage;
+    if (bound.Count() == GetBindingCount()) {
+        return out_req;  // All bindings are bound, out req is empty
     }
+    bound.Reserve(GetBindingCount());
+    // If a binding doesn't exist, or has already been bound, skip it
+    ForEachBindingReqIndex(in_req, [&bound, &out_req](uint32_t index, const BindingReqMap::value_type &binding_req_pair) {
+        if (bound.Insert(index)) out_req.emplace_back(binding_req_pair);
+    });
+    return out_req;
 }
 
-void cvdescriptorset::DescriptorSet::FilterAndTrackOneBindingReq(const BindingReqMap::value_type &binding_req_pair,
-                                                                 const BindingReqMap &in_req, BindingReqMap *out_req,
-                                                                 TrackedBindings *bindings, uint32_t limit) {
-    if (bindings->size() < limit) FilterAndTrackOneBindingReq(binding_req_pair, in_req, out_req, bindings);
-}
-
-void cvdescriptorset::DescriptorSet::FilterAndTrackBindingReqs(CMD_BUFFER_STATE *cb_state, const BindingReqMap &in_req,
-                                                               BindingReqMap *out_req) {
-    TrackedBindings &bound = cached_validation_[cb_state].command_binding_and_usage;
-    if (bound.size() == GetBindingCount()) {
-        return;  // All bindings are bound, out req is empty
-    }
-    for (const auto &binding_req_pair : in_req) {
-        const auto binding = binding_req_pair.first;
-        // If a binding doesn't exist, or has already been bound, skip it
-        if (p_layout_->HasBinding(binding)) {
-            FilterAndTrackOneBindingReq(binding_req_pair, in_req, out_req, &bound);
-        }
-    }
-}
-
-void cvdescriptorset::DescriptorSet::FilterAndTrackBindingReqs(CMD_BUFFER_STATE *cb_state, PIPELINE_STATE *pipeline,
-                                                               const BindingReqMap &in_req, BindingReqMap *out_req) {
-    auto &validated = cached_validation_[cb_state];
+const BindingReqMap &cvdescriptorset::DescriptorSet::FilterAndTrackBindingReqs(CMD_BUFFER_STATE *cb_state, PIPELINE_STATE *pipeline,
+                                                                             const BindingReqMap &in_req) {
+    auto &validated = GetCachedValidation(cb_state);
+    auto &out_req = validated.filtered_reqs;
+    out_req.clear();
     auto &image_sample_val = validated.image_samplers[pipeline];
-    auto *const dynamic_buffers = &validated.dynamic_buffers;
-    auto *const non_dynamic_buffers = &validated.non_dynamic_buffers;
+    // Zero initialized, s.t. new entries are dirty as the CB's image layout change count starts at 1
+    image_sample_val.resize(GetBindingCount(), 0);
+    auto &dynamic_buffers = validated.dynamic_buffers;
+    auto &non_dynamic_buffers = validated.non_dynamic_buffers;
+    dynamic_buffers.Reserve(GetBindingCount());
+    non_dynamic_buffers.Reserve(GetBindingCount());
     const auto &stats = p_layout_->GetBindingTypeStats();
-    for (const auto &binding_req_pair : in_req) {
-        auto binding = binding_req_pair.first;
-        VkDescriptorSetLayoutBinding const *layout_binding = p_layout_->GetDescriptorSetLayoutBindingPtrFromBinding(binding);
-        if (!layout_binding) {
-            continue;
-        }
+    ForEachBindingReqIndex(in_req, [&](uint32_t index, const BindingReqMap::value_type &binding_req_pair) {
+        const auto type = p_layout_->GetTypeFromIndex(index);
         // Caching criteria differs per type.
         // If image_layout have changed , the image descriptors need to be validated against them.
-        if ((layout_binding->descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) ||
-            (layout_binding->descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)) {
-            FilterAndTrackOneBindingReq(binding_req_pair, in_req, out_req, dynamic_buffers, stats.dynamic_buffer_count);
-        } else if ((layout_binding->descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) ||
-                   (layout_binding->descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)) {
-            FilterAndTrackOneBindingReq(binding_req_pair, in_req, out_req, non_dynamic_buffers, stats.non_dynamic_buffer_count);
+        if ((type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) || (type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)) {
+            if ((dynamic_buffers.Count() < stats.dynamic_buffer_count) && dynamic_buffers.Insert(index)) {
+                out_req.emplace_back(binding_req_pair);
+            }
+        } else if ((type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) || (type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)) {
+            if ((non_dynamic_buffers.Count() < stats.non_dynamic_buffer_count) && non_dynamic_buffers.Insert(index)) {
+                out_req.emplace_back(binding_req_pair);
+            }
         } else {
             // This is rather crude, as the changed layouts may not impact the bound descriptors,
             // but the simple "versioning" is a simple "dirt" test.
-            auto &version = image_sample_val[binding];  // Take advantage of default construtor zero initialzing new entries
+            auto &version = image_sample_val[index];
             if (version != cb_state->image_layout_change_count) {
                 version = cb_state->image_layout_change_count;
-                out_req->emplace(binding_req_pair);
+                out_req.emplace_back(binding_req_pair);
             }
         }
-    }
+    });
+    return out_req;
 }
 
 cvdescriptorset::SamplerDescriptor::SamplerDescriptor(const VkSampler *immut) : sampler_(VK_NULL_HANDLE), immutable_(false) {
@@ -1573,6 +1648,10 @@ void cvdescriptorset::SamplerDescriptor::WriteUpdate(const VkWriteDescriptorSet
     updated = true;
 }
 
+bool cvdescriptorset::SamplerDescriptor::MatchesWriteUpdate(const VkWriteDescriptorSet *update, const uint32_t index) const {
+    return updated && (immutable_ || (sampler_ == update->pImageInfo[index].sampler));
+}
+
 void cvdescriptorset::SamplerDescriptor::CopyUpdate(const Descriptor *src) {
     if (!immutable_) {
         auto update_sampler = static_cast<const SamplerDescriptor *>(src)->sampler_;
@@ -1608,6 +1687,12 @@ void cvdescriptorset::ImageSamplerDescriptor::WriteUpdate(const VkWriteDescripto
     image_layout_ = image_info.imageLayout;
 }
 
+bool cvdescriptorset::ImageSamplerDescriptor::MatchesWriteUpdate(const VkWriteDescriptorSet *update, const uint32_t index) const {
+    const auto &image_info = update->pImageInfo[index];
+    return updated && (immutable_ || (sampler_ == image_info.sampler)) && (image_view_ == image_info.imageView) &&
+           (image_layout_ == image_info.imageLayout);
+}
+
 void cvdescriptorset::ImageSamplerDescriptor::CopyUpdate(const Descriptor *src) {
     if (!immutable_) {
         auto update_sampler = static_cast<const ImageSamplerDescriptor *>(src)->sampler_;
@@ -1648,6 +1733,11 @@ void cvdescriptorset::ImageDescriptor::WriteUpdate(const VkWriteDescriptorSet *u
     image_layout_ = image_info.imageLayout;
 }
 
+bool cvdescriptorset::ImageDescriptor::MatchesWriteUpdate(const VkWriteDescriptorSet *update, const uint32_t index) const {
+    const auto &image_info = update->pImageInfo[index];
+    return updated && (image_view_ == image_info.imageView) && (image_layout_ == image_info.imageLayout);
+}
+
 void cvdescriptorset::ImageDescriptor::CopyUpdate(const Descriptor *src) {
     auto image_view = static_cast<const ImageDescriptor *>(src)->image_view_;
     auto image_layout = static_cast<const ImageDescriptor *>(src)->image_layout_;
@@ -1686,6 +1776,11 @@ void cvdescriptorset::BufferDescriptor::WriteUpdate(const VkWriteDescriptorSet *
     range_ = buffer_info.range;
 }
 
+bool cvdescriptorset::BufferDescriptor::MatchesWriteUpdate(const VkWriteDescriptorSet *update, const uint32_t index) const {
+    const auto &buffer_info = update->pBufferInfo[index];
+    return updated && (buffer_ == buffer_info.buffer) && (offset_ == buffer_info.offset) && (range_ == buffer_info.range);
+}
+
 void cvdescriptorset::BufferDescriptor::CopyUpdate(const Descriptor *src) {
     auto buff_desc = static_cast<const BufferDescriptor *>(src);
     updated = true;
@@ -1710,6 +1805,10 @@ void cvdescriptorset::TexelDescriptor::WriteUpdate(const VkWriteDescriptorSet *u
     buffer_view_ = update->pTexelBufferView[index];
 }
 
+bool cvdescriptorset::TexelDescriptor::MatchesWriteUpdate(const VkWriteDescriptorSet *update, const uint32_t index) const {
+    return updated && (buffer_view_ == update->pTexelBufferView[index]);
+}
+
 void cvdescriptorset::TexelDescriptor::CopyUpdate(const Descriptor *src) {
     updated = true;
     buffer_view_ = static_cast<const TexelDescriptor *>(src)->buffer_view_;
@@ -1731,23 +1830,18 @@ bool CoreChecks::ValidateUpdateDescriptorSets(uint32_t write_count, const VkWrit
                                               const VkCopyDescriptorSet *p_cds, const char *func_name) {
     bool skip = false;
     // Validate Write updates
+    // Batches tend to write many bindings of one set in a row, so the set is only looked up again when dstSet changes
+    cvdescriptorset::DescriptorSet *set_node = nullptr;
     for (uint32_t i = 0; i < write_count; i++) {
         auto dest_set = p_wds[i].dstSet;
-        auto set_node = GetSetNode(dest_set);
+        if ((i == 0) || (dest_set != p_wds[i - 1].dstSet)) set_node = GetSetNode(dest_set);
         if (!set_node) {
             skip |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
                             HandleToUint64(dest_set), kVUID_Core_DrawState_InvalidDescriptorSet,
                             "Cannot call %s on descriptor set %s that has not been allocated.", func_name,
                             report_data->FormatHandle(dest_set).c_str());
         } else {
-            std::string error_code;
-            std::string error_str;
-            if (!set_node->ValidateWriteUpdate(report_data, &p_wds[i], func_name, &error_code, &error_str)) {
-                skip |= log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
-                                HandleToUint64(dest_set), error_code,
-                                "%s failed write update validation for Descriptor Set %s with error: %s.", func_name,
-                                report_data->FormatHandle(dest_set).c_str(), error_str.c_str());
-            }
+            skip |= ValidateWriteUpdate(set_node, &p_wds[i], func_name);
         }
     }
     // Now validate copy updates
@@ -1780,9 +1874,10 @@ void cvdescriptorset::PerformUpdateDescriptorSets(CoreChecks *dev_data, uint32_t
                                                   uint32_t copy_count, const VkCopyDescriptorSet *p_cds) {
     // Write updates first
     uint32_t i = 0;
+    DescriptorSet *set_node = nullptr;
     for (i = 0; i < write_count; ++i) {
         auto dest_set = p_wds[i].dstSet;
-        auto set_node = dev_data->GetSetNode(dest_set);
+        if ((i == 0) || (dest_set != p_wds[i - 1].dstSet)) set_node = dev_data->GetSetNode(dest_set);
         if (set_node) {
             set_node->PerformWriteUpdate(&p_wds[i]);
         }
@@ -1827,6 +1922,7 @@ cvdescriptorset::DecodedTemplateUpdate::DecodedTemplateUpdate(CoreChecks *device
             if (dst_array_element >= binding_count) {
                 dst_array_element = 0;
                 binding_being_updated = layout_obj->GetNextValidBinding(binding_being_updated);
+                binding_count = layout_obj->GetDescriptorCountFromBinding(binding_being_updated);
             }
 
             write_entry.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -1864,6 +1960,8 @@ cvdescriptorset::DecodedTemplateUpdate::DecodedTemplateUpdate(CoreChecks *device
                     inline_info->dataSize = create_info.pDescriptorUpdateEntries[i].descriptorCount;
                     inline_info->pData = update_entry;
                     write_entry.pNext = inline_info;
+                    // A single write of all descriptorCount bytes of the block
+                    write_entry.descriptorCount = create_info.pDescriptorUpdateEntries[i].descriptorCount;
                     // skip the rest of the array, they just represent bytes in the update
                     j = create_info.pDescriptorUpdateEntries[i].descriptorCount;
                     break;
@@ -1876,22 +1974,108 @@ cvdescriptorset::DecodedTemplateUpdate::DecodedTemplateUpdate(CoreChecks *device
         }
     }
 }
-// These helper functions carry out the validate and record descriptor updates peformed via update templates. They decode
-// the templatized data and leverage the non-template UpdateDescriptor helper functions.
-bool CoreChecks::ValidateUpdateDescriptorSetsWithTemplateKHR(VkDescriptorSet descriptorSet, const TEMPLATE_STATE *template_state,
-                                                             const void *pData) {
-    // Translate the templated update into a normal update for validation...
-    cvdescriptorset::DecodedTemplateUpdate decoded_update(this, descriptorSet, template_state, pData);
-    return ValidateUpdateDescriptorSets(static_cast<uint32_t>(decoded_update.desc_writes.size()), decoded_update.desc_writes.data(),
-                                        0, NULL, "vkUpdateDescriptorSetWithTemplate()");
+
+cvdescriptorset::TemplateUpdateWrites::TemplateUpdateWrites(const DescriptorSetLayout *layout,
+                                                            const safe_VkDescriptorUpdateTemplateCreateInfo &create_info) {
+    for (uint32_t i = 0; i < create_info.descriptorUpdateEntryCount; i++) {
+        const auto &entry = create_info.pDescriptorUpdateEntries[i];
+        DataKind data_kind;
+        size_t packed_stride;
+        switch (entry.descriptorType) {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+                data_kind = kImageInfo;
+                packed_stride = sizeof(VkDescriptorImageInfo);
+                break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+                data_kind = kBufferInfo;
+                packed_stride = sizeof(VkDescriptorBufferInfo);
+                break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+            case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+                data_kind = kTexelBufferView;
+                packed_stride = sizeof(VkBufferView);
+                break;
+            case VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT:
+                data_kind = kInlineData;
+                packed_stride = 0;
+                break;
+            default:
+                assert(0);
+                continue;
+        }
+
+        auto binding_being_updated = entry.dstBinding;
+        auto binding_count = layout->GetDescriptorCountFromBinding(binding_being_updated);
+        auto dst_array_element = entry.dstArrayElement;
+        const size_t first_write = writes_.size();
+        // The descriptorCount of an inline uniform block entry is the byte size of the block, updated by a single write
+        const uint32_t descriptor_count = (data_kind == kInlineData) ? 1 : entry.descriptorCount;
+        for (uint32_t j = 0; j < descriptor_count; j++) {
+            if (dst_array_element >= binding_count) {
+                dst_array_element = 0;
+                binding_being_updated = layout->GetNextValidBinding(binding_being_updated);
+                binding_count = layout->GetDescriptorCountFromBinding(binding_being_updated);
+            }
+            if ((writes_.size() > first_write) && (entry.stride == packed_stride) &&
+                (writes_.back().binding == binding_being_updated)) {
+                // The next element of the same binding, with its info right after the last one
+                ++writes_.back().count;
+            } else {
+                const uint32_t count = (data_kind == kInlineData) ? entry.descriptorCount : 1;
+                const size_t offset = entry.offset + j * entry.stride;
+                writes_.push_back({binding_being_updated, dst_array_element, count, entry.descriptorType, data_kind, offset});
+            }
+            dst_array_element++;
+        }
+    }
 }
 
-void CoreChecks::PerformUpdateDescriptorSetsWithTemplateKHR(VkDescriptorSet descriptorSet, const TEMPLATE_STATE *template_state,
-                                                            const void *pData) {
-    // Translate the templated update into a normal update for validation...
-    cvdescriptorset::DecodedTemplateUpdate decoded_update(this, descriptorSet, template_state, pData);
-    cvdescriptorset::PerformUpdateDescriptorSets(this, static_cast<uint32_t>(decoded_update.desc_writes.size()),
-                                                 decoded_update.desc_writes.data(), 0, NULL);
+bool CoreChecks::ValidateWriteUpdate(cvdescriptorset::DescriptorSet *set_node, const VkWriteDescriptorSet *update,
+                                     const char *func_name) {
+    std::string error_code;
+    std::string error_str;
+    if (!set_node->ValidateWriteUpdate(report_data, update, func_name, &error_code, &error_str)) {
+        return log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
+                       HandleToUint64(update->dstSet), error_code,
+                       "%s failed write update validation for Descriptor Set %s with error: %s.", func_name,
+                       report_data->FormatHandle(update->dstSet).c_str(), error_str.c_str());
+    }
+    return false;
+}
+
+// These helper functions carry out the validate and record descriptor updates peformed via update templates. They walk the
+// writes decoded when the template was created over pData, and leverage the non-template write update helper functions.
+bool CoreChecks::ValidateUpdateDescriptorSetsWithTemplateKHR(VkDescriptorSet descriptorSet,
+                                                             const UPDATE_TEMPLATE_STATE *template_state, const void *pData) {
+    if (!template_state->writes) return false;  // The set layout was invalid when the template was created
+    const char *func_name = "vkUpdateDescriptorSetWithTemplate()";
+    auto set_node = GetSetNode(descriptorSet);
+    if (!set_node) {
+        return log_msg(report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_DESCRIPTOR_SET_EXT,
+                       HandleToUint64(descriptorSet), kVUID_Core_DrawState_InvalidDescriptorSet,
+                       "Cannot call %s on descriptor set %s that has not been allocated.", func_name,
+                       report_data->FormatHandle(descriptorSet).c_str());
+    }
+    bool skip = false;
+    template_state->writes->ForEachWrite(descriptorSet, pData, [&](const VkWriteDescriptorSet *write) {
+        skip |= ValidateWriteUpdate(set_node, write, func_name);
+    });
+    return skip;
+}
+
+void CoreChecks::PerformUpdateDescriptorSetsWithTemplateKHR(VkDescriptorSet descriptorSet,
+                                                            const UPDATE_TEMPLATE_STATE *template_state, const void *pData) {
+    auto set_node = GetSetNode(descriptorSet);
+    if (!set_node || !template_state->writes) return;
+    template_state->writes->ForEachWrite(
+        descriptorSet, pData, [set_node](const VkWriteDescriptorSet *write) { set_node->PerformWriteUpdate(write); });
 }
 
 std::string cvdescriptorset::DescriptorSet::StringifySetAndLayout() const {
@@ -2189,13 +2373,32 @@ bool cvdescriptorset::DescriptorSet::ValidateBufferUpdate(VkDescriptorBufferInfo
     return true;
 }
 
+bool cvdescriptorset::DescriptorSet::IsWriteUpdateValidated(const VkWriteDescriptorSet *update, uint32_t update_index,
+                                                            uint32_t index) const {
+    const auto descriptor = descriptors_[index];
+    return (descriptor->validated_epoch == device_data_->descriptor_resource_epoch.load()) &&
+           descriptor->MatchesWriteUpdate(update, update_index);
+}
+
+void cvdescriptorset::DescriptorSet::SetWriteUpdateValidated(const VkWriteDescriptorSet *update, uint32_t update_index,
+                                                             uint32_t index) const {
+    const auto descriptor = descriptors_[index];
+    if (descriptor->MatchesWriteUpdate(update, update_index)) {
+        descriptor->validated_epoch = device_data_->descriptor_resource_epoch.load();
+    }
+}
+
 // Verify that the contents of the update are ok, but don't perform actual update
+// Streaming engines rewrite the same contents to descriptors frame after frame. Elements the descriptor already holds, found
+// valid with none of the objects they refer to destroyed since, are skipped.
 bool cvdescriptorset::DescriptorSet::VerifyWriteUpdateContents(const VkWriteDescriptorSet *update, const uint32_t index,
                                                                const char *func_name, std::string *error_code,
                                                                std::string *error_msg) const {
     switch (update->descriptorType) {
         case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER: {
             for (uint32_t di = 0; di < update->descriptorCount; ++di) {
+                // Only marked as validated once the sampler has also been checked below
+                if (IsWriteUpdateValidated(update, di, index + di)) continue;
                 // Validate image
                 auto image_view = update->pImageInfo[di].imageView;
                 auto image_layout = update->pImageInfo[di].imageLayout;
@@ -2208,7 +2411,7 @@ bool cvdescriptorset::DescriptorSet::VerifyWriteUpdateContents(const VkWriteDesc
                     return false;
                 }
                 if (device_data_->device_extensions.vk_khr_sampler_ycbcr_conversion) {
-                    ImageSamplerDescriptor *desc = (ImageSamplerDescriptor *)descriptors_[index + di].get();
+                    ImageSamplerDescriptor *desc = (ImageSamplerDescriptor *)descriptors_[index + di];
                     if (desc->IsImmutableSampler()) {
                         auto sampler_state = device_data_->GetSamplerState(desc->GetSampler());
                         auto iv_state = device_data_->GetImageViewState(image_view);
@@ -2242,7 +2445,8 @@ bool cvdescriptorset::DescriptorSet::VerifyWriteUpdateContents(const VkWriteDesc
         // fall through
         case VK_DESCRIPTOR_TYPE_SAMPLER: {
             for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-                if (!descriptors_[index + di].get()->IsImmutableSampler()) {
+                if (IsWriteUpdateValidated(update, di, index + di)) continue;
+                if (!descriptors_[index + di]->IsImmutableSampler()) {
                     if (!ValidateSampler(update->pImageInfo[di].sampler, device_data_)) {
                         *error_code = "VUID-VkWriteDescriptorSet-descriptorType-00325";
                         std::stringstream error_str;
@@ -2254,6 +2458,7 @@ bool cvdescriptorset::DescriptorSet::VerifyWriteUpdateContents(const VkWriteDesc
                 } else {
                     // TODO : Warn here
                 }
+                SetWriteUpdateValidated(update, di, index + di);
             }
             break;
         }
@@ -2261,6 +2466,7 @@ bool cvdescriptorset::DescriptorSet::VerifyWriteUpdateContents(const VkWriteDesc
         case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
         case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE: {
             for (uint32_t di = 0; di < update->descriptorCount; ++di) {
+                if (IsWriteUpdateValidated(update, di, index + di)) continue;
                 auto image_view = update->pImageInfo[di].imageView;
                 auto image_layout = update->pImageInfo[di].imageLayout;
                 if (!ValidateImageUpdate(image_view, image_layout, update->descriptorType, device_data_, func_name, error_code,
@@ -2270,12 +2476,14 @@ bool cvdescriptorset::DescriptorSet::VerifyWriteUpdateContents(const VkWriteDesc
                     *error_msg = error_str.str();
                     return false;
                 }
+                SetWriteUpdateValidated(update, di, index + di);
             }
             break;
         }
         case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
         case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER: {
             for (uint32_t di = 0; di < update->descriptorCount; ++di) {
+                if (IsWriteUpdateValidated(update, di, index + di)) continue;
                 auto buffer_view = update->pTexelBufferView[di];
                 auto bv_state = device_data_->GetBufferViewState(buffer_view);
                 if (!bv_state) {
@@ -2301,6 +2509,7 @@ bool cvdescriptorset::DescriptorSet::VerifyWriteUpdateContents(const VkWriteDesc
                     *error_msg = error_str.str();
                     return false;
                 }
+                SetWriteUpdateValidated(update, di, index + di);
             }
             break;
         }
@@ -2309,12 +2518,14 @@ bool cvdescriptorset::DescriptorSet::VerifyWriteUpdateContents(const VkWriteDesc
         case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
         case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC: {
             for (uint32_t di = 0; di < update->descriptorCount; ++di) {
+                if (IsWriteUpdateValidated(update, di, index + di)) continue;
                 if (!ValidateBufferUpdate(update->pBufferInfo + di, update->descriptorType, func_name, error_code, error_msg)) {
                     std::stringstream error_str;
                     error_str << "Attempted write update to buffer descriptor failed due to: " << error_msg->c_str();
                     *error_msg = error_str.str();
                     return false;
                 }
+                SetWriteUpdateValidated(update, di, index + di);
             }
             break;
         }
@@ -2339,7 +2550,7 @@ bool cvdescriptorset::DescriptorSet::VerifyCopyUpdateContents(const VkCopyDescri
     switch (src_set->descriptors_[index]->descriptor_class) {
         case PlainSampler: {
             for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-                const auto src_desc = src_set->descriptors_[index + di].get();
+                const auto src_desc = src_set->descriptors_[index + di];
                 if (!src_desc->updated) continue;
                 if (!src_desc->IsImmutableSampler()) {
                     auto update_sampler = static_cast<SamplerDescriptor *>(src_desc)->GetSampler();
@@ -2358,7 +2569,7 @@ bool cvdescriptorset::DescriptorSet::VerifyCopyUpdateContents(const VkCopyDescri
         }
         case ImageSampler: {
             for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-                const auto src_desc = src_set->descriptors_[index + di].get();
+                const auto src_desc = src_set->descriptors_[index + di];
                 if (!src_desc->updated) continue;
                 auto img_samp_desc = static_cast<const ImageSamplerDescriptor *>(src_desc);
                 // First validate sampler
@@ -2388,7 +2599,7 @@ bool cvdescriptorset::DescriptorSet::VerifyCopyUpdateContents(const VkCopyDescri
         }
         case Image: {
             for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-                const auto src_desc = src_set->descriptors_[index + di].get();
+                const auto src_desc = src_set->descriptors_[index + di];
                 if (!src_desc->updated) continue;
                 auto img_desc = static_cast<const ImageDescriptor *>(src_desc);
                 auto image_view = img_desc->GetImageView();
@@ -2404,7 +2615,7 @@ bool cvdescriptorset::DescriptorSet::VerifyCopyUpdateContents(const VkCopyDescri
         }
         case TexelBuffer: {
             for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-                const auto src_desc = src_set->descriptors_[index + di].get();
+                const auto src_desc = src_set->descriptors_[index + di];
                 if (!src_desc->updated) continue;
                 auto buffer_view = static_cast<TexelDescriptor *>(src_desc)->GetBufferView();
                 auto bv_state = device_data_->GetBufferViewState(buffer_view);
@@ -2427,7 +2638,7 @@ bool cvdescriptorset::DescriptorSet::VerifyCopyUpdateContents(const VkCopyDescri
         }
         case GeneralBuffer: {
             for (uint32_t di = 0; di < update->descriptorCount; ++di) {
-                const auto src_desc = src_set->descriptors_[index + di].get();
+                const auto src_desc = src_set->descriptors_[index + di];
                 if (!src_desc->updated) continue;
                 auto buffer = static_cast<BufferDescriptor *>(src_desc)->GetBuffer();
                 if (!ValidateBufferUsage(device_data_->GetBufferState(buffer), type, error_code, error_msg)) {
@@ -2564,23 +2775,22 @@ void CoreChecks::PerformAllocateDescriptorSets(const VkDescriptorSetAllocateInfo
             descriptor_sets[i], p_alloc_info->descriptorPool, ds_data->layout_nodes[i], variable_count, this));
         pool_state->sets.insert(new_ds.get());
         new_ds->in_use.store(0);
+        CacheStateInHandle(descriptor_sets[i], new_ds.get());
         setMap[descriptor_sets[i]] = std::move(new_ds);
     }
 }
 
 cvdescriptorset::PrefilterBindRequestMap::PrefilterBindRequestMap(cvdescriptorset::DescriptorSet &ds, const BindingReqMap &in_map,
                                                                   CMD_BUFFER_STATE *cb_state)
-    : filtered_map_(), orig_map_(in_map) {
+    : filtered_map_(nullptr), orig_map_(in_map) {
     if (ds.GetTotalDescriptorCount() > kManyDescriptors_) {
-        filtered_map_.reset(new std::map<uint32_t, descriptor_req>());
-        ds.FilterAndTrackBindingReqs(cb_state, orig_map_, filtered_map_.get());
+        filtered_map_ = &ds.FilterAndTrackBindingReqs(cb_state, orig_map_);
     }
 }
 cvdescriptorset::PrefilterBindRequestMap::PrefilterBindRequestMap(cvdescriptorset::DescriptorSet &ds, const BindingReqMap &in_map,
                                                                   CMD_BUFFER_STATE *cb_state, PIPELINE_STATE *pipeline)
-    : filtered_map_(), orig_map_(in_map) {
+    : filtered_map_(nullptr), orig_map_(in_map) {
     if (ds.GetTotalDescriptorCount() > kManyDescriptors_) {
-        filtered_map_.reset(new std::map<uint32_t, descriptor_req>());
-        ds.FilterAndTrackBindingReqs(cb_state, pipeline, orig_map_, filtered_map_.get());
+        filtered_map_ = &ds.FilterAndTrackBindingReqs(cb_state, pipeline, orig_map_);
     }
 }
@@ -21,20 +21,28 @@
 #ifndef CORE_VALIDATION_DESCRIPTOR_SETS_H_
 #define CORE_VALIDATION_DESCRIPTOR_SETS_H_
 
+#include "arena_allocator.h"
 #include "hash_vk_types.h"
+#include "slab_allocator.h"
 #include "vk_layer_logging.h"
 #include "vk_layer_utils.h"
 #include "vk_safe_struct.h"
 #include "vulkan/vk_layer.h"
 #include "vk_object_types.h"
+#include <algorithm>
+#include <cassert>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <set>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 class CoreChecks;
+class WorkerPool;
 
 // Descriptor Data structures
 namespace cvdescriptorset {
@@ -47,7 +55,37 @@ struct IndexRange {
     uint32_t start;
     uint32_t end;
 };
-typedef std::map<uint32_t, descriptor_req> BindingReqMap;
+
+// Set of binding indices (not binding#s) of a layout, one bit per index
+class BindingBitset {
+   public:
+    BindingBitset() : count_(0) {}
+    // Make room for binding indices [0, size), leaving any set bits in place
+    void Reserve(uint32_t size) {
+        const size_t words = (size + kWordBits - 1) / kWordBits;
+        if (words_.size() < words) words_.resize(words, 0);
+    }
+    bool Contains(uint32_t index) const { return (words_[index / kWordBits] & Bit(index)) != 0; }
+    // Returns whether index was newly inserted
+    bool Insert(uint32_t index) {
+        uint64_t &word = words_[index / kWordBits];
+        if (word & Bit(index)) return false;
+        word |= Bit(index);
+        ++count_;
+        return true;
+    }
+    void Clear() {
+        std::fill(words_.begin(), words_.end(), 0);
+        count_ = 0;
+    }
+    uint32_t Count() const { return count_; }
+
+   private:
+    static const uint32_t kWordBits = 64;
+    static uint64_t Bit(uint32_t index) { return uint64_t(1) << (index % kWordBits); }
+    std::vector<uint64_t> words_;
+    uint32_t count_;
+};
 
 /*
  * DescriptorSetLayoutDef/DescriptorSetLayout classes
@@ -296,11 +334,15 @@ class DescriptorSetLayout {
 // Slightly broader than type, each c++ "class" will has a corresponding "DescriptorClass"
 enum DescriptorClass { PlainSampler, ImageSampler, Image, TexelBuffer, GeneralBuffer, InlineUniform, AccelerationStructure };
 
+// Descriptors are stored by value in a DescriptorArray, which frees their storage without running destructors. So every
+// descriptor class must be trivially destructible, holding only handles and plain values, and a descriptor can't be deleted
+// through a Descriptor pointer. DescriptorArray::emplace_back() checks this for each class.
 class Descriptor {
    public:
-    virtual ~Descriptor(){};
     virtual void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) = 0;
     virtual void CopyUpdate(const Descriptor *) = 0;
+    // Does the descriptor already hold what WriteUpdate() would write to it?
+    virtual bool MatchesWriteUpdate(const VkWriteDescriptorSet *, const uint32_t) const { return false; }
     // Create binding between resources of this descriptor and given cb_node
     virtual void UpdateDrawState(CoreChecks *, CMD_BUFFER_STATE *) = 0;
     virtual DescriptorClass GetClass() const { return descriptor_class; };
@@ -312,6 +354,12 @@ class Descriptor {
     virtual bool IsStorage() const { return false; };
     bool updated;  // Has descriptor been updated?
     DescriptorClass descriptor_class;
+    // The CoreChecks::descriptor_resource_epoch at which the contents were last found valid for a write update, 0 if they
+    // haven't been. Writing identical contents again at the same epoch skips the validation.
+    mutable uint64_t validated_epoch = 0;
+
+   protected:
+    ~Descriptor() = default;
 };
 // Shared helper functions - These are useful because the shared sampler image descriptor type
 //  performs common functions with both sampler and image descriptors so they can share their common functions
@@ -324,6 +372,7 @@ class SamplerDescriptor : public Descriptor {
     SamplerDescriptor(const VkSampler *);
     void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) override;
     void CopyUpdate(const Descriptor *) override;
+    bool MatchesWriteUpdate(const VkWriteDescriptorSet *, const uint32_t) const override;
     void UpdateDrawState(CoreChecks *, CMD_BUFFER_STATE *) override;
     virtual bool IsImmutableSampler() const override { return immutable_; };
     VkSampler GetSampler() const { return sampler_; }
@@ -339,6 +388,7 @@ class ImageSamplerDescriptor : public Descriptor {
     ImageSamplerDescriptor(const VkSampler *);
     void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) override;
     void CopyUpdate(const Descriptor *) override;
+    bool MatchesWriteUpdate(const VkWriteDescriptorSet *, const uint32_t) const override;
     void UpdateDrawState(CoreChecks *, CMD_BUFFER_STATE *) override;
     virtual bool IsImmutableSampler() const override { return immutable_; };
     VkSampler GetSampler() const { return sampler_; }
@@ -357,6 +407,7 @@ class ImageDescriptor : public Descriptor {
     ImageDescriptor(const VkDescriptorType);
     void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) override;
     void CopyUpdate(const Descriptor *) override;
+    bool MatchesWriteUpdate(const VkWriteDescriptorSet *, const uint32_t) const override;
     void UpdateDrawState(CoreChecks *, CMD_BUFFER_STATE *) override;
     virtual bool IsStorage() const override { return storage_; }
     VkImageView GetImageView() const { return image_view_; }
@@ -373,6 +424,7 @@ class TexelDescriptor : public Descriptor {
     TexelDescriptor(const VkDescriptorType);
     void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) override;
     void CopyUpdate(const Descriptor *) override;
+    bool MatchesWriteUpdate(const VkWriteDescriptorSet *, const uint32_t) const override;
     void UpdateDrawState(CoreChecks *, CMD_BUFFER_STATE *) override;
     virtual bool IsStorage() const override { return storage_; }
     VkBufferView GetBufferView() const { return buffer_view_; }
@@ -387,6 +439,7 @@ class BufferDescriptor : public Descriptor {
     BufferDescriptor(const VkDescriptorType);
     void WriteUpdate(const VkWriteDescriptorSet *, const uint32_t) override;
     void CopyUpdate(const Descriptor *) override;
+    bool MatchesWriteUpdate(const VkWriteDescriptorSet *, const uint32_t) const override;
     void UpdateDrawState(CoreChecks *, CMD_BUFFER_STATE *) override;
     virtual bool IsDynamic() const override { return dynamic_; }
     virtual bool IsStorage() const override { return storage_; }
@@ -424,6 +477,53 @@ class AccelerationStructureDescriptor : public Descriptor {
     void UpdateDrawState(CoreChecks *, CMD_BUFFER_STATE *) override {}
 };
 
+// Fixed capacity array of descriptors of any class, stored by value in one allocation sized for the largest class. Sets
+// with very large bindings cost a single allocation instead of one per descriptor, and walking a binding reads
+// consecutive slots instead of chasing a pointer per descriptor.
+class DescriptorArray {
+   public:
+    DescriptorArray() : slots_(nullptr), size_(0) {}
+    DescriptorArray(const DescriptorArray &) = delete;
+    DescriptorArray &operator=(const DescriptorArray &) = delete;
+    // Descriptors are trivially destructible, so the slots are freed without visiting them, by owned_slots_ or by the
+    // arena's owner
+    ~DescriptorArray() = default;
+
+    // Must be called once, before any descriptor is added. If an arena is given the slots are carved from it, and the
+    // arena must not be reset before this array is destroyed.
+    void reserve(uint32_t capacity, ArenaAllocator *arena) {
+        assert(!slots_);
+        if (arena) {
+            slots_ = static_cast<Slot *>(arena->Allocate(capacity * sizeof(Slot), alignof(Slot)));
+        } else {
+            owned_slots_.reset(new Slot[capacity]);
+            slots_ = owned_slots_.get();
+        }
+    }
+    template <typename DescriptorClass, typename... Args>
+    void emplace_back(Args &&... args) {
+        static_assert(sizeof(DescriptorClass) <= sizeof(Slot), "Slot is too small for this descriptor class");
+        static_assert(std::is_trivially_destructible<DescriptorClass>::value,
+                      "Descriptor destructors are never run, so descriptor classes must be trivially destructible");
+        Descriptor *descriptor = new (&slots_[size_]) DescriptorClass(std::forward<Args>(args)...);
+        // Descriptors are found again from their slot address, so the Descriptor base must sit at the start of each class
+        assert(static_cast<void *>(descriptor) == static_cast<void *>(&slots_[size_]));
+        (void)descriptor;
+        ++size_;
+    }
+
+    // As with a vector of unique_ptr, the descriptors are not const when the array is
+    Descriptor *operator[](uint32_t index) const { return reinterpret_cast<Descriptor *>(&slots_[index]); }
+    uint32_t size() const { return size_; }
+
+   private:
+    typedef std::aligned_union<0, SamplerDescriptor, ImageSamplerDescriptor, ImageDescriptor, TexelDescriptor, BufferDescriptor,
+                               InlineUniformDescriptor, AccelerationStructureDescriptor>::type Slot;
+    Slot *slots_;
+    std::unique_ptr<Slot[]> owned_slots_;
+    uint32_t size_;
+};
+
 // Structs to contain common elements that need to be shared between Validate* and Perform* calls below
 struct AllocateDescriptorSetsData {
     std::map<uint32_t, uint32_t> required_descriptors_by_type;
@@ -437,7 +537,8 @@ bool ValidateUpdateDescriptorSets(const debug_report_data *, const CoreChecks *,
 // "Perform" does the update with the assumption that ValidateUpdateDescriptorSets() has passed for the given update
 void PerformUpdateDescriptorSets(CoreChecks *, uint32_t, const VkWriteDescriptorSet *, uint32_t, const VkCopyDescriptorSet *);
 
-// Helper class to encapsulate the descriptor update template decoding logic
+// Helper class to encapsulate the descriptor update template decoding logic, used for push descriptor templates whose set
+// layout is only known per command
 struct DecodedTemplateUpdate {
     std::vector<VkWriteDescriptorSet> desc_writes;
     std::vector<VkWriteDescriptorSetInlineUniformBlockEXT> inline_infos;
@@ -445,6 +546,66 @@ struct DecodedTemplateUpdate {
                           const void *pData, VkDescriptorSetLayout push_layout = VK_NULL_HANDLE);
 };
 
+// The writes of a descriptor set update template, decoded from its entries against the set layout once, when the template
+// is created.  Each write covers the descriptors of one entry within one binding and points straight into the pData of the
+// update, so applying the template decodes and allocates nothing.  Entries whose infos aren't packed back to back in pData
+// get a write per descriptor.
+class TemplateUpdateWrites {
+   public:
+    TemplateUpdateWrites(const DescriptorSetLayout *layout, const safe_VkDescriptorUpdateTemplateCreateInfo &create_info);
+
+    // Call fn(const VkWriteDescriptorSet *) for each write of the update of set from pData, in order
+    template <typename Fn>
+    void ForEachWrite(VkDescriptorSet set, const void *pData, Fn &&fn) const {
+        VkWriteDescriptorSetInlineUniformBlockEXT inline_info = {};
+        inline_info.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_INLINE_UNIFORM_BLOCK_EXT;
+        VkWriteDescriptorSet write = {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = set;
+        for (const auto &desc : writes_) {
+            const auto data = static_cast<const uint8_t *>(pData) + desc.offset;
+            write.pNext = nullptr;
+            write.dstBinding = desc.binding;
+            write.dstArrayElement = desc.array_element;
+            write.descriptorCount = desc.count;
+            write.descriptorType = desc.type;
+            write.pImageInfo = nullptr;
+            write.pBufferInfo = nullptr;
+            write.pTexelBufferView = nullptr;
+            switch (desc.data_kind) {
+                case kImageInfo:
+                    write.pImageInfo = reinterpret_cast<const VkDescriptorImageInfo *>(data);
+                    break;
+                case kBufferInfo:
+                    write.pBufferInfo = reinterpret_cast<const VkDescriptorBufferInfo *>(data);
+                    break;
+                case kTexelBufferView:
+                    write.pTexelBufferView = reinterpret_cast<const VkBufferView *>(data);
+                    break;
+                case kInlineData:
+                    inline_info.dataSize = desc.count;
+                    inline_info.pData = data;
+                    write.pNext = &inline_info;
+                    break;
+            }
+            fn(&write);
+        }
+    }
+
+   private:
+    // Which member of VkWriteDescriptorSet the data of a write goes in
+    enum DataKind : uint8_t { kImageInfo, kBufferInfo, kTexelBufferView, kInlineData };
+    struct WriteDesc {
+        uint32_t binding;
+        uint32_t array_element;
+        uint32_t count;
+        VkDescriptorType type;
+        DataKind data_kind;
+        size_t offset;  // Of the data of the first descriptor in pData
+    };
+    std::vector<WriteDesc> writes_;
+};
+
 /*
  * DescriptorSet class
  *
@@ -455,7 +616,7 @@ struct DecodedTemplateUpdate {
  *   Please refer to the DescriptorSetLayout comment above for a description of
  *   index, binding, and global index.
  *
- * At construction a vector of Descriptor* is created with types corresponding to the
+ * At construction an array of Descriptors is created with types corresponding to the
  *   layout. The primary operation performed on the descriptors is to update them
  *   via write or copy updates, and validate that the update contents are correct.
  *   In order to validate update contents, the DescriptorSet stores a bunch of ptrs
@@ -463,7 +624,7 @@ struct DecodedTemplateUpdate {
  *   those maps is performed externally. The set class relies on their contents to
  *   be correct at the time of update.
  */
-class DescriptorSet : public BASE_NODE {
+class DescriptorSet : public BASE_NODE, public SlabAllocated<DescriptorSet> {
    public:
     DescriptorSet(const VkDescriptorSet, const VkDescriptorPool, const std::shared_ptr<DescriptorSetLayout const> &,
                   uint32_t variable_count, CoreChecks *);
@@ -488,12 +649,11 @@ class DescriptorSet : public BASE_NODE {
     // Is this set compatible with the given layout?
     bool IsCompatible(DescriptorSetLayout const *const, std::string *) const;
     // For given bindings validate state at time of draw is correct, returning false on error and writing error details into string*
-    bool ValidateDrawState(const std::map<uint32_t, descriptor_req> &, const std::vector<uint32_t> &, CMD_BUFFER_STATE *,
-                           const char *caller, std::string *) const;
+    bool ValidateDrawState(const BindingReqMap &, const std::vector<uint32_t> &, CMD_BUFFER_STATE *, const char *caller,
+                           std::string *) const;
     // For given set of bindings, add any buffers and images that will be updated to their respective unordered_sets & return number
     // of objects inserted
-    uint32_t GetStorageUpdates(const std::map<uint32_t, descriptor_req> &, std::unordered_set<VkBuffer> *,
-                               std::unordered_set<VkImageView> *) const;
+    uint32_t GetStorageUpdates(const BindingReqMap &, std::unordered_set<VkBuffer> *, std::unordered_set<VkImageView> *) const;
 
     std::string StringifySetAndLayout() const;
     // Descriptor Update functions. These functions validate state and perform update separately
@@ -518,24 +678,24 @@ class DescriptorSet : public BASE_NODE {
     std::unordered_set<CMD_BUFFER_STATE *> GetBoundCmdBuffers() const { return cb_bindings; }
     // Bind given cmd_buffer to this descriptor set and
     // update CB image layout map with image/imagesampler descriptor image layouts
-    void UpdateDrawState(CoreChecks *, CMD_BUFFER_STATE *, const std::map<uint32_t, descriptor_req> &);
+    void UpdateDrawState(CoreChecks *, CMD_BUFFER_STATE *, const BindingReqMap &);
 
     // Track work that has been bound or validated to avoid duplicate work, important when large descriptor arrays
-    // are present
-    typedef std::unordered_set<uint32_t> TrackedBindings;
-    static void FilterAndTrackOneBindingReq(const BindingReqMap::value_type &binding_req_pair, const BindingReqMap &in_req,
-                                            BindingReqMap *out_req, TrackedBindings *set);
-    static void FilterAndTrackOneBindingReq(const BindingReqMap::value_type &binding_req_pair, const BindingReqMap &in_req,
-                                            BindingReqMap *out_req, TrackedBindings *set, uint32_t limit);
-    void FilterAndTrackBindingReqs(CMD_BUFFER_STATE *, const BindingReqMap &in_req, BindingReqMap *out_req);
-    void FilterAndTrackBindingReqs(CMD_BUFFER_STATE *, PIPELINE_STATE *, const BindingReqMap &in_req, BindingReqMap *out_req);
+    // are present. The returned requirements are the subset of in_req still needing work, and are only valid until the next
+    // call for the same command buffer.
+    typedef BindingBitset TrackedBindings;
+    const BindingReqMap &FilterAndTrackBindingReqs(CMD_BUFFER_STATE *, const BindingReqMap &in_req);
+    const BindingReqMap &FilterAndTrackBindingReqs(CMD_BUFFER_STATE *, PIPELINE_STATE *, const BindingReqMap &in_req);
     void ClearCachedDynamicDescriptorValidation(CMD_BUFFER_STATE *cb_state) {
-        cached_validation_[cb_state].dynamic_buffers.clear();
+        GetCachedValidation(cb_state).dynamic_buffers.Clear();
+    }
+    void ClearCachedValidation(CMD_BUFFER_STATE *cb_state) {
+        std::lock_guard<std::mutex> lock(cached_validation_lock_);
+        cached_validation_.erase(cb_state);
     }
-    void ClearCachedValidation(CMD_BUFFER_STATE *cb_state) { cached_validation_.erase(cb_state); }
     // If given cmd_buffer is in the cb_bindings set, remove it
     void RemoveBoundCommandBuffer(CMD_BUFFER_STATE *cb_node) {
-        cb_bindings.erase(cb_node);
+        RemoveCbBinding(cb_node);
         ClearCachedValidation(cb_node);
     }
     VkSampler const *GetImmutableSamplerPtrFromBinding(const uint32_t index) const {
@@ -553,6 +713,8 @@ class DescriptorSet : public BASE_NODE {
     };
     // Return true if any part of set has ever been updated
     bool IsUpdated() const { return some_update_; };
+    // Number of write and copy updates to the set, which can change it while bound when its bindings are update-after-bind
+    uint64_t GetChangeCount() const { return change_count_; }
     bool IsPushDescriptor() const { return p_layout_->IsPushDescriptor(); };
     bool IsVariableDescriptorCount(uint32_t binding) const {
         return !!(p_layout_->GetDescriptorBindingFlagsFromBinding(binding) &
@@ -563,21 +725,43 @@ class DescriptorSet : public BASE_NODE {
     }
     uint32_t GetVariableDescriptorCount() const { return variable_count_; }
     DESCRIPTOR_POOL_STATE *GetPoolState() const { return pool_state_; }
-    const Descriptor *GetDescriptorFromGlobalIndex(const uint32_t index) const { return descriptors_[index].get(); }
+    const Descriptor *GetDescriptorFromGlobalIndex(const uint32_t index) const { return descriptors_[index]; }
 
    private:
     bool VerifyWriteUpdateContents(const VkWriteDescriptorSet *, const uint32_t, const char *, std::string *, std::string *) const;
+    // Does the descriptor at index already hold element update_index of the write, found valid at the current epoch?
+    bool IsWriteUpdateValidated(const VkWriteDescriptorSet *update, uint32_t update_index, uint32_t index) const;
+    // Note element update_index of the write was found valid, if the descriptor at index already holds it
+    void SetWriteUpdateValidated(const VkWriteDescriptorSet *update, uint32_t update_index, uint32_t index) const;
     bool VerifyCopyUpdateContents(const VkCopyDescriptorSet *, const DescriptorSet *, VkDescriptorType, uint32_t, const char *,
                                   std::string *, std::string *) const;
     bool ValidateBufferUsage(BUFFER_STATE const *, VkDescriptorType, std::string *, std::string *) const;
     bool ValidateBufferUpdate(VkDescriptorBufferInfo const *, VkDescriptorType, const char *, std::string *, std::string *) const;
+    bool ValidateDrawStateDescriptors(WorkerPool *, const BindingReqMap::value_type &, const IndexRange &,
+                                      const std::vector<uint32_t> &, CMD_BUFFER_STATE *, const char *caller, std::string *) const;
+    bool ValidateDrawStateDescriptor(const BindingReqMap::value_type &, uint32_t index, uint32_t global_index,
+                                     const std::vector<uint32_t> &, CMD_BUFFER_STATE *, const char *caller, bool quiet,
+                                     std::string *) const;
     // Private helper to set all bound cmd buffers to INVALID state
     void InvalidateBoundCmdBuffers();
+    // Call fn(index, req_pair) for each requirement whose binding is in the layout, in binding order. Both the layout bindings
+    // and the requirements are sorted by binding#, so the indices are found by walking the two together.
+    template <typename Fn>
+    void ForEachBindingReqIndex(const BindingReqMap &reqs, Fn &&fn) const {
+        const auto &layout_bindings = p_layout_->GetBindings();
+        uint32_t index = 0;
+        for (const auto &binding_req_pair : reqs) {
+            while ((index < layout_bindings.size()) && (layout_bindings[index].binding < binding_req_pair.first)) ++index;
+            if (index == layout_bindings.size()) break;
+            if (layout_bindings[index].binding == binding_req_pair.first) fn(index, binding_req_pair);
+        }
+    }
     bool some_update_;  // has any part of the set ever been updated?
+    uint64_t change_count_;
     VkDescriptorSet set_;
     DESCRIPTOR_POOL_STATE *pool_state_;
     const std::shared_ptr<DescriptorSetLayout const> p_layout_;
-    std::vector<std::unique_ptr<Descriptor>> descriptors_;
+    DescriptorArray descriptors_;
     CoreChecks *device_data_;
     const VkPhysicalDeviceLimits limits_;
     uint32_t variable_count_;
@@ -586,25 +770,31 @@ class DescriptorSet : public BASE_NODE {
     //
     // For the lifespan of a given command buffer recording, do lazy evaluation, caching, and dirtying of
     // expensive validation operation (typically per-draw)
-    typedef std::unordered_map<CMD_BUFFER_STATE *, TrackedBindings> TrackedBindingMap;
-    typedef std::unordered_map<PIPELINE_STATE *, TrackedBindingMap> ValidatedBindings;
-    // Track the validation caching of bindings vs. the command buffer and draw state
-    typedef std::unordered_map<uint32_t, CMD_BUFFER_STATE::ImageLayoutUpdateCount> VersionedBindings;
+    // Track the validation caching of bindings vs. the command buffer and draw state, indexed by binding index
+    typedef std::vector<CMD_BUFFER_STATE::ImageLayoutUpdateCount> VersionedBindings;
     struct CachedValidation {
         TrackedBindings command_binding_and_usage;                               // Persistent for the life of the recording
         TrackedBindings non_dynamic_buffers;                                     // Persistent for the life of the recording
         TrackedBindings dynamic_buffers;                                         // Dirtied (flushed) each BindDescriptorSet
         std::unordered_map<PIPELINE_STATE *, VersionedBindings> image_samplers;  // Tested vs. changes to CB's ImageLayout
+        BindingReqMap filtered_reqs;  // Result of the last FilterAndTrackBindingReqs, reused to avoid per draw allocations
     };
     typedef std::unordered_map<CMD_BUFFER_STATE *, CachedValidation> CachedValidationMap;
     // Image and ImageView bindings are validated per pipeline and not invalidate by repeated binding
     CachedValidationMap cached_validation_;
+    // Different command buffers sharing this set may be validated and recorded concurrently, so lookups, inserts and erases
+    // in cached_validation_ are serialized. The entries themselves are only touched by the owning command buffer.
+    std::mutex cached_validation_lock_;
+    CachedValidation &GetCachedValidation(CMD_BUFFER_STATE *cb_state) {
+        std::lock_guard<std::mutex> lock(cached_validation_lock_);
+        return cached_validation_[cb_state];
+    }
 };
 // For the "bindless" style resource usage with many descriptors, need to optimize binding and validation
 class PrefilterBindRequestMap {
    public:
     static const uint32_t kManyDescriptors_ = 64;  // TODO base this number on measured data
-    std::unique_ptr<BindingReqMap> filtered_map_;
+    const BindingReqMap *filtered_map_;
     const BindingReqMap &orig_map_;
 
     PrefilterBindRequestMap(DescriptorSet &ds, const BindingReqMap &in_map, CMD_BUFFER_STATE *cb_state);
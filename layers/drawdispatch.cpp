@@ -41,7 +41,13 @@
 #include "chassis.h"
 #include "core_validation.h"
 
-static inline void UpdateResourceTrackingOnDraw(CMD_BUFFER_STATE *pCB) { pCB->draw_data.push_back(pCB->current_draw_data); }
+static inline void UpdateResourceTrackingOnDraw(CMD_BUFFER_STATE *pCB) {
+    if (pCB->current_draw_data_recorded) return;
+    for (const auto &vertex_buffer_binding : pCB->current_draw_data.vertex_buffer_bindings) {
+        if (vertex_buffer_binding.buffer != VK_NULL_HANDLE) pCB->draw_vertex_buffers.insert(vertex_buffer_binding.buffer);
+    }
+    pCB->current_draw_data_recorded = true;
+}
 
 // Generic function to handle validation for all CmdDraw* type functions
 bool CoreChecks::ValidateCmdDrawType(VkCommandBuffer cmd_buffer, bool indexed, VkPipelineBindPoint bind_point, CMD_TYPE cmd_type,
@@ -64,6 +70,7 @@ bool CoreChecks::ValidateCmdDrawType(VkCommandBuffer cmd_buffer, bool indexed, V
 // Generic function to handle state update for all CmdDraw* and CmdDispatch* type functions
 void CoreChecks::UpdateStateCmdDrawDispatchType(CMD_BUFFER_STATE *cb_state, VkPipelineBindPoint bind_point) {
     UpdateDrawState(cb_state, bind_point);
+    RecordValidatedDrawState(cb_state, bind_point);
 }
 
 // Generic function to handle state update for all CmdDraw* type functions
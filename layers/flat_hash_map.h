@@ -0,0 +1,386 @@
+/* Copyright (c) 2019 The Khronos Group Inc.
+ * Copyright (c) 2019 Valve Corporation
+ * Copyright (c) 2019 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#pragma once
+#ifndef FLAT_HASH_MAP_H_
+#define FLAT_HASH_MAP_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define FLAT_HASH_MAP_USE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Open addressing hash map for the validation state tables.
+//
+// Keys, values and one control byte per slot live in three separate arrays. A lookup hashes the key once, then scans the
+// control bytes a group of 16 slots at a time (with SSE2 when available) for the 7 hash bits stored there, and only touches
+// the key array on a tag match, so a miss or a hit in a large table costs about one cache line of control bytes plus the
+// key itself. Erased slots become tombstones that are dropped on the next rehash.
+//
+// The interface is the subset of std::unordered_map the layers use, with two differences:
+//  - Inserting can move every key and value, so references and iterators are invalidated by any insertion. Pointers to
+//    state objects held through a unique_ptr or shared_ptr value are unaffected, which is how the state tables use it.
+//  - Iterators dereference to a proxy with first and second members rather than to a std::pair, so range-for loops over
+//    the map must bind elements with "auto" or "const auto &".
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap {
+    template <bool kConst>
+    class Iterator;
+
+   public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = size_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() {}
+    FlatHashMap(FlatHashMap &&other) { Swap(other); }
+    FlatHashMap &operator=(FlatHashMap &&other) {
+        if (this != &other) {
+            FlatHashMap discard;
+            Swap(other);
+            other.Swap(discard);
+        }
+        return *this;
+    }
+    FlatHashMap(const FlatHashMap &) = delete;
+    FlatHashMap &operator=(const FlatHashMap &) = delete;
+    ~FlatHashMap() {
+        DestroySlots();
+        Deallocate(ctrl_, keys_, values_, capacity_);
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    iterator begin() { return iterator(this, NextFull(0)); }
+    iterator end() { return iterator(this, capacity_); }
+    const_iterator begin() const { return const_iterator(this, NextFull(0)); }
+    const_iterator end() const { return const_iterator(this, capacity_); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    iterator find(const Key &key) { return iterator(this, FindIndex(key, HashKey(key))); }
+    const_iterator find(const Key &key) const { return const_iterator(this, FindIndex(key, HashKey(key))); }
+    size_t count(const Key &key) const { return (FindIndex(key, HashKey(key)) != capacity_) ? 1 : 0; }
+
+    // The mapped value is only constructed from args if the key is not already present
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const Key &key, Args &&... args) {
+        const std::pair<size_t, bool> slot = FindOrPrepareInsert(key);
+        if (slot.second) {
+            new (&keys_[slot.first]) Key(key);
+            new (&values_[slot.first]) T(std::forward<Args>(args)...);
+        }
+        return std::make_pair(iterator(this, slot.first), slot.second);
+    }
+    template <typename Pair>
+    std::pair<iterator, bool> insert(Pair &&pair) {
+        return emplace(pair.first, std::forward<Pair>(pair).second);
+    }
+    T &operator[](const Key &key) { return emplace(key).first->second; }
+
+    size_t erase(const Key &key) {
+        const size_t index = FindIndex(key, HashKey(key));
+        if (index == capacity_) return 0;
+        EraseSlot(index);
+        return 1;
+    }
+    // Erasing never moves other elements, so the iterator returned is the next element of the iteration in progress
+    iterator erase(const_iterator pos) {
+        EraseSlot(pos.index_);
+        return iterator(this, NextFull(pos.index_ + 1));
+    }
+    iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+    void clear() {
+        if (size_ == 0) return;
+        DestroySlots();
+        ResetCtrl();
+    }
+
+    void reserve(size_t count) {
+        if (count > MaxLoad(capacity_)) Resize(CapacityFor(count));
+    }
+
+   private:
+    typedef int8_t ctrl_t;
+    static const size_t kGroupWidth = 16;
+    static const ctrl_t kEmpty = -128;
+    static const ctrl_t kDeleted = -2;
+
+    // A full slot's control byte holds the top 7 bits of its hash, so it is always >= 0, and empty and deleted slots are not
+    static bool IsFull(ctrl_t ctrl) { return ctrl >= 0; }
+
+    static uint32_t CountTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<uint32_t>(index);
+#elif defined(__GNUC__)
+        return static_cast<uint32_t>(__builtin_ctz(mask));
+#else
+        uint32_t index = 0;
+        while ((mask & 1) == 0) {
+            mask >>= 1;
+            ++index;
+        }
+        return index;
+#endif
+    }
+
+    // The control bytes of kGroupWidth consecutive slots, matched against a tag in one go. Bit i of each mask is set if
+    // slot i of the group matches.
+    class Group {
+       public:
+#if defined(FLAT_HASH_MAP_USE_SSE2)
+        explicit Group(const ctrl_t *pos) : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+        uint32_t Match(ctrl_t tag) const {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(tag))));
+        }
+        uint32_t MatchEmpty() const { return Match(kEmpty); }
+        // Empty and deleted are the only control values with the sign bit set
+        uint32_t MatchEmptyOrDeleted() const { return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_)); }
+
+       private:
+        __m128i ctrl_;
+#else
+        explicit Group(const ctrl_t *pos) { std::memcpy(ctrl_, pos, kGroupWidth); }
+        uint32_t Match(ctrl_t tag) const {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < kGroupWidth; ++i) mask |= static_cast<uint32_t>(ctrl_[i] == tag) << i;
+            return mask;
+        }
+        uint32_t MatchEmpty() const { return Match(kEmpty); }
+        uint32_t MatchEmptyOrDeleted() const {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < kGroupWidth; ++i) mask |= static_cast<uint32_t>(!IsFull(ctrl_[i])) << i;
+            return mask;
+        }
+
+       private:
+        ctrl_t ctrl_[kGroupWidth];
+#endif
+    };
+
+    // std::hash of a handle or pointer is usually the identity, which leaves the low bits (where the slot index comes from)
+    // all zero for aligned pointers, so the result is mixed before it is split into slot index and tag.
+    uint64_t HashKey(const Key &key) const {
+        uint64_t hash = static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ULL;
+        return hash ^ (hash >> 32);
+    }
+    static size_t H1(uint64_t hash) { return static_cast<size_t>(hash >> 7); }
+    static ctrl_t H2(uint64_t hash) { return static_cast<ctrl_t>(hash >> 57); }
+
+    // At most 7/8 of the slots may be used (full or deleted), so every probe sequence ends at an empty slot
+    static size_t MaxLoad(size_t capacity) { return capacity - capacity / 8; }
+    static size_t CapacityFor(size_t count) {
+        size_t capacity = kGroupWidth;
+        while (MaxLoad(capacity) < count) capacity *= 2;
+        return capacity;
+    }
+
+    // Returns the slot holding key, or capacity_ if there is none
+    size_t FindIndex(const Key &key, uint64_t hash) const {
+        if (capacity_ == 0) return 0;
+        const size_t mask = capacity_ - 1;
+        const ctrl_t tag = H2(hash);
+        size_t pos = H1(hash) & mask;
+        // Triangular steps over whole groups visit every group once the capacity is a power of two
+        for (size_t step = kGroupWidth;; step += kGroupWidth) {
+            const Group group(ctrl_ + pos);
+            for (uint32_t match = group.Match(tag); match != 0; match &= match - 1) {
+                const size_t index = (pos + CountTrailingZeros(match)) & mask;
+                if (KeyEqual()(keys_[index], key)) return index;
+            }
+            if (group.MatchEmpty() != 0) return capacity_;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    size_t FindFirstNonFull(uint64_t hash) const {
+        const size_t mask = capacity_ - 1;
+        size_t pos = H1(hash) & mask;
+        for (size_t step = kGroupWidth;; step += kGroupWidth) {
+            const uint32_t match = Group(ctrl_ + pos).MatchEmptyOrDeleted();
+            if (match != 0) return (pos + CountTrailingZeros(match)) & mask;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    // Returns {slot, true} with the slot's control byte set but its key and value unconstructed if key was not present,
+    // or {slot of key, false} if it was
+    std::pair<size_t, bool> FindOrPrepareInsert(const Key &key) {
+        const uint64_t hash = HashKey(key);
+        const size_t found = FindIndex(key, hash);
+        if (found != capacity_) return std::make_pair(found, false);
+        if (growth_left_ == 0) {
+            // Mostly tombstones: rebuild at the same size rather than growing
+            Resize((size_ < MaxLoad(capacity_) / 2) ? capacity_ : CapacityFor(size_ + 1));
+        }
+        const size_t index = FindFirstNonFull(hash);
+        if (ctrl_[index] == kEmpty) --growth_left_;
+        SetCtrl(index, H2(hash));
+        ++size_;
+        return std::make_pair(index, true);
+    }
+
+    // Control bytes are padded by one group mirroring the first one, so a group load starting near the end of the table
+    // sees the slots it wraps around to without a bounds check
+    void SetCtrl(size_t index, ctrl_t ctrl) {
+        ctrl_[index] = ctrl;
+        if (index < kGroupWidth) ctrl_[capacity_ + index] = ctrl;
+    }
+
+    void ResetCtrl() {
+        std::memset(ctrl_, static_cast<unsigned char>(kEmpty), capacity_ + kGroupWidth);
+        size_ = 0;
+        growth_left_ = MaxLoad(capacity_);
+    }
+
+    void EraseSlot(size_t index) {
+        assert(index < capacity_ && IsFull(ctrl_[index]));
+        keys_[index].~Key();
+        values_[index].~T();
+        SetCtrl(index, kDeleted);
+        --size_;
+    }
+
+    void DestroySlots() {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (IsFull(ctrl_[i])) {
+                keys_[i].~Key();
+                values_[i].~T();
+            }
+        }
+    }
+
+    size_t NextFull(size_t index) const {
+        while (index < capacity_ && !IsFull(ctrl_[index])) ++index;
+        return index;
+    }
+
+    void Resize(size_t new_capacity) {
+        ctrl_t *old_ctrl = ctrl_;
+        Key *old_keys = keys_;
+        T *old_values = values_;
+        const size_t old_capacity = capacity_;
+
+        capacity_ = new_capacity;
+        ctrl_ = new ctrl_t[capacity_ + kGroupWidth];
+        keys_ = std::allocator<Key>().allocate(capacity_);
+        values_ = std::allocator<T>().allocate(capacity_);
+        ResetCtrl();
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (!IsFull(old_ctrl[i])) continue;
+            const uint64_t hash = HashKey(old_keys[i]);
+            const size_t index = FindFirstNonFull(hash);
+            SetCtrl(index, H2(hash));
+            new (&keys_[index]) Key(std::move(old_keys[i]));
+            new (&values_[index]) T(std::move(old_values[i]));
+            old_keys[i].~Key();
+            old_values[i].~T();
+            ++size_;
+        }
+        growth_left_ -= size_;
+        Deallocate(old_ctrl, old_keys, old_values, old_capacity);
+    }
+
+    static void Deallocate(ctrl_t *ctrl, Key *keys, T *values, size_t capacity) {
+        if (capacity == 0) return;
+        delete[] ctrl;
+        std::allocator<Key>().deallocate(keys, capacity);
+        std::allocator<T>().deallocate(values, capacity);
+    }
+
+    void Swap(FlatHashMap &other) {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(keys_, other.keys_);
+        std::swap(values_, other.values_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growth_left_, other.growth_left_);
+    }
+
+    // What an iterator dereferences to. operator-> returns the proxy itself so that it->second works.
+    template <typename Mapped>
+    struct Reference {
+        const Key &first;
+        Mapped &second;
+        Reference *operator->() { return this; }
+    };
+
+    template <bool kConst>
+    class Iterator {
+        using MapPointer = typename std::conditional<kConst, const FlatHashMap *, FlatHashMap *>::type;
+        using Mapped = typename std::conditional<kConst, const T, T>::type;
+
+       public:
+        using reference = Reference<Mapped>;
+
+        Iterator() : map_(nullptr), index_(0) {}
+        // Allow iterator to const_iterator conversion
+        template <bool kOtherConst, typename = typename std::enable_if<kConst && !kOtherConst>::type>
+        Iterator(const Iterator<kOtherConst> &other) : map_(other.map_), index_(other.index_) {}
+
+        reference operator*() const { return reference{map_->keys_[index_], map_->values_[index_]}; }
+        reference operator->() const { return **this; }
+        Iterator &operator++() {
+            index_ = map_->NextFull(index_ + 1);
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+        friend bool operator==(const Iterator &lhs, const Iterator &rhs) { return lhs.index_ == rhs.index_; }
+        friend bool operator!=(const Iterator &lhs, const Iterator &rhs) { return lhs.index_ != rhs.index_; }
+
+       private:
+        friend class FlatHashMap;
+        friend class Iterator<true>;
+        Iterator(MapPointer map, size_t index) : map_(map), index_(index) {}
+
+        MapPointer map_;
+        size_t index_;
+    };
+
+    ctrl_t *ctrl_ = nullptr;
+    Key *keys_ = nullptr;
+    T *values_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    size_t growth_left_ = 0;
+};
+
+#endif  // FLAT_HASH_MAP_H_
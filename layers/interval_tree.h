@@ -0,0 +1,203 @@
+/* Copyright (c) 2019 The Khronos Group Inc.
+ * Copyright (c) 2019 Valve Corporation
+ * Copyright (c) 2019 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#pragma once
+#ifndef INTERVAL_TREE_H_
+#define INTERVAL_TREE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Set of closed intervals [begin, end], each tagged with a value, supporting lookup of all the intervals that overlap a
+// query interval.
+//
+// The intervals are kept in a treap ordered by (begin, value), with each node also holding the largest end in its subtree.
+// An overlap query only descends into subtrees whose largest end reaches the query begin, and stops to the right of the
+// query end, so it costs O(log n + k) for k overlapping intervals.  Insert and Erase are O(log n) expected.
+//
+// (begin, value) identifies an interval, so the values of intervals with the same begin must differ.  Nodes live in one
+// vector and are linked by index, freed nodes are reused before the vector grows.
+template <typename Index, typename Value, typename Less = std::less<Value>>
+class IntervalTree {
+   public:
+    void Insert(const Index &begin, const Index &end, const Value &value) {
+        assert(begin <= end);
+        const uint32_t node = NewNode(begin, end, value);
+        root_ = Insert(root_, node);
+        ++size_;
+    }
+
+    // Returns whether the interval was found
+    bool Erase(const Index &begin, const Value &value) {
+        bool erased = false;
+        root_ = Erase(root_, begin, value, &erased);
+        if (erased) --size_;
+        return erased;
+    }
+
+    // Call fn(begin, end, value) for each interval overlapping [begin, end], in order.  Returning false from fn stops the
+    // traversal, as does the return value of ForEachOverlap.
+    template <typename Fn>
+    bool ForEachOverlap(const Index &begin, const Index &end, Fn &&fn) const {
+        return ForEachOverlap(root_, begin, end, fn);
+    }
+
+    void clear() {
+        nodes_.clear();
+        root_ = kNull;
+        free_ = kNull;
+        size_ = 0;
+    }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    IntervalTree() : root_(kNull), free_(kNull), size_(0), seed_(0x9E3779B9U) {}
+
+   private:
+    static const uint32_t kNull = UINT32_MAX;
+
+    struct Node {
+        Index begin;
+        Index end;
+        Index max_end;  // Of this node and its subtrees
+        Value value;
+        uint32_t priority;
+        uint32_t left;
+        uint32_t right;  // Doubles as the next link of the free list
+    };
+
+    uint32_t NewNode(const Index &begin, const Index &end, const Value &value) {
+        // xorshift is plenty to keep the treap balanced
+        seed_ ^= seed_ << 13;
+        seed_ ^= seed_ >> 17;
+        seed_ ^= seed_ << 5;
+        Node node = {begin, end, end, value, seed_, kNull, kNull};
+        uint32_t index;
+        if (free_ != kNull) {
+            index = free_;
+            free_ = nodes_[index].right;
+            nodes_[index] = node;
+        } else {
+            index = static_cast<uint32_t>(nodes_.size());
+            nodes_.push_back(node);
+        }
+        return index;
+    }
+
+    void FreeNode(uint32_t index) {
+        nodes_[index].right = free_;
+        free_ = index;
+    }
+
+    bool KeyLess(const Index &begin, const Value &value, const Node &node) const {
+        return (begin < node.begin) || (!(node.begin < begin) && Less()(value, node.value));
+    }
+
+    void Update(uint32_t index) {
+        Node &node = nodes_[index];
+        node.max_end = node.end;
+        if ((node.left != kNull) && (node.max_end < nodes_[node.left].max_end)) node.max_end = nodes_[node.left].max_end;
+        if ((node.right != kNull) && (node.max_end < nodes_[node.right].max_end)) node.max_end = nodes_[node.right].max_end;
+    }
+
+    uint32_t RotateRight(uint32_t index) {
+        const uint32_t left = nodes_[index].left;
+        nodes_[index].left = nodes_[left].right;
+        nodes_[left].right = index;
+        Update(index);
+        Update(left);
+        return left;
+    }
+
+    uint32_t RotateLeft(uint32_t index) {
+        const uint32_t right = nodes_[index].right;
+        nodes_[index].right = nodes_[right].left;
+        nodes_[right].left = index;
+        Update(index);
+        Update(right);
+        return right;
+    }
+
+    uint32_t Insert(uint32_t root, uint32_t node) {
+        if (root == kNull) return node;
+        if (KeyLess(nodes_[node].begin, nodes_[node].value, nodes_[root])) {
+            const uint32_t left = Insert(nodes_[root].left, node);
+            nodes_[root].left = left;
+            if (nodes_[left].priority > nodes_[root].priority) return RotateRight(root);
+        } else {
+            const uint32_t right = Insert(nodes_[root].right, node);
+            nodes_[root].right = right;
+            if (nodes_[right].priority > nodes_[root].priority) return RotateLeft(root);
+        }
+        Update(root);
+        return root;
+    }
+
+    // Join two treaps, all of whose keys in left are less than those in right
+    uint32_t Merge(uint32_t left, uint32_t right) {
+        if (left == kNull) return right;
+        if (right == kNull) return left;
+        if (nodes_[left].priority > nodes_[right].priority) {
+            nodes_[left].right = Merge(nodes_[left].right, right);
+            Update(left);
+            return left;
+        }
+        nodes_[right].left = Merge(left, nodes_[right].left);
+        Update(right);
+        return right;
+    }
+
+    uint32_t Erase(uint32_t root, const Index &begin, const Value &value, bool *erased) {
+        if (root == kNull) return root;
+        Node &node = nodes_[root];
+        if (KeyLess(begin, value, node)) {
+            const uint32_t left = Erase(node.left, begin, value, erased);
+            nodes_[root].left = left;
+        } else if (!(node.begin < begin) && !Less()(node.value, value)) {
+            const uint32_t merged = Merge(node.left, node.right);
+            FreeNode(root);
+            *erased = true;
+            return merged;
+        } else {
+            const uint32_t right = Erase(node.right, begin, value, erased);
+            nodes_[root].right = right;
+        }
+        Update(root);
+        return root;
+    }
+
+    template <typename Fn>
+    bool ForEachOverlap(uint32_t root, const Index &begin, const Index &end, Fn &fn) const {
+        if ((root == kNull) || (nodes_[root].max_end < begin)) return true;  // Nothing in this subtree reaches begin
+        const Node &node = nodes_[root];
+        if (!ForEachOverlap(node.left, begin, end, fn)) return false;
+        if (end < node.begin) return true;  // Nor does anything to the right start before end
+        if (!(node.end < begin) && !fn(node.begin, node.end, node.value)) return false;
+        return ForEachOverlap(node.right, begin, end, fn);
+    }
+
+    std::vector<Node> nodes_;
+    uint32_t root_;
+    uint32_t free_;
+    size_t size_;
+    uint32_t seed_;
+};
+
+#endif  // INTERVAL_TREE_H_
@@ -85,6 +85,9 @@ class ObjectLifetimes : public ValidationObject {
     // Constructor for object lifetime tracking
     ObjectLifetimes() : num_objects{}, num_total_objects(0), object_map{} { object_map.resize(kVulkanObjectTypeMax + 1); }
 
+    // Object lifetime tracking records nothing for vkCmd* calls, so their record phase does not need the exclusive lock
+    cb_lock_guard_t cb_write_lock(VkCommandBuffer command_buffer) { return cb_lock_guard_t(read_lock()); }
+
     bool DeviceReportUndestroyedObjects(VkDevice device, VulkanObjectType object_type, const std::string &error_code);
     void DeviceDestroyUndestroyedObjects(VkDevice device, VulkanObjectType object_type);
     void CreateQueue(VkDevice device, VkQueue vkObj);
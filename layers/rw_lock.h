@@ -0,0 +1,126 @@
+/* Copyright (c) 2019 The Khronos Group Inc.
+ * Copyright (c) 2019 Valve Corporation
+ * Copyright (c) 2019 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#pragma once
+#ifndef RW_LOCK_H_
+#define RW_LOCK_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Reader/writer mutex for the validation objects.
+//
+// std::shared_mutex is not available in C++11, so this provides the subset of its interface the layers need. An uncontended
+// acquire, shared or exclusive, is a single atomic operation, as is a shared release when no writer waits. An exclusive
+// release always takes the mutex to wake any sleepers; the mutex and condition variables are otherwise only used to sleep.
+// Writers are preferred: once a writer is waiting, new readers block until it has run, so a steady stream of PreCallValidate
+// calls on other threads cannot starve state recording.
+class ReadWriteMutex {
+   public:
+    ReadWriteMutex() : state_(0), waiting_writers_(0) {}
+    ReadWriteMutex(const ReadWriteMutex &) = delete;
+    ReadWriteMutex &operator=(const ReadWriteMutex &) = delete;
+
+    void lock() {
+        waiting_writers_.fetch_add(1);
+        for (;;) {
+            uint32_t expected = 0;
+            if (state_.compare_exchange_weak(expected, kWriter)) break;
+            std::unique_lock<std::mutex> guard(mutex_);
+            writer_cv_.wait(guard, [this] { return state_.load() == 0; });
+        }
+        waiting_writers_.fetch_sub(1);
+    }
+
+    void unlock() {
+        state_.store(0);
+        std::lock_guard<std::mutex> guard(mutex_);
+        writer_cv_.notify_one();
+        reader_cv_.notify_all();
+    }
+
+    void lock_shared() {
+        for (;;) {
+            uint32_t current = state_.load();
+            if (ReaderMayEnter(current)) {
+                if (state_.compare_exchange_weak(current, current + 1)) return;
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(mutex_);
+            reader_cv_.wait(guard, [this] { return ReaderMayEnter(state_.load()); });
+        }
+    }
+
+    void unlock_shared() {
+        const uint32_t remaining = state_.fetch_sub(1) - 1;
+        if ((remaining == 0) && (waiting_writers_.load() > 0)) {
+            std::lock_guard<std::mutex> guard(mutex_);
+            writer_cv_.notify_one();
+        }
+    }
+
+   private:
+    static const uint32_t kWriter = 0x80000000u;  // Set while a writer holds the lock, otherwise state_ is the reader count
+
+    bool ReaderMayEnter(uint32_t state) const { return ((state & kWriter) == 0) && (waiting_writers_.load() == 0); }
+
+    std::atomic<uint32_t> state_;
+    std::atomic<uint32_t> waiting_writers_;
+    std::mutex mutex_;
+    std::condition_variable reader_cv_;
+    std::condition_variable writer_cv_;
+};
+
+enum class LockMode { kNone, kShared, kExclusive };
+
+// Scoped lock on a ReadWriteMutex. The mode is chosen at construction so that a validation object can decide at runtime
+// whether a given chassis phase is shared, exclusive, or (for objects that do their own locking) not locked at all.
+class ReadWriteLockGuard {
+   public:
+    ReadWriteLockGuard(ReadWriteMutex &mutex, LockMode mode) : mutex_(&mutex), mode_(mode) {
+        if (mode_ == LockMode::kShared) {
+            mutex_->lock_shared();
+        } else if (mode_ == LockMode::kExclusive) {
+            mutex_->lock();
+        }
+    }
+    ReadWriteLockGuard(ReadWriteLockGuard &&other) : mutex_(other.mutex_), mode_(other.mode_) { other.mode_ = LockMode::kNone; }
+    ReadWriteLockGuard(const ReadWriteLockGuard &) = delete;
+    ReadWriteLockGuard &operator=(const ReadWriteLockGuard &) = delete;
+    ~ReadWriteLockGuard() { unlock(); }
+
+    void unlock() {
+        if (mode_ == LockMode::kShared) {
+            mutex_->unlock_shared();
+        } else if (mode_ == LockMode::kExclusive) {
+            mutex_->unlock();
+        }
+        mode_ = LockMode::kNone;
+    }
+    bool owns_lock() const { return mode_ != LockMode::kNone; }
+
+   private:
+    ReadWriteMutex *mutex_;
+    LockMode mode_;
+};
+
+using read_lock_guard_t = ReadWriteLockGuard;
+using write_lock_guard_t = ReadWriteLockGuard;
+
+#endif  // RW_LOCK_H_
@@ -19,6 +19,7 @@
  * Author: Dave Houlton <daveh@lunarg.com>
  */
 
+#include <algorithm>
 #include <cinttypes>
 #include <cassert>
 #include <chrono>
@@ -2561,8 +2562,13 @@ bool CoreChecks::ValidatePipelineShaderStage(VkPipelineShaderStageCreateInfo con
     // Validate descriptor use
     for (auto use : descriptor_uses) {
         // While validating shaders capture which slots are used by the pipeline
-        auto &reqs = pipeline->active_slots[use.first.first][use.first.second];
-        reqs = descriptor_req(reqs | DescriptorTypeToReqs(module, use.second.type_id));
+        auto &slot_reqs = pipeline->active_slots[use.first.first];
+        auto reqs = std::lower_bound(slot_reqs.begin(), slot_reqs.end(), use.first.second,
+                                     [](const BindingReqMap::value_type &req, uint32_t binding) { return req.first < binding; });
+        if ((reqs == slot_reqs.end()) || (reqs->first != use.first.second)) {
+            reqs = slot_reqs.emplace(reqs, use.first.second, descriptor_req(0));
+        }
+        reqs->second = descriptor_req(reqs->second | DescriptorTypeToReqs(module, use.second.type_id));
 
         // Verify given pipelineLayout has requested setLayout with requested binding
         const auto &binding = GetDescriptorBinding(&pipeline->pipeline_layout, use.first);
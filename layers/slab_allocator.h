@@ -0,0 +1,183 @@
+/* Copyright (c) 2019 The Khronos Group Inc.
+ * Copyright (c) 2019 Valve Corporation
+ * Copyright (c) 2019 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#pragma once
+#ifndef SLAB_ALLOCATOR_H_
+#define SLAB_ALLOCATOR_H_
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+// AddressSanitizer can only catch use-after-free of state objects that go back to the system allocator
+#if defined(__SANITIZE_ADDRESS__)
+#define SLAB_ALLOCATOR_DISABLED
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define SLAB_ALLOCATOR_DISABLED
+#endif
+#endif
+
+// Fixed size allocator for one type of state object.
+//
+// Storage is carved out of slabs of many objects and recycled through free lists: each thread keeps a small cache of free
+// slots that it allocates from and frees to without locking, and exchanges batches of slots with a shared depot when the
+// cache runs dry or grows too large. Slabs are never returned to the system, so the memory held is the peak number of
+// live objects of the type; create/destroy churn after that point never reaches malloc.
+template <typename T>
+class SlabAllocator {
+   public:
+    static void *Allocate() {
+        ThreadCache &cache = GetThreadCache();
+        if (cache.exited) return GetDepot().TakeOne();
+        if (cache.head == nullptr) GetDepot().TakeBatch(cache);
+        FreeSlot *slot = cache.head;
+        cache.head = slot->next;
+        --cache.count;
+        return slot;
+    }
+
+    static void Free(void *p) {
+        FreeSlot *slot = static_cast<FreeSlot *>(p);
+        ThreadCache &cache = GetThreadCache();
+        if (cache.exited) {
+            GetDepot().Put(slot, slot);
+            return;
+        }
+        slot->next = cache.head;
+        cache.head = slot;
+        if (++cache.count >= 2 * kBatchSize) {
+            // Keep one batch so that alternating create and destroy doesn't bounce slots back and forth
+            FreeSlot *last = cache.head;
+            for (size_t i = 1; i < kBatchSize; ++i) last = last->next;
+            FreeSlot *first = cache.head;
+            cache.head = last->next;
+            cache.count -= kBatchSize;
+            GetDepot().Put(first, last);
+        }
+    }
+
+   private:
+    static_assert(alignof(T) <= alignof(std::max_align_t), "SlabAllocator does not support over-aligned types");
+
+    union FreeSlot {
+        FreeSlot *next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static const size_t kBatchSize = 32;
+    static const size_t kSlabBytes = 64 * 1024;
+    static const size_t kSlotsPerSlab = (sizeof(FreeSlot) < kSlabBytes / kBatchSize) ? kSlabBytes / sizeof(FreeSlot) : kBatchSize;
+
+    // Trivially destructible, so that it is still usable by objects freed during thread or process teardown after the
+    // flusher below has returned its slots to the depot
+    struct ThreadCache {
+        FreeSlot *head;
+        size_t count;
+        bool registered;
+        bool exited;
+    };
+
+    struct ThreadCacheFlusher {
+        ThreadCache *cache;
+        ~ThreadCacheFlusher() {
+            if (cache->head) {
+                FreeSlot *last = cache->head;
+                while (last->next) last = last->next;
+                GetDepot().Put(cache->head, last);
+            }
+            cache->head = nullptr;
+            cache->count = 0;
+            cache->exited = true;
+        }
+    };
+
+    static ThreadCache &GetThreadCache() {
+        static thread_local ThreadCache cache = {nullptr, 0, false, false};
+        if (!cache.registered) {
+            cache.registered = true;
+            static thread_local ThreadCacheFlusher flusher = {&cache};
+            (void)flusher;
+        }
+        return cache;
+    }
+
+    class Depot {
+       public:
+        void TakeBatch(ThreadCache &cache) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (head_ == nullptr) AddSlab();
+            FreeSlot *last = head_;
+            size_t count = 1;
+            for (; (count < kBatchSize) && last->next; ++count) last = last->next;
+            cache.head = head_;
+            cache.count = count;
+            head_ = last->next;
+            last->next = nullptr;
+        }
+
+        FreeSlot *TakeOne() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (head_ == nullptr) AddSlab();
+            FreeSlot *slot = head_;
+            head_ = slot->next;
+            return slot;
+        }
+
+        void Put(FreeSlot *first, FreeSlot *last) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last->next = head_;
+            head_ = first;
+        }
+
+       private:
+        void AddSlab() {
+            FreeSlot *slab = static_cast<FreeSlot *>(::operator new(kSlotsPerSlab * sizeof(FreeSlot)));
+            for (size_t i = 0; i < kSlotsPerSlab - 1; ++i) slab[i].next = &slab[i + 1];
+            slab[kSlotsPerSlab - 1].next = nullptr;
+            head_ = slab;
+        }
+
+        std::mutex mutex_;
+        FreeSlot *head_ = nullptr;
+    };
+
+    // Deliberately leaked: state objects may still be freed by other static destructors at process exit
+    static Depot &GetDepot() {
+        static Depot *depot = new Depot;
+        return *depot;
+    }
+};
+
+// Base for state classes that should be allocated from a SlabAllocator. Classes derived further from T have a different
+// size and go to the global allocator instead.
+template <typename T>
+class SlabAllocated {
+   public:
+#if !defined(SLAB_ALLOCATOR_DISABLED)
+    static void *operator new(size_t size) { return (size == sizeof(T)) ? SlabAllocator<T>::Allocate() : ::operator new(size); }
+    static void operator delete(void *p, size_t size) {
+        if (size == sizeof(T)) {
+            SlabAllocator<T>::Free(p);
+        } else {
+            ::operator delete(p);
+        }
+    }
+#endif
+};
+
+#endif  // SLAB_ALLOCATOR_H_
@@ -21,9 +21,13 @@
 #ifndef SPARSE_CONTAINERS_H_
 #define SPARSE_CONTAINERS_H_
 #define NOMINMAX
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace sparse_container {
@@ -59,10 +63,22 @@ namespace sparse_container {
 //
 // In "Dense access" mode, values are  stored in a vector the size of
 // the valid range indexed by the incoming index value minus range_min_.
-// The same upate semantic applies bases on kSetReplaces.
+// The same upate semantic applies bases on kSetReplaces.  With
+// kSetReplaces==true, a full range SetRange on a vector that started in
+// "Sparse access" mode converts it back to that mode, with the value as
+// the full range value.
 //
 // Note that when kSparseThreshold
 //
+// With kRangeAccess==true, "Range access" mode takes the place of
+// "Sparse access" mode.  Non-default values are stored as runs
+// [begin, end) -> value in an ordered map keyed by begin.  Writes
+// merge runs with equal, adjacent neighbors, s.t. SetRange and Merge
+// cost is proportional to the number of runs touched rather than the
+// number of indices.  The vector is converted to "Dense access" mode
+// when it holds more than 1/kConversionThreshold as many runs as
+// indices.
+//
 // Access:
 //
 // NOTE all "end" indices (in construction or access) are *exclusive*.
@@ -83,10 +99,16 @@ namespace sparse_container {
 // the iterator a bit more complexity than is optimal, but hides the
 // underlying complexity from the callers.
 //
+// GetRun supports traversal by run instead of by index.  It returns
+// the value at an index and lowers a caller supplied limit to the end
+// of the run of that value, which is exact in "Range access" mode and
+// a lower bound in the other modes.
+//
 // TODO: Update iterator to use a reference (likely using
 // reference_wrapper...)
 
-template <typename IndexType_, typename T, bool kSetReplaces, T kDefaultValue = T(), size_t kSparseThreshold = 16>
+template <typename IndexType_, typename T, bool kSetReplaces, T kDefaultValue = T(), size_t kSparseThreshold = 16,
+          bool kRangeAccess = false>
 class SparseVector {
    public:
     typedef IndexType_ IndexType;
@@ -94,6 +116,7 @@ class SparseVector {
     typedef value_type ValueType;
     typedef std::unordered_map<IndexType, ValueType> SparseType;
     typedef std::vector<ValueType> DenseType;
+    typedef std::map<IndexType, std::pair<IndexType, ValueType>> RangeType;  // begin -> {end, value}
 
     SparseVector(IndexType start, IndexType end)
         : range_min_(start), range_max_(end), threshold_((end - start) / kConversionThreshold) {
@@ -101,25 +124,32 @@ class SparseVector {
         Reset();
     }
 
-    // Initial access mode is set based on range size vs. kSparseThreshold.  Either sparse_ or dense_ is always set, but only
-    // ever one at a time
+    // Initial access mode is set based on range size vs. kSparseThreshold.  One of sparse_, ranges_, or dense_ is always set,
+    // but only ever one at a time
     void Reset() {
         has_full_range_value_ = false;
         full_range_value_ = kDefaultValue;
-        size_t count = range_max_ - range_min_;
-        if (kSparseThreshold && (count > kSparseThreshold)) {
-            sparse_.reset(new SparseType());
-            dense_.reset();
+        sparse_.reset();
+        ranges_.reset();
+        dense_.reset();
+        if (StartsSparse()) {
+            if (kRangeAccess) {
+                ranges_.reset(new RangeType());
+            } else {
+                sparse_.reset(new SparseType());
+            }
         } else {
-            sparse_.reset();
-            dense_.reset(new DenseType(count, kDefaultValue));
+            dense_.reset(new DenseType(range_max_ - range_min_, kDefaultValue));
         }
     }
 
     const ValueType &Get(const IndexType index) const {
-        // Note that here (and similarly below, the 'IsSparse' clause is
+        // Note that here (and similarly below, the 'IsSparse' and 'IsRange' clauses are
         // eliminated as dead code in release builds if kSparseThreshold==0
-        if (IsSparse()) {
+        if (IsRange()) {
+            auto it = FindRange(index);
+            return (it != ranges_->cend()) ? it->second.second : DefaultValue();
+        } else if (IsSparse()) {
             if (!sparse_->empty()) {  // Don't attempt lookup in empty map
                 auto it = sparse_->find(index);
                 if (it != sparse_->cend()) {
@@ -137,10 +167,41 @@ class SparseVector {
         }
     }
 
+    // As Get, additionally lowering *run_end (which the caller sets to the limit of interest) to the end of the run of equal
+    // values starting at index
+    const ValueType &GetRun(const IndexType index, IndexType *run_end) const {
+        if (IsRange()) {
+            auto it = ranges_->upper_bound(index);
+            if (it != ranges_->cbegin()) {
+                auto prev = std::prev(it);
+                if (index < prev->second.first) {
+                    *run_end = std::min(*run_end, prev->second.first);
+                    return prev->second.second;
+                }
+            }
+            // In a gap, which lasts until the next run
+            if (it != ranges_->cend()) *run_end = std::min(*run_end, it->first);
+            return DefaultValue();
+        } else if (IsSparse()) {
+            // Without subranges the full range value (or kDefaultValue) applies throughout
+            if (HasSparseSubranges()) *run_end = std::min(*run_end, index + 1);
+            return Get(index);
+        }
+        assert(dense_.get());
+        const DenseType &ray = *dense_;
+        const ValueType &value = ray[index - range_min_];
+        IndexType next = index + 1;
+        while ((next < *run_end) && (ray[next - range_min_] == value)) ++next;
+        *run_end = std::min(*run_end, next);
+        return value;
+    }
+
     // Set a indexes value, based on the access mode, update semantics are enforced within the access mode specific function
     bool Set(const IndexType index, const ValueType &value) {
         bool updated = false;
-        if (IsSparse()) {
+        if (IsRange()) {
+            updated = SetRanged(index, index + 1, value);
+        } else if (IsSparse()) {
             updated = SetSparse(index, value);
         } else {
             assert(dense_.get());
@@ -152,7 +213,9 @@ class SparseVector {
     // Set a range of values based on access mode, with some update semantics applied a the range level
     bool SetRange(const IndexType start, IndexType end, ValueType value) {
         bool updated = false;
-        if (IsSparse()) {
+        if (IsRange()) {
+            updated = SetRanged(start, end, value);
+        } else if (IsSparse()) {
             if (!kSetReplaces && HasFullRange()) return false;  // We have full coverage, we can change this no more
 
             bool is_full_range = IsFullRange(start, end);
@@ -184,11 +247,27 @@ class SparseVector {
                     updated |= Set(index, value);
                 }
             }
+        } else if (kSetReplaces && IsFullRange(start, end) && StartsSparse()) {
+            // A full range replacement makes the dense copy redundant, so go back to the compact representation
+            assert(dense_);
+            for (const auto &current : *dense_) {
+                if (current != value) {
+                    updated = true;
+                    break;
+                }
+            }
+            Reset();
+            if (IsRange()) {
+                if (value != kDefaultValue) ranges_->emplace(range_min_, std::make_pair(range_max_, value));
+            } else {
+                full_range_value_ = value;
+                has_full_range_value_ = value != kDefaultValue;
+            }
         } else {
             // Note that "Dense Access" does away with the full_range_value_ logic, storing empty entries using kDefaultValue
             assert(dense_);
             for (IndexType index = start; index < end; ++index) {
-                updated = SetDense(index, value);
+                updated |= SetDense(index, value);
             }
         }
         return updated;
@@ -199,7 +278,11 @@ class SparseVector {
         // Must not set from Sparse arracy with larger bounds...
         assert((range_min_ <= from.range_min_) && (range_max_ >= from.range_max_));
         bool updated = false;
-        if (from.IsSparse()) {
+        if (from.IsRange()) {
+            for (const auto &run : *from.ranges_) {
+                updated |= SetRange(run.first, run.second.first, run.second.second);
+            }
+        } else if (from.IsSparse()) {
             if (from.HasFullRange() && !from.HasSparseSubranges()) {
                 // Short cut to copy a full range if that's all we have
                 updated |= SetRange(from.range_min_, from.range_max_, from.full_range_value_);
@@ -209,17 +292,24 @@ class SparseVector {
                 for (auto it = from.cbegin(); it != from.cend(); ++it) {
                     const IndexType index = (*it).first;
                     const ValueType &value = (*it).second;
-                    Set(index, value);
+                    updated |= Set(index, value);
                 }
             }
         } else {
             assert(from.dense_);
-            DenseType &ray = *from.dense_;
-            for (IndexType entry = from.range_min_; entry < from.range_max_; ++entry) {
-                IndexType index = entry - from.range_min_;
-                if (ray[index] != kDefaultValue) {
-                    updated |= Set(entry, ray[index]);
+            const DenseType &ray = *from.dense_;
+            // Apply runs of matching values with SetRange, s.t. a run covering the full range gets the sparse short cut
+            IndexType run_start = from.range_min_;
+            while (run_start < from.range_max_) {
+                const ValueType &value = ray[run_start - from.range_min_];
+                IndexType run_end = run_start + 1;
+                while ((run_end < from.range_max_) && (ray[run_end - from.range_min_] == value)) {
+                    ++run_end;
                 }
+                if (value != kDefaultValue) {
+                    updated |= SetRange(run_start, run_end, value);
+                }
+                run_start = run_end;
             }
         }
         return updated;
@@ -236,7 +326,15 @@ class SparseVector {
         const IteratorValueType &operator*() const { return current_value_; }
 
         ConstIterator &operator++() {
-            if (delegated_) {  // implies sparse
+            if (ranged_) {
+                ++index_;
+                if (index_ >= it_range_->second.first) {
+                    ++it_range_;
+                    SetRangeValue();
+                } else {
+                    current_value_.first = index_;
+                }
+            } else if (delegated_) {  // implies sparse
                 ++it_sparse_;
                 if (it_sparse_ == vec_->sparse_->cend()) {
                     the_end_ = true;
@@ -260,15 +358,22 @@ class SparseVector {
             return (the_end_ == rhs.the_end_);  // Just good enough for cend checks
         }
 
-        // The iterator has two modes:
+        // The iterator has three modes:
+        //     ranged:
+        //         where we are in range access mode, and step through the
+        //         indices of each run in turn
         //     delegated:
         //         where we are in sparse access mode and have no full_range_value
         //         and thus can delegate our iteration to underlying map
         //     non-delegated:
         //         either dense mode or we have a full range value and thus
         //         must iterate over the whole range
-        ConstIterator(const SparseVector &vec) : vec_(&vec) {
-            if (!vec_->IsSparse() || vec_->HasFullRange()) {
+        ConstIterator(const SparseVector &vec) : vec_(&vec), ranged_(false), delegated_(false) {
+            if (vec_->IsRange()) {
+                ranged_ = true;
+                it_range_ = vec_->ranges_->cbegin();
+                SetRangeValue();
+            } else if (!vec_->IsSparse() || vec_->HasFullRange()) {
                 // Must iterated over entire ranges skipping (in the case of dense access), invalid entries
                 delegated_ = false;
                 index_ = vec_->range_min_;
@@ -286,18 +391,33 @@ class SparseVector {
             }
         }
 
-        ConstIterator() : vec_(nullptr), the_end_(true) {}
+        ConstIterator() : vec_(nullptr), the_end_(true), ranged_(false), delegated_(false) {}
 
        protected:
         const SparseVector *vec_;
         bool the_end_;
         SparseIterator it_sparse_;
+        typename RangeType::const_iterator it_range_;
+        bool ranged_;
         bool delegated_;
         IndexType index_;
         ValueType value_;
 
         IteratorValueType current_value_;
 
+        // in the ranged case, move to the start of the run it_range_ points to
+        void SetRangeValue() {
+            if (it_range_ == vec_->ranges_->cend()) {
+                the_end_ = true;
+                index_ = vec_->range_max_;
+                current_value_ = IteratorValueType(index_, SparseVector::DefaultValue());
+            } else {
+                the_end_ = false;
+                index_ = it_range_->first;
+                current_value_ = IteratorValueType(index_, it_range_->second.second);
+            }
+        }
+
         // in the non-delegated case we use normal accessors and skip default values.
         void SetCurrentValue() {
             the_end_ = true;
@@ -331,6 +451,9 @@ class SparseVector {
     ValueType full_range_value_;
     std::unique_ptr<SparseType> sparse_;
 
+    // Data for range mode
+    std::unique_ptr<RangeType> ranges_;
+
     // Data for dense mode
     std::unique_ptr<DenseType> dense_;
 
@@ -338,13 +461,124 @@ class SparseVector {
         static ValueType value = kDefaultValue;
         return value;
     }
-    // Note that IsSparse is compile-time reducible if kSparseThreshold is zero...
-    inline bool IsSparse() const { return kSparseThreshold && sparse_.get(); }
+    // Note that IsSparse and IsRange are compile-time reducible if kSparseThreshold is zero...
+    inline bool IsSparse() const { return kSparseThreshold && !kRangeAccess && sparse_.get(); }
+    inline bool IsRange() const { return kSparseThreshold && kRangeAccess && ranges_.get(); }
+    // Whether Reset() picks sparse (or range) access for this range
+    bool StartsSparse() const { return kSparseThreshold && ((range_max_ - range_min_) > kSparseThreshold); }
     bool IsFullRange(IndexType start, IndexType end) const { return (start == range_min_) && (end == range_max_); }
     bool IsFullRangeValue(const ValueType &value) const { return has_full_range_value_ && (value == full_range_value_); }
     bool HasFullRange() const { return IsSparse() && has_full_range_value_; }
     bool HasSparseSubranges() const { return IsSparse() && !sparse_->empty(); }
 
+    // The run containing index, if any
+    typename RangeType::const_iterator FindRange(IndexType index) const {
+        auto it = ranges_->upper_bound(index);
+        if (it != ranges_->cbegin()) {
+            auto prev = std::prev(it);
+            if (index < prev->second.first) return prev;
+        }
+        return ranges_->cend();
+    }
+
+    // The first run ending after index
+    typename RangeType::iterator FirstRangeAfter(IndexType index) {
+        auto it = ranges_->upper_bound(index);
+        if (it != ranges_->begin()) {
+            auto prev = std::prev(it);
+            if (index < prev->second.first) return prev;
+        }
+        return it;
+    }
+
+    // Add a run over indices that have no run, merging with equal valued neighbors
+    void InsertRange(IndexType start, IndexType end, const ValueType &value) {
+        RangeType &ranges = *ranges_;
+        auto next = ranges.lower_bound(start);
+        if ((next != ranges.end()) && (next->first == end) && (next->second.second == value)) {
+            end = next->second.first;
+            next = ranges.erase(next);
+        }
+        if (next != ranges.begin()) {
+            auto prev = std::prev(next);
+            if ((prev->second.first == start) && (prev->second.second == value)) {
+                prev->second.first = end;
+                return;
+            }
+        }
+        ranges.emplace_hint(next, start, std::make_pair(end, value));
+    }
+
+    // Range access mode setter with update semantics implemented
+    bool SetRanged(IndexType start, IndexType end, const ValueType &value) {
+        bool updated = false;
+        if (kSetReplaces) {
+            // Skip the rewrite if the runs already say the same thing
+            IndexType covered = start;
+            for (auto it = FirstRangeAfter(start); (it != ranges_->end()) && (it->first < end); ++it) {
+                if ((it->second.second != value) || ((value != kDefaultValue) && (it->first > covered))) {
+                    updated = true;
+                    break;
+                }
+                covered = it->second.first;
+            }
+            if (!updated && (value != kDefaultValue) && (covered < end)) updated = true;
+            if (!updated) return false;
+
+            // Trim the runs overlapping [start, end), keeping the parts outside of it
+            RangeType &ranges = *ranges_;
+            auto it = FirstRangeAfter(start);
+            if ((it != ranges.end()) && (it->first < start)) {
+                const IndexType run_end = it->second.first;
+                it->second.first = start;
+                if (run_end > end) ranges.emplace(end, std::make_pair(run_end, it->second.second));
+                ++it;
+            }
+            while ((it != ranges.end()) && (it->first < end)) {
+                if (it->second.first > end) {
+                    auto tail = std::make_pair(it->second.first, it->second.second);
+                    it = ranges.erase(it);
+                    ranges.emplace_hint(it, end, tail);
+                    break;
+                }
+                it = ranges.erase(it);
+            }
+            if (value != kDefaultValue) InsertRange(start, end, value);
+        } else if (value != kDefaultValue) {
+            // Only fill the gaps between existing runs
+            IndexType index = start;
+            while (index < end) {
+                auto it = FirstRangeAfter(index);
+                if ((it == ranges_->end()) || (it->first >= end)) {
+                    InsertRange(index, end, value);
+                    updated = true;
+                    break;
+                }
+                const IndexType run_start = it->first;
+                const IndexType run_end = it->second.first;  // InsertRange may merge (and erase) *it
+                if (run_start > index) {
+                    InsertRange(index, run_start, value);
+                    updated = true;
+                }
+                index = run_end;
+            }
+        }
+        if (updated) RangeToDenseConversion();
+        return updated;
+    }
+
+    // Like SparseToDenseConversion, for range access
+    void RangeToDenseConversion() {
+        if (IsRange() && (ranges_->size() > threshold_)) {
+            dense_.reset(new DenseType((range_max_ - range_min_), kDefaultValue));
+            DenseType &ray = *dense_;
+            for (const auto &run : *ranges_) {
+                std::fill(ray.begin() + (run.first - range_min_), ray.begin() + (run.second.first - range_min_), run.second.second);
+            }
+            ranges_.reset();
+        }
+    }
+
     // This is called unconditionally, to encapsulate the conversion criteria and logic here
     void SparseToDenseConversion() {
         // If we're using more threshold of the sparse range, convert to dense_
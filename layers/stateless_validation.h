@@ -90,8 +90,9 @@ class StatelessValidation : public ValidationObject {
     VkPhysicalDeviceFeatures physical_device_features = {};
 
     // Override chassis read/write locks for this validation object
-    // This override takes a deferred lock. i.e. it is not acquired.
-    std::unique_lock<std::mutex> write_lock() { return std::unique_lock<std::mutex>(validation_object_mutex, std::defer_lock); }
+    // These overrides do not acquire the lock; stateless validation guards its few shared tables itself.
+    read_lock_guard_t read_lock() { return read_lock_guard_t(validation_object_mutex, LockMode::kNone); }
+    write_lock_guard_t write_lock() { return write_lock_guard_t(validation_object_mutex, LockMode::kNone); }
 
     // Device extension properties -- storing properties gathered from VkPhysicalDeviceProperties2KHR::pNext chain
     struct DeviceExtensionProperties {
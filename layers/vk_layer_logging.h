@@ -962,6 +962,13 @@ static inline int vasprintf(char **strp, char const *fmt, va_list ap) {
 }
 #endif
 
+// Number of log_msg calls made on the calling thread, wanted or not, so that a check can tell whether it logged anything
+// without counting the messages of checks running on other threads
+inline uint64_t &ThreadLogMessageCount() {
+    static thread_local uint64_t count = 0;
+    return count;
+}
+
 // Output log message via DEBUG_REPORT. Takes format and variable arg list so that output string is only computed if a message
 // needs to be logged
 #ifndef WIN32
@@ -972,6 +979,7 @@ static inline bool log_msg(const debug_report_data *debug_data, VkFlags msg_flag
 static inline bool log_msg(const debug_report_data *debug_data, VkFlags msg_flags, VkDebugReportObjectTypeEXT object_type,
                            uint64_t src_object, std::string vuid_text, const char *format, ...) {
     if (!debug_data) return false;
+    ThreadLogMessageCount()++;
     std::unique_lock<std::mutex> lock(debug_data->debug_report_mutex);
     VkFlags local_severity = 0;
     VkFlags local_type = 0;
@@ -0,0 +1,109 @@
+/* Copyright (c) 2019 The Khronos Group Inc.
+ * Copyright (c) 2019 Valve Corporation
+ * Copyright (c) 2019 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#pragma once
+#ifndef WORKER_POOL_H_
+#define WORKER_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads for splitting a large validation loop across cores.
+//
+// Run(task_count, task) calls task(i) once for each i in [0, task_count), on the pool threads and the calling thread, and
+// returns when all of the calls have finished.  The pool runs one job at a time; a Run that finds it busy calls all of the
+// tasks on the calling thread instead of waiting.  Tasks must not call Run.
+class WorkerPool {
+   public:
+    explicit WorkerPool(uint32_t thread_count)
+        : task_(nullptr), task_count_(0), next_task_(0), generation_(0), busy_workers_(0), exit_(false) {
+        for (uint32_t i = 0; i < thread_count; ++i) threads_.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            exit_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto &thread : threads_) thread.join();
+    }
+
+    uint32_t ThreadCount() const { return static_cast<uint32_t>(threads_.size()); }
+
+    void Run(uint32_t task_count, const std::function<void(uint32_t)> &task) {
+        std::unique_lock<std::mutex> run_lock(run_mutex_, std::try_to_lock);
+        if (!run_lock.owns_lock() || threads_.empty() || (task_count < 2)) {
+            for (uint32_t i = 0; i < task_count; ++i) task(i);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            task_count_ = task_count;
+            next_task_ = 0;
+            busy_workers_ = ThreadCount();
+            ++generation_;
+        }
+        start_cv_.notify_all();
+        RunTasks(task, task_count);
+        // Every worker checks in before the job ends, so none can still be looking at task_ when the next job starts
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return busy_workers_ == 0; });
+        task_ = nullptr;
+    }
+
+   private:
+    void RunTasks(const std::function<void(uint32_t)> &task, uint32_t task_count) {
+        for (uint32_t i = next_task_++; i < task_count; i = next_task_++) task(i);
+    }
+
+    void WorkerLoop() {
+        uint64_t generation = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            start_cv_.wait(lock, [this, generation] { return exit_ || (generation_ != generation); });
+            if (exit_) return;
+            generation = generation_;
+            const auto *task = task_;
+            const uint32_t task_count = task_count_;
+            lock.unlock();
+            RunTasks(*task, task_count);
+            lock.lock();
+            if (--busy_workers_ == 0) done_cv_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex run_mutex_;  // Held by the thread whose job is running
+    std::mutex mutex_;      // Guards the job description and worker bookkeeping below
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(uint32_t)> *task_;
+    uint32_t task_count_;
+    std::atomic<uint32_t> next_task_;
+    uint64_t generation_;
+    uint32_t busy_workers_;
+    bool exit_;
+};
+
+#endif  // WORKER_POOL_H_
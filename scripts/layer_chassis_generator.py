@@ -192,12 +192,39 @@ class LayerChassisOutputGenerator(OutputGenerator):
         'vkDestroyDebugUtilsMessengerEXT' : 'layer_destroy_messenger_callback(layer_data->report_data, messenger, pAllocator);',
         }
 
+    # PreCallValidate functions that update shared validation state, and so cannot run under the shared read lock:
+    #  - queue submission and presentation simulate the queue, updating semaphore, image layout and layout summary state
+    #  - flushes copy shadowed memory to the driver
+    #  - descriptor updates stamp the descriptors whose new contents validated cleanly, s.t. rewriting them can skip the checks
+    # The validation of vkCmd* calls also writes some state of the command buffer being recorded (deferred checks, cached
+    # descriptor set validation), which only the thread recording it touches outside the calls above. State shared between
+    # command buffers is only written by record phases.
+    exclusive_validate_functions = [
+        'vkQueueSubmit',
+        'vkQueueBindSparse',
+        'vkQueuePresentKHR',
+        'vkFlushMappedMemoryRanges',
+        'vkUpdateDescriptorSets',
+        'vkUpdateDescriptorSetWithTemplate',
+        'vkUpdateDescriptorSetWithTemplateKHR',
+        ]
+
+    # Command buffer entry points that touch the state of other command buffers, and so cannot use the per-command buffer lock.
+    # Every other vkCmd* record hook writes only its own command buffer and internally locked shared state; see
+    # CoreChecks::CommandBufferLock() for the list, and add an entry point here if its record hook needs more than that.
+    exclusive_command_buffer_functions = [
+        'vkBeginCommandBuffer',
+        'vkResetCommandBuffer',
+        'vkCmdExecuteCommands',
+        ]
+
     precallvalidate_loop = "for (auto intercept : layer_data->object_dispatch) {"
     precallrecord_loop = precallvalidate_loop
     postcallrecord_loop = "for (auto intercept : layer_data->object_dispatch) {"
 
     inline_custom_header_preamble = """
 #define NOMINMAX
+#include <atomic>
 #include <mutex>
 #include <cinttypes>
 #include <stdio.h>
@@ -207,6 +234,7 @@ class LayerChassisOutputGenerator(OutputGenerator):
 #include <unordered_set>
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "vk_loader_platform.h"
 #include "vulkan/vulkan.h"
@@ -223,10 +251,169 @@ class LayerChassisOutputGenerator(OutputGenerator):
 #include "vk_extension_helper.h"
 #include "vk_safe_struct.h"
 #include "vk_typemap_helper.h"
+#include "rw_lock.h"
+#include "concurrent_map.h"
+
+
+extern std::atomic<uint64_t> global_unique_id;
+extern bool wrap_handles;
+
+#if defined(LAYER_CHASSIS_EMBED_HANDLES)
+// With embedded handles, a wrapped handle is the index of one of these records in wrapped_handle_records, with a generation
+// count in the bits above the index, so unwrapping is a bounds check and a single load. Validation objects may keep a pointer
+// to their own state for the handle alongside the driver handle. Records are recycled rather than freed, and a record only
+// belongs to the handle in its id, so looking up a destroyed, foreign or garbage handle finds no record, or one that doesn't
+// match, instead of reading through an arbitrary pointer.
+struct WrappedHandleRecord {
+    std::atomic<uint64_t> id;  // The wrapped handle currently using this record, or 0 while the record is free
+    uint64_t generation;       // Bumped each time the record is reused, so a new handle never equals a destroyed one
+    uint64_t driver_handle;
+    void *core_state;  // CoreChecks state object for this handle, if it has one
+};
+
+// Handles keep the record index in their low bits and the generation in the rest. A record whose generation runs out is
+// retired instead of reused, so generations never wrap around. The top index is no record's: it marks the handles wrapped
+// after every index was taken, which only the map knows.
+static const uint32_t kWrappedHandleIndexBits = 24;
+static const uint64_t kWrappedHandleIndexMask = (uint64_t(1) << kWrappedHandleIndexBits) - 1;
+static const uint64_t kWrappedHandleNoRecord = kWrappedHandleIndexMask;
+static const uint64_t kWrappedHandleMaxGeneration = (uint64_t(1) << (64 - kWrappedHandleIndexBits)) - 1;
+
+// Records are allocated in blocks that are never moved or freed while the layer is loaded, so looking one up by index needs
+// no lock while other threads add blocks
+class WrappedHandleRecordTable {
+   public:
+    ~WrappedHandleRecordTable() {
+        for (auto &block : blocks_) delete[] block.load();
+    }
+
+    // Returns the record at index, or nullptr if it was never allocated
+    WrappedHandleRecord *Get(uint64_t index) const {
+        const uint64_t block = index >> kBlockBits;
+        if (block >= kBlockCount) return nullptr;
+        WrappedHandleRecord *records = blocks_[block].load(std::memory_order_acquire);
+        return records ? &records[index & (kBlockSize - 1)] : nullptr;
+    }
+
+    // Takes a free record, returning its index, or kWrappedHandleNoRecord if every index is taken
+    uint64_t Acquire() {
+        std::lock_guard<std::mutex> lock(lock_);
+        if (!free_indices_.empty()) {
+            const uint64_t index = free_indices_.back();
+            free_indices_.pop_back();
+            return index;
+        }
+        if (record_count_ == kWrappedHandleNoRecord) return kWrappedHandleNoRecord;
+        const uint64_t index = record_count_++;
+        auto &block = blocks_[index >> kBlockBits];
+        if (!block.load(std::memory_order_relaxed)) {
+            auto *records = new WrappedHandleRecord[kBlockSize];
+            for (uint32_t i = 0; i < kBlockSize; i++) {
+                records[i].id.store(0, std::memory_order_relaxed);
+                records[i].generation = 1;
+                records[i].driver_handle = 0;
+                records[i].core_state = nullptr;
+            }
+            block.store(records, std::memory_order_release);
+        }
+        return index;
+    }
+
+    // Frees the record of a live wrapped handle
+    void Release(uint64_t unique_id) {
+        const uint64_t index = unique_id & kWrappedHandleIndexMask;
+        WrappedHandleRecord *record = Get(index);
+        if (!record || record->id.load(std::memory_order_acquire) != unique_id) return;
+        record->id.store(0, std::memory_order_release);
+        record->core_state = nullptr;
+        if (record->generation > kWrappedHandleMaxGeneration) return;  // Out of generations, so never reused
+        std::lock_guard<std::mutex> lock(lock_);
+        free_indices_.push_back(index);
+    }
+
+   private:
+    static const uint32_t kBlockBits = 12;
+    static const uint32_t kBlockSize = 1u << kBlockBits;
+    static const uint32_t kBlockCount = 1u << (kWrappedHandleIndexBits - kBlockBits);
+
+    std::atomic<WrappedHandleRecord *> blocks_[kBlockCount] = {};
+    std::mutex lock_;
+    uint64_t record_count_ = 0;  // Records ever allocated, live or free
+    std::vector<uint64_t> free_indices_;
+};
+
+extern WrappedHandleRecordTable wrapped_handle_records;
+
+// Returns the record behind a live wrapped handle, or nullptr for VK_NULL_HANDLE, for destroyed or unknown handles, for
+// handles wrapped without a record and when handles are not being wrapped
+template <typename HandleType>
+static inline WrappedHandleRecord *GetWrappedHandleRecord(HandleType handle) {
+    const uint64_t id = reinterpret_cast<uint64_t const &>(handle);
+    if (!wrap_handles || !id) return nullptr;
+    WrappedHandleRecord *record = wrapped_handle_records.Get(id & kWrappedHandleIndexMask);
+    return (record && record->id.load(std::memory_order_acquire) == id) ? record : nullptr;
+}
+#endif
+
+// Map from wrapped handles to driver handles.
+//
+// By default wrapped handles are sequential unique ids and every unwrap is a lookup in the map. When built with
+// LAYER_CHASSIS_EMBED_HANDLES the id indexes a WrappedHandleRecord and Unwrap() reads the record directly. The map is still
+// maintained in that mode, so that find() can tell wrapped handles from foreign ones and retiring a handle stays checked, but
+// it is only touched on create and destroy, and to unwrap the rare handles that have no record. Destroyed and unknown handles
+// unwrap to VK_NULL_HANDLE in both modes.
+class WrappedHandleMap {
+   public:
+    // Wrap a driver handle, returning the new wrapped handle value
+    uint64_t Wrap(uint64_t driver_handle) {
+#if defined(LAYER_CHASSIS_EMBED_HANDLES)
+        uint64_t unique_id;
+        const uint64_t index = wrapped_handle_records.Acquire();
+        WrappedHandleRecord *record = (index != kWrappedHandleNoRecord) ? wrapped_handle_records.Get(index) : nullptr;
+        if (record) {
+            unique_id = (record->generation++ << kWrappedHandleIndexBits) | index;
+            record->driver_handle = driver_handle;
+            record->core_state = nullptr;
+            record->id.store(unique_id, std::memory_order_release);
+        } else {
+            unique_id = (global_unique_id++ << kWrappedHandleIndexBits) | kWrappedHandleNoRecord;
+        }
+#else
+        const uint64_t unique_id = global_unique_id++;
+#endif
+        map_.insert_or_assign(unique_id, driver_handle);
+        return unique_id;
+    }
+
+    // Returns the driver handle for a wrapped handle, or VK_NULL_HANDLE for an unknown one
+    uint64_t Unwrap(uint64_t unique_id) const {
+#if defined(LAYER_CHASSIS_EMBED_HANDLES)
+        const WrappedHandleRecord *record = GetWrappedHandleRecord(unique_id);
+        if (record) return record->driver_handle;
+        if ((unique_id & kWrappedHandleIndexMask) != kWrappedHandleNoRecord) return 0;
+#endif
+        return map_.find(unique_id).second;
+    }
+
+    // Returns {true, driver handle} if unique_id is a live wrapped handle, or {false, 0} otherwise
+    std::pair<bool, uint64_t> find(uint64_t unique_id) const { return map_.find(unique_id); }
+
+    // Retire a wrapped handle and return the driver handle it wrapped, with the same convention as find()
+    std::pair<bool, uint64_t> pop(uint64_t unique_id) {
+        auto found = map_.pop(unique_id);
+#if defined(LAYER_CHASSIS_EMBED_HANDLES)
+        if (found.first) wrapped_handle_records.Release(unique_id);
+#endif
+        return found;
+    }
 
+    size_t erase(uint64_t unique_id) { return pop(unique_id).first ? 1 : 0; }
 
-extern uint64_t global_unique_id;
-extern std::unordered_map<uint64_t, uint64_t> unique_id_mapping;
+   private:
+    ConcurrentUnorderedMap<uint64_t, uint64_t> map_;
+};
+
+extern WrappedHandleMap unique_id_mapping;
 """
 
     inline_custom_header_class_definition = """
@@ -263,6 +450,13 @@ typedef enum ValidationCheckDisables {
     VALIDATION_CHECK_DISABLE_QUERY_VALIDATION,
 } ValidationCheckDisables;
 
+typedef enum ValidationCheckEnables {
+    VALIDATION_CHECK_ENABLE_CONCURRENT_VALIDATION,
+    VALIDATION_CHECK_ENABLE_SHADOW_GUARD_PAGES,
+    VALIDATION_CHECK_ENABLE_BACKGROUND_RETIREMENT,
+    VALIDATION_CHECK_ENABLE_PARALLEL_DESCRIPTOR_VALIDATION,
+} ValidationCheckEnables;
+
 
 // CHECK_DISABLED struct is a container for bools that can block validation checks from being performed.
 // These bools are all "false" by default meaning that all checks are enabled. Enum values can be specified
@@ -287,10 +481,28 @@ struct CHECK_DISABLED {
 struct CHECK_ENABLED {
     bool gpu_validation;
     bool gpu_validation_reserve_binding_slot;
+    bool concurrent_validation;                     // Run PreCallValidate phases under a shared lock
+    bool shadow_guard_pages;                        // Guard non-coherent shadow copies with inaccessible pages (Linux)
+    bool background_retirement;                     // Retire completed queue submissions on a layer-owned thread
+    bool parallel_descriptor_validation;            // Split draw-time checks of large descriptor arrays across threads
 
-    void SetAll(bool value) { std::fill(&gpu_validation, &gpu_validation_reserve_binding_slot + 1, value); }
+    void SetAll(bool value) { std::fill(&gpu_validation, &parallel_descriptor_validation + 1, value); }
 };
 
+// Lock held around the chassis calls for a vkCmd* entry point: the object-wide lock, plus optionally a lock private to the
+// command buffer being recorded. The command buffer lock is released first.
+class CommandBufferLockGuard {
+   public:
+    explicit CommandBufferLockGuard(ReadWriteLockGuard &&object_lock) : object_lock_(std::move(object_lock)) {}
+    CommandBufferLockGuard(ReadWriteLockGuard &&object_lock, std::mutex &command_buffer_mutex)
+        : object_lock_(std::move(object_lock)), command_buffer_lock_(command_buffer_mutex) {}
+
+   private:
+    ReadWriteLockGuard object_lock_;
+    std::unique_lock<std::mutex> command_buffer_lock_;
+};
+using cb_lock_guard_t = CommandBufferLockGuard;
+
 // Layer chassis validation object base class definition
 class ValidationObject {
     public:
@@ -322,9 +534,22 @@ class ValidationObject {
         // Destructor
         virtual ~ValidationObject() {};
 
-        std::mutex validation_object_mutex;
-        virtual std::unique_lock<std::mutex> write_lock() {
-            return std::unique_lock<std::mutex>(validation_object_mutex);
+        // PreCallValidate phases take read_lock(), record phases take write_lock(). Validation may run concurrently across
+        // threads only when concurrent_validation is enabled; otherwise both locks are exclusive.
+        ReadWriteMutex validation_object_mutex;
+        virtual read_lock_guard_t read_lock() {
+            return read_lock_guard_t(validation_object_mutex, enabled.concurrent_validation ? LockMode::kShared : LockMode::kExclusive);
+        }
+        virtual write_lock_guard_t write_lock() {
+            return write_lock_guard_t(validation_object_mutex, LockMode::kExclusive);
+        }
+        // vkCmd* entry points take these instead, so that objects which keep per-command buffer state can let threads
+        // recording different command buffers run side by side.
+        virtual cb_lock_guard_t cb_read_lock(VkCommandBuffer command_buffer) {
+            return cb_lock_guard_t(read_lock());
+        }
+        virtual cb_lock_guard_t cb_write_lock(VkCommandBuffer command_buffer) {
+            return cb_lock_guard_t(write_lock());
         }
 
         ValidationObject* GetValidationObject(std::vector<ValidationObject*>& object_dispatch, LayerObjectTypeId object_type) {
@@ -353,31 +578,28 @@ class ValidationObject {
         std::unordered_map<VkDescriptorPool, std::unordered_set<VkDescriptorSet>> pool_descriptor_sets_map;
 
 
-        // Unwrap a handle.  Must hold lock.
+        // Unwrap a handle. Unknown handles unwrap to VK_NULL_HANDLE, except with embedded handles. Does not need the dispatch lock.
         template <typename HandleType>
         HandleType Unwrap(HandleType wrappedHandle) {
-            // TODO: don't use operator[] here.
-            return (HandleType)unique_id_mapping[reinterpret_cast<uint64_t const &>(wrappedHandle)];
+            return (HandleType)unique_id_mapping.Unwrap(reinterpret_cast<uint64_t const &>(wrappedHandle));
         }
 
-        // Wrap a newly created handle with a new unique ID, and return the new ID -- must hold lock.
+        // Wrap a newly created handle with a new unique ID, and return the new ID. Does not need the dispatch lock.
         template <typename HandleType>
         HandleType WrapNew(HandleType newlyCreatedHandle) {
-            auto unique_id = global_unique_id++;
-            unique_id_mapping[unique_id] = reinterpret_cast<uint64_t const &>(newlyCreatedHandle);
-            return (HandleType)unique_id;
+            return (HandleType)unique_id_mapping.Wrap(reinterpret_cast<uint64_t const &>(newlyCreatedHandle));
         }
 
-        // Specialized handling for VkDisplayKHR. Adds an entry to enable reverse-lookup. Must hold lock.
+        // Specialized handling for VkDisplayKHR. Adds an entry to enable reverse-lookup. The wrap itself doesn't need the
+        // dispatch lock, but display_id_reverse_mapping does, so callers must hold it.
         VkDisplayKHR WrapDisplay(VkDisplayKHR newlyCreatedHandle, ValidationObject *map_data) {
-            auto unique_id = global_unique_id++;
-            unique_id_mapping[unique_id] = reinterpret_cast<uint64_t const &>(newlyCreatedHandle);
+            auto unique_id = unique_id_mapping.Wrap(reinterpret_cast<uint64_t const &>(newlyCreatedHandle));
             map_data->display_id_reverse_mapping[newlyCreatedHandle] = unique_id;
             return (VkDisplayKHR)unique_id;
         }
 
         // VkDisplayKHR objects don't have a single point of creation, so we need to see if one already exists in the map before
-        // creating another. Must hold lock.
+        // creating another. Must hold the dispatch lock, for display_id_reverse_mapping.
         VkDisplayKHR MaybeWrapDisplay(VkDisplayKHR handle, ValidationObject *map_data) {
             // See if this display is already known
             auto it = map_data->display_id_reverse_mapping.find(handle);
@@ -425,10 +647,14 @@ class ValidationObject {
 
 std::unordered_map<void*, ValidationObject*> layer_data_map;
 
-// Global unique object identifier.  All increments must be guarded by a lock.
-uint64_t global_unique_id = 1;
-// Map uniqueID to actual object handle
-std::unordered_map<uint64_t, uint64_t> unique_id_mapping;
+// Global unique object identifier.
+std::atomic<uint64_t> global_unique_id(1ULL);
+// Map uniqueID to actual object handle. Sharded and internally locked, so that wrapping and unwrapping handles on different
+// threads doesn't serialize on the dispatch lock.
+WrappedHandleMap unique_id_mapping;
+#if defined(LAYER_CHASSIS_EMBED_HANDLES)
+WrappedHandleRecordTable wrapped_handle_records;
+#endif
 
 // TODO: This variable controls handle wrapping -- in the future it should be hooked
 //       up to the new VALIDATION_FEATURES extension. Temporarily, control with a compile-time flag.
@@ -543,6 +769,13 @@ static const std::unordered_map<std::string, ValidationCheckDisables> Validation
     {"VALIDATION_CHECK_DISABLE_QUERY_VALIDATION", VALIDATION_CHECK_DISABLE_QUERY_VALIDATION},
 };
 
+static const std::unordered_map<std::string, ValidationCheckEnables> ValidationEnableLookup = {
+    {"VALIDATION_CHECK_ENABLE_CONCURRENT_VALIDATION", VALIDATION_CHECK_ENABLE_CONCURRENT_VALIDATION},
+    {"VALIDATION_CHECK_ENABLE_SHADOW_GUARD_PAGES", VALIDATION_CHECK_ENABLE_SHADOW_GUARD_PAGES},
+    {"VALIDATION_CHECK_ENABLE_BACKGROUND_RETIREMENT", VALIDATION_CHECK_ENABLE_BACKGROUND_RETIREMENT},
+    {"VALIDATION_CHECK_ENABLE_PARALLEL_DESCRIPTOR_VALIDATION", VALIDATION_CHECK_ENABLE_PARALLEL_DESCRIPTOR_VALIDATION},
+};
+
 // Set the local disable flag for the appropriate VALIDATION_CHECK_DISABLE enum
 void SetValidationDisable(CHECK_DISABLED* disable_data, const ValidationCheckDisables disable_id) {
     switch (disable_id) {
@@ -566,6 +799,26 @@ void SetValidationDisable(CHECK_DISABLED* disable_data, const ValidationCheckDis
     }
 }
 
+// Set the local enable flag for the appropriate VALIDATION_CHECK_ENABLE enum
+void SetValidationEnable(CHECK_ENABLED* enable_data, const ValidationCheckEnables enable_id) {
+    switch (enable_id) {
+        case VALIDATION_CHECK_ENABLE_CONCURRENT_VALIDATION:
+            enable_data->concurrent_validation = true;
+            break;
+        case VALIDATION_CHECK_ENABLE_SHADOW_GUARD_PAGES:
+            enable_data->shadow_guard_pages = true;
+            break;
+        case VALIDATION_CHECK_ENABLE_BACKGROUND_RETIREMENT:
+            enable_data->background_retirement = true;
+            break;
+        case VALIDATION_CHECK_ENABLE_PARALLEL_DESCRIPTOR_VALIDATION:
+            enable_data->parallel_descriptor_validation = true;
+            break;
+        default:
+            assert(true);
+    }
+}
+
 // Set the local disable flag for a single VK_VALIDATION_FEATURE_DISABLE_* flag
 void SetValidationFeatureDisable(CHECK_DISABLED* disable_data, const VkValidationFeatureDisableEXT feature_disable) {
     switch (feature_disable) {
@@ -656,6 +909,12 @@ void SetLocalEnableSetting(std::string list_of_enables, std::string delimiter, C
                 SetValidationFeatureEnable(enables, result->second);
             }
         }
+        if (token.find("VALIDATION_CHECK_ENABLE_") != std::string::npos) {
+            auto result = ValidationEnableLookup.find(token);
+            if (result != ValidationEnableLookup.end()) {
+                SetValidationEnable(enables, result->second);
+            }
+        }
         list_of_enables.erase(0, pos + delimiter.length());
     }
 }
@@ -1095,7 +1354,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateGraphicsPipelines(
 #endif
 
     for (auto intercept : layer_data->object_dispatch) {
-        auto lock = intercept->write_lock();
+        auto lock = intercept->read_lock();
         skip |= intercept->PreCallValidateCreateGraphicsPipelines(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines, &cgpl_state);
         if (skip) return VK_ERROR_VALIDATION_FAILED_EXT;
     }
@@ -1134,7 +1393,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateComputePipelines(
 #endif
 
     for (auto intercept : layer_data->object_dispatch) {
-        auto lock = intercept->write_lock();
+        auto lock = intercept->read_lock();
         skip |= intercept->PreCallValidateCreateComputePipelines(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines, &ccpl_state);
         if (skip) return VK_ERROR_VALIDATION_FAILED_EXT;
     }
@@ -1167,7 +1426,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateRayTracingPipelinesNV(
     std::vector<std::unique_ptr<PIPELINE_STATE>> pipe_state;
 
     for (auto intercept : layer_data->object_dispatch) {
-        auto lock = intercept->write_lock();
+        auto lock = intercept->read_lock();
         skip |= intercept->PreCallValidateCreateRayTracingPipelinesNV(device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines, &pipe_state);
         if (skip) return VK_ERROR_VALIDATION_FAILED_EXT;
     }
@@ -1201,7 +1460,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreatePipelineLayout(
     cpl_state.modified_create_info = *pCreateInfo;
 
     for (auto intercept : layer_data->object_dispatch) {
-        auto lock = intercept->write_lock();
+        auto lock = intercept->read_lock();
         skip |= intercept->PreCallValidateCreatePipelineLayout(device, pCreateInfo, pAllocator, pPipelineLayout);
         if (skip) return VK_ERROR_VALIDATION_FAILED_EXT;
     }
@@ -1265,7 +1524,7 @@ VKAPI_ATTR VkResult VKAPI_CALL AllocateDescriptorSets(
 #endif
 
     for (auto intercept : layer_data->object_dispatch) {
-        auto lock = intercept->write_lock();
+        auto lock = intercept->read_lock();
         skip |= intercept->PreCallValidateAllocateDescriptorSets(device, pAllocateInfo, pDescriptorSets, &ads_state);
         if (skip) return VK_ERROR_VALIDATION_FAILED_EXT;
     }
@@ -1695,17 +1954,24 @@ VK_LAYER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkNegotiateLoaderLayerInterfaceVe
 
         # Set up skip and locking
         self.appendSection('command', '    bool skip = false;')
+        read_lock = 'read_lock()'
+        write_lock = 'write_lock()'
+        if dispatchable_type == 'VkCommandBuffer' and name not in self.exclusive_command_buffer_functions:
+            read_lock = 'cb_read_lock(%s)' % dispatchable_name
+            write_lock = 'cb_write_lock(%s)' % dispatchable_name
+        if name in self.exclusive_validate_functions:
+            read_lock = write_lock
 
         # Generate pre-call validation source code
         self.appendSection('command', '    %s' % self.precallvalidate_loop)
-        self.appendSection('command', '        auto lock = intercept->write_lock();')
+        self.appendSection('command', '        auto lock = intercept->%s;' % read_lock)
         self.appendSection('command', '        skip |= intercept->PreCallValidate%s(%s);' % (api_function_name[2:], paramstext))
         self.appendSection('command', '        if (skip) %s' % return_map[resulttype.text])
         self.appendSection('command', '    }')
 
         # Generate pre-call state recording source code
         self.appendSection('command', '    %s' % self.precallrecord_loop)
-        self.appendSection('command', '        auto lock = intercept->write_lock();')
+        self.appendSection('command', '        auto lock = intercept->%s;' % write_lock)
         self.appendSection('command', '        intercept->PreCallRecord%s(%s);' % (api_function_name[2:], paramstext))
         self.appendSection('command', '    }')
 
@@ -1725,7 +1991,7 @@ VK_LAYER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkNegotiateLoaderLayerInterfaceVe
         returnparam = ''
         if (resulttype.text == 'VkResult'):
             returnparam = ', result'
-        self.appendSection('command', '        auto lock = intercept->write_lock();')
+        self.appendSection('command', '        auto lock = intercept->%s;' % write_lock)
         self.appendSection('command', '        intercept->PostCallRecord%s(%s%s);' % (api_function_name[2:], paramstext, returnparam))
         self.appendSection('command', '    }')
         # Return result variable, if any.
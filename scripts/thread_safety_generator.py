@@ -149,12 +149,17 @@ class ThreadOutputGenerator(OutputGenerator):
     inline_custom_header_preamble = """
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <unordered_set>
 #include <string>
 
+#include "cast_utils.h"
+#include "concurrent_map.h"
+
 VK_DEFINE_NON_DISPATCHABLE_HANDLE(DISTINCT_NONDISPATCHABLE_PHONY_HANDLE)
 // The following line must match the vulkan_core.h condition guarding VK_DEFINE_NON_DISPATCHABLE_HANDLE
 #if defined(__LP64__) || defined(_WIN64) || (defined(__x86_64__) && !defined(__ILP32__)) || defined(_M_X64) || defined(__ia64) || \
@@ -187,71 +192,183 @@ static const char DECORATE_UNUSED *kVUID_Threading_SingleThreadReuse = "UNASSIGN
 #undef DECORATE_UNUSED
 
 struct object_use_data {
-    loader_platform_thread_id thread;
-    int reader_count;
-    int writer_count;
+    // Reader and writer counts packed into one atomic, writers in the high half, so that starting or finishing a use of the
+    // object is a single atomic operation
+    class WriteReadCount {
+       public:
+        WriteReadCount(int64_t v) : count(v) {}
+
+        int32_t GetReadCount() const { return (int32_t)(count & 0xFFFFFFFF); }
+        int32_t GetWriteCount() const { return (int32_t)(count >> 32); }
+        bool IsIdle() const { return count == 0; }
+
+       private:
+        int64_t count;
+    };
+    static const int64_t kOneReader = 1;
+    static const int64_t kOneWriter = 1LL << 32;
+
+    object_use_data() : thread(0), writer_reader_count(0) {}
+
+    // These return the counts from before the new use
+    WriteReadCount AddReader() { return writer_reader_count.fetch_add(kOneReader); }
+    WriteReadCount AddWriter() { return writer_reader_count.fetch_add(kOneWriter); }
+    void RemoveReader() { RemoveUse(kOneReader); }
+    void RemoveWriter() { RemoveUse(kOneWriter); }
+
+    // The thread is only a hint for telling recursive use from a conflict, so it doesn't need ordering of its own
+    loader_platform_thread_id GetThread() const { return thread.load(std::memory_order_relaxed); }
+    void SetThread(loader_platform_thread_id tid) { thread.store(tid, std::memory_order_relaxed); }
+
+    void RemoveUse(int64_t own_count) {
+        // The last user forgets its thread before leaving, so that if another thread starts using the object before that
+        // thread has recorded itself, a new use by the last user is still seen as a conflict rather than recursion. Another
+        // thread can still join between the check and the decrement; it is reported as a conflict, and may record itself
+        // as the user, so the thread is only cleared if it is still ours. Either way the thread names one of the current
+        // users of the object, not necessarily the one that will finish last, which is all the error messages rely on.
+        if (writer_reader_count.load() == own_count) {
+            loader_platform_thread_id tid = loader_platform_get_thread_id();
+            thread.compare_exchange_strong(tid, 0, std::memory_order_relaxed);
+        }
+        writer_reader_count.fetch_sub(own_count);
+    }
+
+    std::atomic<loader_platform_thread_id> thread;
+    std::atomic<int64_t> writer_reader_count;
 };
 
-// This is a wrapper around unordered_map that optimizes for the common case
-// of only containing a single element. The "first" element's use is stored
-// inline in the class and doesn't require hashing or memory (de)allocation.
-// TODO: Consider generalizing this from one element to N elements (where N
-// is a template parameter).
-template <typename Key, typename T>
-class small_unordered_map {
+template <typename T>
+class counter {
+public:
+    const char *typeName;
+    VkDebugReportObjectTypeEXT objectType;
+    debug_report_data **report_data;
 
-    bool first_data_allocated;
-    Key first_data_key;
-    T first_data;
+    // Use counts of each object. Entries are created on first use and dropped when the object is destroyed.
+    ConcurrentUnorderedMap<T, std::shared_ptr<object_use_data>, 6> object_table;
+
+    // Threads that have to wait for another thread to finish with an object sleep on the stripe picked by the object's hash,
+    // so that waits and wakeups for unrelated objects never share a mutex
+    struct WaitStripe {
+        WaitStripe() : waiting_threads(0) {}
+        std::mutex lock;
+        std::condition_variable condition;
+        std::atomic<int> waiting_threads;
+    };
+    static const uint32_t kWaitStripes = 64;
+    WaitStripe wait_stripes[kWaitStripes];
+
+    // Each thread also remembers the entries it used most recently, so that in the common case of no conflict a use is a
+    // thread local lookup and one atomic add, without touching the table. Destroying an object bumps the destroy_epoch of
+    // its counter, which invalidates that counter's cached entries, and cached entries are tagged with a counter id that is
+    // never reused, so a counter created where a destroyed one used to be doesn't see its entries. The cache shares
+    // ownership of its entries, so one that is dropped from the table by another thread stays valid until this thread has
+    // finished with it.
+    struct CachedUse {
+        CachedUse() : owner_id(0), object(), epoch(0) {}
+        uint64_t owner_id;
+        T object;
+        uint64_t epoch;
+        std::shared_ptr<object_use_data> use_data;
+    };
+    static const uint32_t kCacheSize = 64;
+    static std::atomic<uint64_t> next_counter_id;
+    const uint64_t counter_id;
+    std::atomic<uint64_t> destroy_epoch;
+
+    static uint32_t HashObject(T object) {
+        const uint64_t u64 = CastToUint64(object);
+        uint32_t hash = static_cast<uint32_t>(u64) ^ static_cast<uint32_t>(u64 >> 32);
+        return hash ^ (hash >> 6) ^ (hash >> 12);
+    }
 
-    std::unordered_map<Key, T> uses;
+    static CachedUse &GetCachedUse(T object) {
+        static thread_local CachedUse cache[kCacheSize];
+        return cache[HashObject(object) % kCacheSize];
+    }
 
-public:
-    small_unordered_map() : first_data_allocated(false) {}
-
-    bool contains(const Key& object) const {
-        if (first_data_allocated && object == first_data_key) {
-            return true;
-        // check size() first to avoid hashing object unnecessarily.
-        } else if (uses.size() == 0) {
-            return false;
-        } else {
-            return uses.find(object) != uses.end();
+    WaitStripe &GetWaitStripe(T object) { return wait_stripes[HashObject(object) % kWaitStripes]; }
+
+    std::shared_ptr<object_use_data> FindOrInsertObject(T object) {
+        for (;;) {
+            auto found = object_table.find(object);
+            if (found.first) return std::move(found.second);
+            // First use of this object. If another thread's first use beats us to the insert, use its entry instead.
+            std::shared_ptr<object_use_data> use_data = std::make_shared<object_use_data>();
+            if (object_table.insert(object, use_data)) return use_data;
         }
     }
 
-    T& operator[](const Key& object) {
-        if (first_data_allocated && first_data_key == object) {
-            return first_data;
-        } else if (!first_data_allocated && uses.size() == 0) {
-            first_data_allocated = true;
-            first_data_key = object;
-            return first_data;
-        } else {
-            return uses[object];
+    // The returned entry is held by this thread's cache, so it stays alive until the thread's next lookup, even if the object
+    // is destroyed on another thread meanwhile
+    object_use_data *FindObject(T object) {
+        const uint64_t epoch = destroy_epoch.load();
+        CachedUse &cached = GetCachedUse(object);
+        if ((cached.owner_id == counter_id) && (cached.object == object) && (cached.epoch == epoch)) {
+            return cached.use_data.get();
         }
+        cached.use_data = FindOrInsertObject(object);
+        cached.owner_id = counter_id;
+        cached.object = object;
+        cached.epoch = epoch;
+        return cached.use_data.get();
     }
 
-    typename std::unordered_map<Key, T>::size_type erase(const Key& object) {
-        if (first_data_allocated && first_data_key == object) {
-            first_data_allocated = false;
-            return 1;
-        } else {
-            return uses.erase(object);
+    // Find the entry a use of the object by this thread was counted in, to finish that use. This is normally the cached entry,
+    // even if the object has been destroyed since, as it is the one the use started on. Without it, returns the entry in the
+    // table, or nullptr if the object has been destroyed, in which case the count went with its entry and there is nothing
+    // to release. Unlike FindObject, this never creates an entry, which would otherwise be left with a negative count.
+    object_use_data *FindStartedUse(T object) {
+        CachedUse &cached = GetCachedUse(object);
+        if ((cached.owner_id == counter_id) && (cached.object == object)) {
+            return cached.use_data.get();
         }
+        auto found = object_table.find(object);
+        if (!found.first) return nullptr;
+        cached.use_data = std::move(found.second);
+        cached.owner_id = counter_id;
+        cached.object = object;
+        cached.epoch = destroy_epoch.load();
+        return cached.use_data.get();
     }
-};
 
-template <typename T>
-class counter {
-public:
-    const char *typeName;
-    VkDebugReportObjectTypeEXT objectType;
-    debug_report_data **report_data;
-    small_unordered_map<T, object_use_data> uses;
-    std::mutex counter_lock;
-    std::condition_variable counter_condition;
+    void DestroyObject(T object) {
+        if (object != VK_NULL_HANDLE) {
+            object_table.erase(object);
+            destroy_epoch++;
+        }
+    }
 
+    // Make every thread look its entries for T up in the table again
+    void InvalidateCachedUses() { destroy_epoch++; }
+
+    // Back out this thread's use of the object, counted as own_count, and block until it can be taken again with no other
+    // thread using the object
+    void WaitForObjectIdle(T object, object_use_data *use_data, int64_t own_count) {
+        WaitStripe &stripe = GetWaitStripe(object);
+        stripe.waiting_threads++;
+        use_data->writer_reader_count.fetch_sub(own_count);
+        NotifyWaitingThreads(object);
+        {
+            std::unique_lock<std::mutex> lock(stripe.lock);
+            stripe.condition.wait(lock, [&] {
+                int64_t idle = 0;
+                if (!use_data->writer_reader_count.compare_exchange_strong(idle, own_count)) return false;
+                use_data->SetThread(loader_platform_get_thread_id());
+                return true;
+            });
+        }
+        stripe.waiting_threads--;
+    }
+
+    // Wake any threads waiting on an object. Waiters are only ever registered after a conflict, so this is normally one load.
+    void NotifyWaitingThreads(T object) {
+        WaitStripe &stripe = GetWaitStripe(object);
+        if (stripe.waiting_threads.load() > 0) {
+            std::lock_guard<std::mutex> lock(stripe.lock);
+            stripe.condition.notify_all();
+        }
+    }
 
     void StartWrite(T object) {
         if (object == VK_NULL_HANDLE) {
@@ -259,72 +376,28 @@ public:
         }
         bool skip = false;
         loader_platform_thread_id tid = loader_platform_get_thread_id();
-        std::unique_lock<std::mutex> lock(counter_lock);
-        if (!uses.contains(object)) {
+        object_use_data *use_data = FindObject(object);
+        const object_use_data::WriteReadCount prev_count = use_data->AddWriter();
+        if (prev_count.IsIdle()) {
             // There is no current use of the object.  Record writer thread.
-            struct object_use_data *use_data = &uses[object];
-            use_data->reader_count = 0;
-            use_data->writer_count = 1;
-            use_data->thread = tid;
-        } else {
-            struct object_use_data *use_data = &uses[object];
-            if (use_data->reader_count == 0) {
-                // There are no readers.  Two writers just collided.
-                if (use_data->thread != tid) {
-                    skip |= log_msg(*report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, objectType, (uint64_t)(object),
-                        kVUID_Threading_MultipleThreads,
-                        "THREADING ERROR : object of type %s is simultaneously used in "
-                        "thread 0x%" PRIx64 " and thread 0x%" PRIx64,
-                        typeName, (uint64_t)use_data->thread, (uint64_t)tid);
-                    if (skip) {
-                        // Wait for thread-safe access to object instead of skipping call.
-                        while (uses.contains(object)) {
-                            counter_condition.wait(lock);
-                        }
-                        // There is now no current use of the object.  Record writer thread.
-                        struct object_use_data *new_use_data = &uses[object];
-                        new_use_data->thread = tid;
-                        new_use_data->reader_count = 0;
-                        new_use_data->writer_count = 1;
-                    } else {
-                        // Continue with an unsafe use of the object.
-                        use_data->thread = tid;
-                        use_data->writer_count += 1;
-                    }
-                } else {
-                    // This is either safe multiple use in one call, or recursive use.
-                    // There is no way to make recursion safe.  Just forge ahead.
-                    use_data->writer_count += 1;
-                }
+            use_data->SetThread(tid);
+        } else if (use_data->GetThread() != tid) {
+            // Another thread is reading or writing the object.  This writer collided with it.
+            skip |= log_msg(*report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, objectType, (uint64_t)(object),
+                kVUID_Threading_MultipleThreads,
+                "THREADING ERROR : object of type %s is simultaneously used in "
+                "thread 0x%" PRIx64 " and thread 0x%" PRIx64,
+                typeName, (uint64_t)use_data->GetThread(), (uint64_t)tid);
+            if (skip) {
+                // Wait for thread-safe access to object instead of skipping call.  This records the writer thread.
+                WaitForObjectIdle(object, use_data, object_use_data::kOneWriter);
             } else {
-                // There are readers.  This writer collided with them.
-                if (use_data->thread != tid) {
-                    skip |= log_msg(*report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, objectType, (uint64_t)(object),
-                        kVUID_Threading_MultipleThreads,
-                        "THREADING ERROR : object of type %s is simultaneously used in "
-                        "thread 0x%" PRIx64 " and thread 0x%" PRIx64,
-                        typeName, (uint64_t)use_data->thread, (uint64_t)tid);
-                    if (skip) {
-                        // Wait for thread-safe access to object instead of skipping call.
-                        while (uses.contains(object)) {
-                            counter_condition.wait(lock);
-                        }
-                        // There is now no current use of the object.  Record writer thread.
-                        struct object_use_data *new_use_data = &uses[object];
-                        new_use_data->thread = tid;
-                        new_use_data->reader_count = 0;
-                        new_use_data->writer_count = 1;
-                    } else {
-                        // Continue with an unsafe use of the object.
-                        use_data->thread = tid;
-                        use_data->writer_count += 1;
-                    }
-                } else {
-                    // This is either safe multiple use in one call, or recursive use.
-                    // There is no way to make recursion safe.  Just forge ahead.
-                    use_data->writer_count += 1;
-                }
+                // Continue with an unsafe use of the object.
+                use_data->SetThread(tid);
             }
+        } else {
+            // This is either safe multiple use in one call, or recursive use.
+            // There is no way to make recursion safe.  Just forge ahead.
         }
     }
 
@@ -333,87 +406,76 @@ public:
             return;
         }
         // Object is no longer in use
-        std::unique_lock<std::mutex> lock(counter_lock);
-        uses[object].writer_count -= 1;
-        if ((uses[object].reader_count == 0) && (uses[object].writer_count == 0)) {
-            uses.erase(object);
-        }
+        object_use_data *use_data = FindStartedUse(object);
+        if (use_data) use_data->RemoveWriter();
         // Notify any waiting threads that this object may be safe to use
-        lock.unlock();
-        counter_condition.notify_all();
+        NotifyWaitingThreads(object);
     }
 
     void StartRead(T object) {
         if (object == VK_NULL_HANDLE) {
             return;
         }
-        bool skip = false;
         loader_platform_thread_id tid = loader_platform_get_thread_id();
-        std::unique_lock<std::mutex> lock(counter_lock);
-        if (!uses.contains(object)) {
-            // There is no current use of the object.  Record reader count
-            struct object_use_data *use_data = &uses[object];
-            use_data->reader_count = 1;
-            use_data->writer_count = 0;
-            use_data->thread = tid;
-        } else if (uses[object].writer_count > 0 && uses[object].thread != tid) {
-            // There is a writer of the object.
-            skip |= false;
+        object_use_data *use_data = FindObject(object);
+        const object_use_data::WriteReadCount prev_count = use_data->AddReader();
+        if (prev_count.IsIdle()) {
+            // There is no current use of the object.  Record reader thread.
+            use_data->SetThread(tid);
+        } else if (prev_count.GetWriteCount() > 0 && use_data->GetThread() != tid) {
+            // There is a writer of the object.  Readers are not made to wait, so just report it.
             log_msg(*report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, objectType, (uint64_t)(object), kVUID_Threading_MultipleThreads,
                 "THREADING ERROR : object of type %s is simultaneously used in "
                 "thread 0x%" PRIx64 " and thread 0x%" PRIx64,
-                typeName, (uint64_t)uses[object].thread, (uint64_t)tid);
-            if (skip) {
-                // Wait for thread-safe access to object instead of skipping call.
-                while (uses.contains(object)) {
-                    counter_condition.wait(lock);
-                }
-                // There is no current use of the object.  Record reader count
-                struct object_use_data *use_data = &uses[object];
-                use_data->reader_count = 1;
-                use_data->writer_count = 0;
-                use_data->thread = tid;
-            } else {
-                uses[object].reader_count += 1;
-            }
+                typeName, (uint64_t)use_data->GetThread(), (uint64_t)tid);
         } else {
-            // There are other readers of the object.  Increase reader count
-            uses[object].reader_count += 1;
+            // There are other readers of the object.
         }
     }
     void FinishRead(T object) {
         if (object == VK_NULL_HANDLE) {
             return;
         }
-        std::unique_lock<std::mutex> lock(counter_lock);
-        uses[object].reader_count -= 1;
-        if ((uses[object].reader_count == 0) && (uses[object].writer_count == 0)) {
-            uses.erase(object);
-        }
+        object_use_data *use_data = FindStartedUse(object);
+        if (use_data) use_data->RemoveReader();
         // Notify any waiting threads that this object may be safe to use
-        lock.unlock();
-        counter_condition.notify_all();
+        NotifyWaitingThreads(object);
     }
-    counter(const char *name = "", VkDebugReportObjectTypeEXT type = VK_DEBUG_REPORT_OBJECT_TYPE_UNKNOWN_EXT, debug_report_data **rep_data = nullptr) {
+    counter(const char *name = "", VkDebugReportObjectTypeEXT type = VK_DEBUG_REPORT_OBJECT_TYPE_UNKNOWN_EXT, debug_report_data **rep_data = nullptr)
+        : counter_id(++next_counter_id), destroy_epoch(0) {
         typeName = name;
         objectType = type;
         report_data = rep_data;
     }
 };
 
+template <typename T>
+std::atomic<uint64_t> counter<T>::next_counter_id(0);
+
 
 
 class ThreadSafety : public ValidationObject {
 public:
 
     // Override chassis read/write locks for this validation object
-    // This override takes a deferred lock. i.e. it is not acquired.
-    std::unique_lock<std::mutex> write_lock() {
-        return std::unique_lock<std::mutex>(validation_object_mutex, std::defer_lock);
+    // These overrides do not acquire the lock; thread safety tracking does its own locking.
+    read_lock_guard_t read_lock() {
+        return read_lock_guard_t(validation_object_mutex, LockMode::kNone);
+    }
+    write_lock_guard_t write_lock() {
+        return write_lock_guard_t(validation_object_mutex, LockMode::kNone);
     }
 
+    // Pool of each command buffer. Sharded by command buffer, so that threads recording their own pools don't share a lock.
+    ConcurrentUnorderedMap<VkCommandBuffer, VkCommandPool, 6> command_pool_map;
+
+    // Command buffers allocated from each pool, so that their use tracking can be dropped when the pool is destroyed
     std::mutex command_pool_lock;
-    std::unordered_map<VkCommandBuffer, VkCommandPool> command_pool_map;
+    std::unordered_map<VkCommandPool, std::unordered_set<VkCommandBuffer>> pool_command_buffers_map;
+
+    // Descriptor sets allocated from each pool, so that their use tracking can be dropped when the pool is reset or destroyed
+    std::mutex descriptor_pool_lock;
+    std::unordered_map<VkDescriptorPool, std::unordered_set<VkDescriptorSet>> pool_descriptor_sets_map;
 
     counter<VkCommandBuffer> c_VkCommandBuffer;
     counter<VkDevice> c_VkDevice;
@@ -460,6 +522,9 @@ COUNTER_CLASS_INSTANCES_TEMPLATE
     }                                                                \
     void FinishReadObject(type object) {                             \
         c_##type.FinishRead(object);                                 \
+    }                                                                \
+    void DestroyObject(type object) {                                \
+        c_##type.DestroyObject(object);                              \
     }
 
 WRAPPER(VkDevice)
@@ -475,9 +540,7 @@ WRAPPER(uint64_t)
     // VkCommandBuffer needs check for implicit use of command pool
     void StartWriteObject(VkCommandBuffer object, bool lockPool = true) {
         if (lockPool) {
-            std::unique_lock<std::mutex> lock(command_pool_lock);
-            VkCommandPool pool = command_pool_map[object];
-            lock.unlock();
+            VkCommandPool pool = command_pool_map.find(object).second;
             StartWriteObject(pool);
         }
         c_VkCommandBuffer.StartWrite(object);
@@ -485,16 +548,12 @@ WRAPPER(uint64_t)
     void FinishWriteObject(VkCommandBuffer object, bool lockPool = true) {
         c_VkCommandBuffer.FinishWrite(object);
         if (lockPool) {
-            std::unique_lock<std::mutex> lock(command_pool_lock);
-            VkCommandPool pool = command_pool_map[object];
-            lock.unlock();
+            VkCommandPool pool = command_pool_map.find(object).second;
             FinishWriteObject(pool);
         }
     }
     void StartReadObject(VkCommandBuffer object) {
-        std::unique_lock<std::mutex> lock(command_pool_lock);
-        VkCommandPool pool = command_pool_map[object];
-        lock.unlock();
+        VkCommandPool pool = command_pool_map.find(object).second;
         // We set up a read guard against the "Contents" counter to catch conflict vs. vkResetCommandPool and vkDestroyCommandPool
         // while *not* establishing a read guard against the command pool counter itself to avoid false postives for
         // non-externally sync'd command buffers
@@ -503,11 +562,14 @@ WRAPPER(uint64_t)
     }
     void FinishReadObject(VkCommandBuffer object) {
         c_VkCommandBuffer.FinishRead(object);
-        std::unique_lock<std::mutex> lock(command_pool_lock);
-        VkCommandPool pool = command_pool_map[object];
-        lock.unlock();
+        VkCommandPool pool = command_pool_map.find(object).second;
         c_VkCommandPoolContents.FinishRead(pool);
-    } """
+    }
+    void DestroyObject(VkCommandBuffer object) {
+        c_VkCommandBuffer.DestroyObject(object);
+    }
+    void DestroyPoolCommandBuffers(VkCommandPool commandPool);
+    void DestroyPoolDescriptorSets(VkDescriptorPool descriptorPool); """
 
 
     inline_custom_source_preamble = """
@@ -525,8 +587,10 @@ void ThreadSafety::PostCallRecordAllocateCommandBuffers(VkDevice device, const V
     // Record mapping from command buffer to command pool
     if(pCommandBuffers) {
         std::lock_guard<std::mutex> lock(command_pool_lock);
+        auto &pool_command_buffers = pool_command_buffers_map[pAllocateInfo->commandPool];
         for (uint32_t index = 0; index < pAllocateInfo->commandBufferCount; index++) {
-            command_pool_map[pCommandBuffers[index]] = pAllocateInfo->commandPool;
+            command_pool_map.insert_or_assign(pCommandBuffers[index], pAllocateInfo->commandPool);
+            pool_command_buffers.insert(pCommandBuffers[index]);
         }
     }
 }
@@ -543,6 +607,103 @@ void ThreadSafety::PostCallRecordAllocateDescriptorSets(VkDevice device, const V
     FinishReadObject(device);
     FinishWriteObject(pAllocateInfo->descriptorPool);
     // Host access to pAllocateInfo::descriptorPool must be externally synchronized
+    if (VK_SUCCESS == result) {
+        std::lock_guard<std::mutex> lock(descriptor_pool_lock);
+        auto &pool_descriptor_sets = pool_descriptor_sets_map[pAllocateInfo->descriptorPool];
+        for (uint32_t index = 0; index < pAllocateInfo->descriptorSetCount; index++) {
+            pool_descriptor_sets.insert(pDescriptorSets[index]);
+        }
+    }
+}
+
+void ThreadSafety::PreCallRecordFreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool, uint32_t descriptorSetCount,
+                                                   const VkDescriptorSet *pDescriptorSets) {
+    StartReadObject(device);
+    StartWriteObject(descriptorPool);
+    if (pDescriptorSets) {
+        for (uint32_t index = 0; index < descriptorSetCount; index++) {
+            StartWriteObject(pDescriptorSets[index]);
+        }
+    }
+    // Host access to descriptorPool must be externally synchronized
+    // Host access to each member of pDescriptorSets must be externally synchronized
+}
+
+void ThreadSafety::PostCallRecordFreeDescriptorSets(VkDevice device, VkDescriptorPool descriptorPool, uint32_t descriptorSetCount,
+                                                    const VkDescriptorSet *pDescriptorSets, VkResult result) {
+    FinishReadObject(device);
+    FinishWriteObject(descriptorPool);
+    if (pDescriptorSets) {
+        for (uint32_t index = 0; index < descriptorSetCount; index++) {
+            FinishWriteObject(pDescriptorSets[index]);
+        }
+        std::lock_guard<std::mutex> lock(descriptor_pool_lock);
+        auto &pool_descriptor_sets = pool_descriptor_sets_map[descriptorPool];
+        for (uint32_t index = 0; index < descriptorSetCount; index++) {
+            DestroyObject(pDescriptorSets[index]);
+            pool_descriptor_sets.erase(pDescriptorSets[index]);
+        }
+    }
+    // Host access to descriptorPool must be externally synchronized
+    // Host access to each member of pDescriptorSets must be externally synchronized
+}
+
+// Drop the use tracking of every command buffer allocated from a pool that is being destroyed
+void ThreadSafety::DestroyPoolCommandBuffers(VkCommandPool commandPool) {
+    std::lock_guard<std::mutex> lock(command_pool_lock);
+    auto pool_command_buffers = pool_command_buffers_map.find(commandPool);
+    if (pool_command_buffers != pool_command_buffers_map.end()) {
+        for (auto command_buffer : pool_command_buffers->second) {
+            command_pool_map.erase(command_buffer);
+            DestroyObject(command_buffer);
+        }
+        pool_command_buffers_map.erase(pool_command_buffers);
+    }
+}
+
+// Drop the use tracking of every descriptor set allocated from a pool that is being reset or destroyed
+void ThreadSafety::DestroyPoolDescriptorSets(VkDescriptorPool descriptorPool) {
+    std::lock_guard<std::mutex> lock(descriptor_pool_lock);
+    auto pool_descriptor_sets = pool_descriptor_sets_map.find(descriptorPool);
+    if (pool_descriptor_sets != pool_descriptor_sets_map.end()) {
+        for (auto descriptor_set : pool_descriptor_sets->second) {
+            DestroyObject(descriptor_set);
+        }
+        pool_descriptor_sets_map.erase(pool_descriptor_sets);
+    }
+}
+
+void ThreadSafety::PreCallRecordResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
+                                                    VkDescriptorPoolResetFlags flags) {
+    StartReadObject(device);
+    StartWriteObject(descriptorPool);
+    // Host access to descriptorPool must be externally synchronized
+    // any sname:VkDescriptorSet objects allocated from pname:descriptorPool must be externally synchronized between host accesses
+}
+
+void ThreadSafety::PostCallRecordResetDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
+                                                     VkDescriptorPoolResetFlags flags, VkResult result) {
+    FinishReadObject(device);
+    FinishWriteObject(descriptorPool);
+    DestroyPoolDescriptorSets(descriptorPool);
+    // Host access to descriptorPool must be externally synchronized
+    // any sname:VkDescriptorSet objects allocated from pname:descriptorPool must be externally synchronized between host accesses
+}
+
+void ThreadSafety::PreCallRecordDestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
+                                                      const VkAllocationCallbacks *pAllocator) {
+    StartReadObject(device);
+    StartWriteObject(descriptorPool);
+    // Host access to descriptorPool must be externally synchronized
+}
+
+void ThreadSafety::PostCallRecordDestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool,
+                                                       const VkAllocationCallbacks *pAllocator) {
+    FinishReadObject(device);
+    FinishWriteObject(descriptorPool);
+    DestroyPoolDescriptorSets(descriptorPool);
+    DestroyObject(descriptorPool);
+    // Host access to descriptorPool must be externally synchronized
 }
 
 void ThreadSafety::PreCallRecordFreeCommandBuffers(VkDevice device, VkCommandPool commandPool, uint32_t commandBufferCount,
@@ -561,10 +722,12 @@ void ThreadSafety::PreCallRecordFreeCommandBuffers(VkDevice device, VkCommandPoo
         for (uint32_t index = 0; index < commandBufferCount; index++) {
             FinishWriteObject(pCommandBuffers[index], lockCommandPool);
         }
-        // Holding the lock for the shortest time while we update the map
         std::lock_guard<std::mutex> lock(command_pool_lock);
+        auto &pool_command_buffers = pool_command_buffers_map[commandPool];
         for (uint32_t index = 0; index < commandBufferCount; index++) {
             command_pool_map.erase(pCommandBuffers[index]);
+            DestroyObject(pCommandBuffers[index]);
+            pool_command_buffers.erase(pCommandBuffers[index]);
         }
     }
 }
@@ -587,6 +750,8 @@ void ThreadSafety::PostCallRecordResetCommandPool(VkDevice device, VkCommandPool
     FinishReadObject(device);
     FinishWriteObject(commandPool);
     c_VkCommandPoolContents.FinishWrite(commandPool);
+    // The pool's command buffers keep their handles, but no thread should carry a cached entry for one across the reset
+    c_VkCommandBuffer.InvalidateCachedUses();
     // Host access to commandPool must be externally synchronized
 }
 
@@ -602,6 +767,9 @@ void ThreadSafety::PostCallRecordDestroyCommandPool(VkDevice device, VkCommandPo
     FinishReadObject(device);
     FinishWriteObject(commandPool);
     c_VkCommandPoolContents.FinishWrite(commandPool);
+    c_VkCommandPoolContents.DestroyObject(commandPool);
+    DestroyPoolCommandBuffers(commandPool);
+    DestroyObject(commandPool);
 }
 
 // GetSwapchainImages can return a non-zero count with a NULL pSwapchainImages pointer.  Let's avoid crashes by ignoring
@@ -697,7 +865,7 @@ void ThreadSafety::PostCallRecordGetSwapchainImagesKHR(VkDevice device, VkSwapch
         else:
             return False
 
-    def makeThreadUseBlock(self, cmd, functionprefix):
+    def makeThreadUseBlock(self, cmd, functionprefix, destroyobjectblock=''):
         """Generate C function pointer typedef for <command> Element"""
         paramdecl = ''
         # Find and add any parameters that are thread unsafe
@@ -777,6 +945,7 @@ void ThreadSafety::PostCallRecordGetSwapchainImagesKHR(VkDevice device, VkSwapch
                             # Pointer params are often being created.
                             # They are not being read from.
                             paramdecl += functionprefix + 'ReadObject(' + paramname.text + ');\n'
+        paramdecl += destroyobjectblock
         explicitexternsyncparams = cmd.findall("param[@externsync]")
         if (explicitexternsyncparams is not None):
             for param in explicitexternsyncparams:
@@ -806,6 +975,19 @@ void ThreadSafety::PostCallRecordGetSwapchainImagesKHR(VkDevice device, VkSwapch
             return None
         else:
             return paramdecl
+    # vkDestroy* and vkFree* commands end the tracking of the object they destroy, which is their last externally
+    # synchronized handle parameter
+    def makeDestroyObjectBlock(self, cmd, name):
+        if not name.startswith('vkDestroy') and not name.startswith('vkFree'):
+            return ''
+        destroyed = None
+        for param in cmd.findall('param'):
+            paramtype = param.find('type').text
+            if param.attrib.get('externsync') == 'true' and (self.isHandleTypeDispatchable(paramtype) or self.isHandleTypeNonDispatchable(paramtype)):
+                destroyed = param
+        if destroyed is None or self.paramIsArray(destroyed):
+            return ''
+        return 'DestroyObject(' + destroyed.find('name').text + ');\n'
     def beginFile(self, genOpts):
         OutputGenerator.beginFile(self, genOpts)
         #
@@ -926,6 +1108,9 @@ void ThreadSafety::PostCallRecordGetSwapchainImagesKHR(VkDevice device, VkSwapch
             'vkResetCommandPool',
             'vkDestroyCommandPool',
             'vkAllocateDescriptorSets',
+            'vkFreeDescriptorSets',
+            'vkResetDescriptorPool',
+            'vkDestroyDescriptorPool',
             'vkQueuePresentKHR',
             'vkGetSwapchainImagesKHR',
         ]
@@ -940,7 +1125,7 @@ void ThreadSafety::PostCallRecordGetSwapchainImagesKHR(VkDevice device, VkSwapch
         startthreadsafety = self.makeThreadUseBlock(cmdinfo.elem, 'Start')
         if startthreadsafety is None:
             return
-        finishthreadsafety = self.makeThreadUseBlock(cmdinfo.elem, 'Finish')
+        finishthreadsafety = self.makeThreadUseBlock(cmdinfo.elem, 'Finish', self.makeDestroyObjectBlock(cmdinfo.elem, name))
 
         OutputGenerator.genCmd(self, cmdinfo, name, alias)
 
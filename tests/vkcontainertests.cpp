@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2019 The Khronos Group Inc.
+ * Copyright (c) 2019 Valve Corporation
+ * Copyright (c) 2019 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "interval_tree.h"
+#include "sparse_containers.h"
+
+//
+// CONTAINER TESTS
+//
+// The layers' own containers, tested directly rather than through the API
+
+// Plain vector with the update semantics of SparseVector, to check the other access modes against
+template <bool kSetReplaces>
+class ReferenceVector {
+   public:
+    ReferenceVector(uint32_t start, uint32_t end) : range_min_(start), values_(end - start, 0) {}
+
+    uint32_t Get(uint32_t index) const { return values_[index - range_min_]; }
+    bool Set(uint32_t index, uint32_t value) {
+        uint32_t &current = values_[index - range_min_];
+        if ((!kSetReplaces && (current != 0)) || (current == value)) return false;
+        current = value;
+        return true;
+    }
+    bool SetRange(uint32_t start, uint32_t end, uint32_t value) {
+        bool updated = false;
+        for (uint32_t index = start; index < end; ++index) updated |= Set(index, value);
+        return updated;
+    }
+
+   private:
+    uint32_t range_min_;
+    std::vector<uint32_t> values_;
+};
+
+// Check every way of reading a SparseVector against the reference
+template <typename Vector, typename Reference>
+static void ExpectSameContents(const Vector &vector, const Reference &reference) {
+    const uint32_t range_min = vector.RangeMin();
+    const uint32_t range_max = vector.RangeMax();
+    for (uint32_t index = range_min; index < range_max; ++index) {
+        ASSERT_EQ(vector.Get(index), reference.Get(index)) << "at index " << index;
+
+        uint32_t run_end = range_max;
+        const uint32_t value = vector.GetRun(index, &run_end);
+        ASSERT_EQ(value, reference.Get(index)) << "at index " << index;
+        ASSERT_GT(run_end, index);
+        for (uint32_t in_run = index; in_run < run_end; ++in_run) {
+            ASSERT_EQ(reference.Get(in_run), value) << "at index " << in_run;
+        }
+        // Runs are kept merged, so in range access mode the run end is exact
+        if (vector.IsRange() && (run_end < range_max)) {
+            ASSERT_NE(reference.Get(run_end), value) << "at index " << run_end;
+        }
+    }
+
+    uint32_t expected = range_min;
+    for (auto it = vector.cbegin(); it != vector.cend(); ++it) {
+        while ((expected < range_max) && (reference.Get(expected) == 0)) ++expected;
+        ASSERT_LT(expected, range_max);
+        ASSERT_EQ((*it).first, expected);
+        ASSERT_EQ((*it).second, reference.Get(expected));
+        ++expected;
+    }
+    while ((expected < range_max) && (reference.Get(expected) == 0)) ++expected;
+    ASSERT_EQ(expected, range_max);
+}
+
+// Apply the same random runs of updates to a SparseVector and to the reference, checking the update results and contents
+template <bool kSetReplaces>
+static void RangeAccessMatchesReference(uint32_t seed) {
+    typedef sparse_container::SparseVector<uint32_t, uint32_t, kSetReplaces, 0, 16, true> Vector;
+    const uint32_t range_min = 8;
+    const uint32_t range_max = 520;
+    std::mt19937 rng(seed);
+    auto random_index = [&]() { return range_min + static_cast<uint32_t>(rng() % (range_max - range_min)); };
+    // A few values, so that equal neighbors are common
+    auto random_value = [&]() { return static_cast<uint32_t>(rng() % 4); };
+
+    Vector vector(range_min, range_max);
+    ReferenceVector<kSetReplaces> reference(range_min, range_max);
+    ASSERT_TRUE(vector.IsRange());
+    for (uint32_t step = 0; step < 400; ++step) {
+        const uint32_t value = random_value();
+        switch (rng() % 4) {
+            case 0: {
+                const uint32_t index = random_index();
+                ASSERT_EQ(vector.Set(index, value), reference.Set(index, value));
+                break;
+            }
+            case 1: {
+                uint32_t start = random_index();
+                uint32_t end = random_index();
+                if (start > end) std::swap(start, end);
+                ASSERT_EQ(vector.SetRange(start, end + 1, value), reference.SetRange(start, end + 1, value));
+                break;
+            }
+            case 2:
+                ASSERT_EQ(vector.SetRange(range_min, range_max, value), reference.SetRange(range_min, range_max, value));
+                break;
+            default: {
+                // Merge a smaller vector of the same kind, which may itself be in range or dense access mode
+                const uint32_t start = random_index();
+                const uint32_t end = std::min(range_max, start + 1 + static_cast<uint32_t>(rng() % 64));
+                Vector from(start, end);
+                for (uint32_t writes = rng() % 8; writes > 0; --writes) {
+                    const uint32_t from_start = start + static_cast<uint32_t>(rng() % (end - start));
+                    const uint32_t from_end = std::min(end, from_start + 1 + static_cast<uint32_t>(rng() % 16));
+                    from.SetRange(from_start, from_end, random_value());
+                }
+                bool expected = false;
+                for (uint32_t index = start; index < end; ++index) {
+                    if (from.Get(index) != 0) expected |= reference.Set(index, from.Get(index));
+                }
+                ASSERT_EQ(vector.Merge(from), expected);
+                break;
+            }
+        }
+        ASSERT_NO_FATAL_FAILURE(ExpectSameContents(vector, reference)) << "after step " << step;
+    }
+}
+
+TEST(SparseVector, RangeAccessReplaceMatchesReference) {
+    for (uint32_t seed = 1; seed <= 8; ++seed) {
+        ASSERT_NO_FATAL_FAILURE(RangeAccessMatchesReference<true>(seed)) << "with seed " << seed;
+    }
+}
+
+TEST(SparseVector, RangeAccessWriteOnceMatchesReference) {
+    for (uint32_t seed = 1; seed <= 8; ++seed) {
+        ASSERT_NO_FATAL_FAILURE(RangeAccessMatchesReference<false>(seed)) << "with seed " << seed;
+    }
+}
+
+TEST(SparseVector, RangeAccessMergesRuns) {
+    sparse_container::SparseVector<uint32_t, uint32_t, true, 0, 16, true> vector(0, 1024);
+
+    // Adjacent and overlapping writes of one value make a single run
+    EXPECT_TRUE(vector.SetRange(0, 100, 1));
+    EXPECT_TRUE(vector.SetRange(100, 200, 1));
+    EXPECT_TRUE(vector.SetRange(150, 300, 1));
+    EXPECT_FALSE(vector.SetRange(10, 290, 1));
+    ASSERT_TRUE(vector.IsRange());
+    EXPECT_EQ(vector.ranges_->size(), 1u);
+    uint32_t run_end = 1024;
+    EXPECT_EQ(vector.GetRun(0, &run_end), 1u);
+    EXPECT_EQ(run_end, 300u);
+
+    // Splitting a run and writing the gap back rejoins it
+    EXPECT_TRUE(vector.SetRange(100, 110, 2));
+    EXPECT_EQ(vector.ranges_->size(), 3u);
+    EXPECT_TRUE(vector.SetRange(100, 110, 1));
+    EXPECT_EQ(vector.ranges_->size(), 1u);
+
+    // Writing the default value removes what it covers
+    EXPECT_TRUE(vector.SetRange(0, 1024, 0));
+    EXPECT_TRUE(vector.ranges_->empty());
+    EXPECT_TRUE(vector.cbegin() == vector.cend());
+}
+
+TEST(SparseVector, RangeAccessConvertsToDenseAndBack) {
+    const uint32_t size = 64;
+    sparse_container::SparseVector<uint32_t, uint32_t, true, 0, 16, true> vector(0, size);
+    ReferenceVector<true> reference(0, size);
+
+    // Alternating values can't be merged, so the runs soon pass the conversion threshold
+    for (uint32_t index = 0; index < size; ++index) {
+        vector.Set(index, 1 + (index & 1));
+        reference.Set(index, 1 + (index & 1));
+    }
+    EXPECT_FALSE(vector.IsRange());
+    ASSERT_NO_FATAL_FAILURE(ExpectSameContents(vector, reference));
+
+    // A full range write makes the dense copy redundant
+    EXPECT_TRUE(vector.SetRange(0, size, 3));
+    reference.SetRange(0, size, 3);
+    EXPECT_TRUE(vector.IsRange());
+    ASSERT_NO_FATAL_FAILURE(ExpectSameContents(vector, reference));
+    EXPECT_FALSE(vector.SetRange(0, size, 3));
+}
+
+TEST(SparseVector, RangeAccessWriteOnceFillsGaps) {
+    sparse_container::SparseVector<uint32_t, uint32_t, false, 0, 16, true> vector(0, 256);
+
+    EXPECT_TRUE(vector.SetRange(10, 20, 1));
+    EXPECT_TRUE(vector.SetRange(30, 40, 2));
+    // Only the gaps take the new value
+    EXPECT_TRUE(vector.SetRange(0, 256, 3));
+    EXPECT_FALSE(vector.SetRange(0, 256, 4));
+    EXPECT_EQ(vector.Get(5), 3u);
+    EXPECT_EQ(vector.Get(15), 1u);
+    EXPECT_EQ(vector.Get(25), 3u);
+    EXPECT_EQ(vector.Get(35), 2u);
+    EXPECT_EQ(vector.Get(255), 3u);
+    EXPECT_EQ(vector.ranges_->size(), 5u);
+}
+
+// The intervals of an IntervalTree<uint32_t, uint32_t> that overlap [begin, end], in traversal order
+static std::vector<std::pair<uint32_t, uint32_t>> FindOverlaps(const IntervalTree<uint32_t, uint32_t> &tree, uint32_t begin,
+                                                               uint32_t end) {
+    std::vector<std::pair<uint32_t, uint32_t>> overlaps;  // {begin, value}
+    tree.ForEachOverlap(begin, end, [&](uint32_t overlap_begin, uint32_t overlap_end, uint32_t value) {
+        EXPECT_LE(overlap_begin, end);
+        EXPECT_GE(overlap_end, begin);
+        overlaps.emplace_back(overlap_begin, value);
+        return true;
+    });
+    return overlaps;
+}
+
+TEST(IntervalTree, OverlapIsInclusive) {
+    IntervalTree<uint32_t, uint32_t> tree;
+    tree.Insert(10, 19, 1);
+    tree.Insert(20, 29, 2);
+    tree.Insert(0, 100, 3);
+    tree.Insert(20, 20, 4);
+
+    typedef std::vector<std::pair<uint32_t, uint32_t>> Overlaps;
+    EXPECT_EQ(FindOverlaps(tree, 19, 19), (Overlaps{{0, 3}, {10, 1}}));
+    EXPECT_EQ(FindOverlaps(tree, 19, 20), (Overlaps{{0, 3}, {10, 1}, {20, 2}, {20, 4}}));
+    EXPECT_EQ(FindOverlaps(tree, 30, 100), (Overlaps{{0, 3}}));
+    EXPECT_EQ(FindOverlaps(tree, 101, 200), Overlaps());
+
+    // Returning false stops the traversal
+    uint32_t visited = 0;
+    EXPECT_FALSE(tree.ForEachOverlap(0, 100, [&](uint32_t, uint32_t, uint32_t) { return ++visited < 2; }));
+    EXPECT_EQ(visited, 2u);
+}
+
+TEST(IntervalTree, EraseOnlyTheGivenInterval) {
+    IntervalTree<uint32_t, uint32_t> tree;
+    tree.Insert(0, 9, 1);
+    tree.Insert(0, 19, 2);
+    tree.Insert(5, 9, 3);
+    EXPECT_EQ(tree.size(), 3u);
+
+    // Intervals are identified by begin and value
+    EXPECT_FALSE(tree.Erase(5, 1));
+    EXPECT_FALSE(tree.Erase(1, 1));
+    EXPECT_TRUE(tree.Erase(0, 1));
+    EXPECT_FALSE(tree.Erase(0, 1));
+    EXPECT_EQ(tree.size(), 2u);
+    typedef std::vector<std::pair<uint32_t, uint32_t>> Overlaps;
+    EXPECT_EQ(FindOverlaps(tree, 0, 100), (Overlaps{{0, 2}, {5, 3}}));
+
+    EXPECT_TRUE(tree.Erase(0, 2));
+    EXPECT_TRUE(tree.Erase(5, 3));
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(FindOverlaps(tree, 0, 100), Overlaps());
+}
+
+TEST(IntervalTree, Rebind) {
+    // As when the same object is bound again at another offset, its old interval is erased and a new one inserted
+    IntervalTree<uint32_t, uint32_t> tree;
+    for (uint32_t value = 0; value < 64; ++value) tree.Insert(value * 16, value * 16 + 15, value);
+    for (uint32_t value = 0; value < 64; value += 2) {
+        ASSERT_TRUE(tree.Erase(value * 16, value));
+        tree.Insert(1024 + value * 16, 1024 + value * 16 + 15, value);
+    }
+    EXPECT_EQ(tree.size(), 64u);
+
+    typedef std::vector<std::pair<uint32_t, uint32_t>> Overlaps;
+    EXPECT_EQ(FindOverlaps(tree, 0, 15), Overlaps());
+    EXPECT_EQ(FindOverlaps(tree, 16, 31), (Overlaps{{16, 1}}));
+    EXPECT_EQ(FindOverlaps(tree, 1024, 1039), (Overlaps{{1024, 0}}));
+    EXPECT_EQ(FindOverlaps(tree, 1008, 1024), (Overlaps{{1008, 63}, {1024, 0}}));
+    // The old intervals are gone, so they can't be erased again
+    EXPECT_FALSE(tree.Erase(0, 0));
+    EXPECT_TRUE(tree.Erase(1024, 0));
+}
+
+TEST(IntervalTree, MatchesBruteForce) {
+    IntervalTree<uint32_t, uint32_t> tree;
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> intervals;  // {begin, value} -> end, in traversal order
+    std::mt19937 rng(1);
+    uint32_t next_value = 0;
+    for (uint32_t step = 0; step < 20000; ++step) {
+        const uint32_t begin = rng() % 4096;
+        const uint32_t end = begin + rng() % 64;
+        if (intervals.empty() || (rng() % 3)) {
+            tree.Insert(begin, end, next_value);
+            intervals[std::make_pair(begin, next_value++)] = end;
+        } else {
+            // Erase an existing interval, or try one that isn't there
+            auto it = intervals.lower_bound(std::make_pair(begin, 0u));
+            if (it == intervals.end()) it = intervals.begin();
+            if (rng() % 8) {
+                ASSERT_TRUE(tree.Erase(it->first.first, it->first.second));
+                intervals.erase(it);
+            } else {
+                ASSERT_FALSE(tree.Erase(begin, next_value));
+            }
+        }
+        ASSERT_EQ(tree.size(), intervals.size());
+
+        std::vector<std::pair<uint32_t, uint32_t>> expected;
+        for (const auto &interval : intervals) {
+            if ((interval.first.first <= end) && (interval.second >= begin)) expected.push_back(interval.first);
+        }
+        ASSERT_EQ(FindOverlaps(tree, begin, end), expected) << "at step " << step;
+    }
+}
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2015-2019 The Khronos Group Inc.
+ * Copyright (c) 2015-2019 Valve Corporation
+ * Copyright (c) 2015-2019 LunarG, Inc.
+ * Copyright (c) 2015-2019 Google, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "vklayertest.h"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "concurrent_map.h"
+#include "sparse_containers.h"
+
+//
+// VALIDATION BENCHMARKS
+//
+// These measure the cost of validation rather than its results, so they are built into vk_layer_validation_benchmarks
+// instead of the test suite, and print their timings. They fail only if a validation error is reported.
+
+class VkLayerBenchmark : public VkLayerTest {
+   public:
+   protected:
+};
+
+TEST_F(VkLayerBenchmark, RepeatedDraws) {
+    TEST_DESCRIPTION("Record 100k draws with unchanged bound state, then 100k rebinding the descriptor set before each draw.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+    ASSERT_NO_FATAL_FAILURE(InitViewport());
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+
+    OneOffDescriptorSet ds(m_device, {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr}});
+    ASSERT_TRUE(ds.Initialized());
+    const VkPipelineLayoutObj pipeline_layout(m_device, {&ds.layout_});
+
+    VkBufferObj buffer;
+    buffer.init(*m_device, buffer.create_info(256, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT));
+    VkDescriptorBufferInfo buffer_info = {buffer.handle(), 0, VK_WHOLE_SIZE};
+    VkWriteDescriptorSet descriptor_write = {};
+    descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_write.dstSet = ds.set_;
+    descriptor_write.dstBinding = 0;
+    descriptor_write.descriptorCount = 1;
+    descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptor_write.pBufferInfo = &buffer_info;
+    vkUpdateDescriptorSets(m_device->device(), 1, &descriptor_write, 0, NULL);
+
+    char const *fsSource =
+        "#version 450\n"
+        "\n"
+        "layout(location=0) out vec4 x;\n"
+        "layout(set=0) layout(binding=0) uniform foo { vec4 y; } bar;\n"
+        "void main(){\n"
+        "   x = bar.y;\n"
+        "}\n";
+    VkShaderObj vs(m_device, bindStateVertShaderText, VK_SHADER_STAGE_VERTEX_BIT, this);
+    VkShaderObj fs(m_device, fsSource, VK_SHADER_STAGE_FRAGMENT_BIT, this);
+    VkPipelineObj pipe(m_device);
+    pipe.SetViewport(m_viewports);
+    pipe.SetScissor(m_scissors);
+    pipe.AddShader(&vs);
+    pipe.AddShader(&fs);
+    pipe.AddDefaultColorAttachment();
+    pipe.CreateVKPipeline(pipeline_layout.handle(), renderPass());
+
+    m_errorMonitor->ExpectSuccess();
+    m_commandBuffer->begin();
+    m_commandBuffer->BeginRenderPass(m_renderPassBeginInfo);
+    vkCmdBindPipeline(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.handle());
+    vkCmdBindDescriptorSets(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1, &ds.set_,
+                            0, NULL);
+
+    const uint32_t draw_count = 100000;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < draw_count; i++) {
+        vkCmdDraw(m_commandBuffer->handle(), 3, 1, 0, 0);
+    }
+    const std::chrono::duration<double, std::milli> unchanged = std::chrono::steady_clock::now() - start;
+
+    // Each bind changes the bound state, so every draw is validated in full
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < draw_count; i++) {
+        vkCmdBindDescriptorSets(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1,
+                                &ds.set_, 0, NULL);
+        vkCmdDraw(m_commandBuffer->handle(), 3, 1, 0, 0);
+    }
+    const std::chrono::duration<double, std::milli> rebound = std::chrono::steady_clock::now() - start;
+
+    m_commandBuffer->EndRenderPass();
+    m_commandBuffer->end();
+    m_errorMonitor->VerifyNotFound();
+    printf("%u draws: %.1f ms with unchanged bound state, %.1f ms rebinding the descriptor set before each draw\n", draw_count,
+           unchanged.count(), rebound.count());
+}
+
+TEST_F(VkLayerBenchmark, BindManyBuffers) {
+    TEST_DESCRIPTION("Bind 100k buffers back to back into one allocation, then destroy them.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    const uint32_t buffer_count = 100000;
+    VkBufferCreateInfo buffer_info = {};
+    buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_info.size = 256;
+    buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    std::vector<VkBuffer> buffers(buffer_count);
+    for (auto &buffer : buffers) {
+        ASSERT_VK_SUCCESS(vkCreateBuffer(m_device->device(), &buffer_info, NULL, &buffer));
+    }
+
+    VkMemoryRequirements memory_reqs;
+    vkGetBufferMemoryRequirements(m_device->device(), buffers[0], &memory_reqs);
+    const VkDeviceSize stride = (memory_reqs.size + memory_reqs.alignment - 1) / memory_reqs.alignment * memory_reqs.alignment;
+    VkMemoryAllocateInfo memory_info = {};
+    memory_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memory_info.allocationSize = stride * buffer_count;
+    ASSERT_TRUE(m_device->phy().set_memory_type(memory_reqs.memoryTypeBits, &memory_info, 0));
+    VkDeviceMemory memory;
+    VkResult err = vkAllocateMemory(m_device->device(), &memory_info, NULL, &memory);
+    if (err != VK_SUCCESS) {
+        for (auto buffer : buffers) vkDestroyBuffer(m_device->device(), buffer, NULL);
+        printf("%s Could not allocate memory for %u buffers, skipping test\n", kSkipPrefix, buffer_count);
+        return;
+    }
+
+    m_errorMonitor->ExpectSuccess();
+    // Each bind is checked for overlap against the ranges already bound to the memory
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < buffer_count; i++) {
+        vkBindBufferMemory(m_device->device(), buffers[i], memory, i * stride);
+    }
+    const std::chrono::duration<double, std::milli> bind = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (auto buffer : buffers) vkDestroyBuffer(m_device->device(), buffer, NULL);
+    const std::chrono::duration<double, std::milli> destroy = std::chrono::steady_clock::now() - start;
+    m_errorMonitor->VerifyNotFound();
+    vkFreeMemory(m_device->device(), memory, NULL);
+    printf("%u buffers: %.1f ms to bind, %.1f ms to destroy\n", buffer_count, bind.count(), destroy.count());
+}
+
+// Replay the layout tracking of one command buffer on a 12 mip, 2048 layer depth/stencil image: a whole image transition,
+// per-mip transitions, scattered single layer transitions, a walk over the result by run and a merge into the global map.
+// Returns the time per replay in ms.
+template <typename LayoutMap>
+static double TimeLayoutMapReplays(uint32_t replays) {
+    const uint32_t aspects = 2, mips = 12, layers = 2048;
+    const uint32_t subresources = aspects * mips * layers;
+    std::mt19937 rng(1);
+    uint64_t sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t replay = 0; replay < replays; replay++) {
+        LayoutMap cb_map(0, subresources);
+        LayoutMap global_map(0, subresources);
+        cb_map.SetRange(0, subresources, 1);
+        for (uint32_t aspect = 0; aspect < aspects; aspect++) {
+            for (uint32_t mip = 0; mip < mips; mip++) {
+                const uint32_t base = (aspect * mips + mip) * layers;
+                cb_map.SetRange(base, base + layers, 2 + (mip & 1));
+            }
+        }
+        for (uint32_t write = 0; write < 64; write++) {
+            cb_map.Set(static_cast<uint32_t>(rng() % subresources), 4);
+        }
+        for (uint32_t index = 0; index < subresources;) {
+            uint32_t run_end = subresources;
+            sum += cb_map.GetRun(index, &run_end);
+            index = run_end;
+        }
+        global_map.Merge(cb_map);
+        sum += global_map.Get(subresources - 1);
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_NE(sum, 0u);  // Using the result keeps the work from being optimized away
+    return elapsed.count() / replays;
+}
+
+TEST_F(VkLayerBenchmark, SparseVectorAccessModes) {
+    TEST_DESCRIPTION("Track the layouts of a large image through a command buffer with each SparseVector access mode.");
+
+    using sparse_container::SparseVector;
+    const uint32_t replays = 20;
+    // A sparse threshold of 0 makes the vector dense from the start, the others start in sparse or range access
+    const double sparse = TimeLayoutMapReplays<SparseVector<uint32_t, uint32_t, true, 0, 64, false>>(replays);
+    const double dense = TimeLayoutMapReplays<SparseVector<uint32_t, uint32_t, true, 0, 0, false>>(replays);
+    const double range = TimeLayoutMapReplays<SparseVector<uint32_t, uint32_t, true, 0, 64, true>>(replays);
+    printf("Layout map replay: %.3f ms with sparse access, %.3f ms with dense access, %.3f ms with range access\n", sparse,
+           dense, range);
+}
+
+#if GTEST_IS_THREADSAFE
+// Print how recording throughput scales from one thread to several, with the current validation locking mode
+static void ReportParallelRecordingScaling(VkDeviceObj *device, ErrorMonitor *monitor, const char *mode) {
+    const double commands_per_thread = 80000.0;  // The loop count of AddToCommandBuffer
+
+    VkEventCreateInfo event_info = {};
+    event_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    VkEvent event;
+    VkResult err = vkCreateEvent(device->device(), &event_info, NULL, &event);
+    ASSERT_VK_SUCCESS(err);
+
+    const uint32_t thread_count = std::max(2u, std::min(16u, std::thread::hardware_concurrency()));
+    const double one_thread = commands_per_thread / RecordOnSeparatePools(device, monitor, event, 1);
+    const double many_threads = commands_per_thread * thread_count / RecordOnSeparatePools(device, monitor, event, thread_count);
+    printf("%s: %.0f commands/s on 1 thread, %.0f commands/s on %u threads (%.2fx)\n", mode, one_thread, many_threads,
+           thread_count, many_threads / one_thread);
+
+    vkDestroyEvent(device->device(), event, NULL);
+}
+
+TEST_F(VkLayerBenchmark, UnwrapScaling) {
+    TEST_DESCRIPTION("Look up wrapped handles in a map like unique_id_mapping on 1 to 32 threads at once.");
+
+    // This is the lookup every Unwrap does by default, and with embedded handles for handles that have no record. Unique ids
+    // are handed out sequentially from 1, as global_unique_id does.
+    const uint64_t handle_count = 4096;
+    const uint32_t lookups_per_thread = 1000000;
+    ConcurrentUnorderedMap<uint64_t, uint64_t> unique_id_mapping;
+    for (uint64_t id = 1; id <= handle_count; id++) {
+        unique_id_mapping.insert_or_assign(id, id * 16);
+    }
+
+    double one_thread = 0.0;
+    for (uint32_t thread_count = 1; thread_count <= 32; thread_count *= 2) {
+        std::atomic<bool> go(false);
+        std::atomic<uint64_t> found(0);
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < thread_count; t++) {
+            threads.emplace_back([&, t]() {
+                while (!go.load()) std::this_thread::yield();
+                uint64_t sum = 0;
+                for (uint32_t i = 0; i < lookups_per_thread; i++) {
+                    sum += unique_id_mapping.find(1 + (i * 7 + t * 613) % handle_count).second;
+                }
+                found += sum;
+            });
+        }
+        auto start = std::chrono::steady_clock::now();
+        go = true;
+        for (auto &thread : threads) thread.join();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // Using the result keeps the lookups from being optimized away
+        ASSERT_NE(found.load(), 0u);
+        const double lookups = double(lookups_per_thread) * thread_count / elapsed.count();
+        if (thread_count == 1) one_thread = lookups;
+        printf("Unwrap: %.0f lookups/s on %u threads (%.2fx)\n", lookups, thread_count, lookups / one_thread);
+    }
+}
+
+TEST_F(VkLayerBenchmark, ParallelRecordingConcurrent) {
+    TEST_DESCRIPTION("Recording throughput on one thread and on many, each with its own pool, with concurrent validation.");
+
+    ScopedLayerEnables enables("VALIDATION_CHECK_ENABLE_CONCURRENT_VALIDATION");
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    m_errorMonitor->ExpectSuccess();
+    ReportParallelRecordingScaling(m_device, m_errorMonitor, "Concurrent validation");
+    m_errorMonitor->VerifyNotFound();
+}
+
+TEST_F(VkLayerBenchmark, ParallelRecordingExclusive) {
+    TEST_DESCRIPTION("Recording throughput on one thread and on many, each with its own pool, with the default locking.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    m_errorMonitor->ExpectSuccess();
+    ReportParallelRecordingScaling(m_device, m_errorMonitor, "Exclusive validation");
+    m_errorMonitor->VerifyNotFound();
+}
+#endif  // GTEST_IS_THREADSAFE
@@ -1,6 +1,8 @@
 #include "cast_utils.h"
 #include "vklayertest.h"
 
+#include <chrono>
+
 VkFormat FindSupportedDepthStencilFormat(VkPhysicalDevice phy) {
     VkFormat ds_formats[] = {VK_FORMAT_D16_UNORM_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D32_SFLOAT_S8_UINT};
     for (uint32_t i = 0; i < sizeof(ds_formats); i++) {
@@ -118,6 +120,31 @@ VKAPI_ATTR VkBool32 VKAPI_CALL DebugUtilsCallback(VkDebugUtilsMessageSeverityFla
     return VK_FALSE;
 }
 
+static const char kLayerEnablesVar[] = "VK_LAYER_ENABLES";
+
+ScopedLayerEnables::ScopedLayerEnables(const char *enables) {
+    const char *previous = getenv(kLayerEnablesVar);
+    had_previous_ = (previous != nullptr);
+    if (had_previous_) previous_ = previous;
+#ifdef _WIN32
+    _putenv_s(kLayerEnablesVar, enables);
+#else
+    setenv(kLayerEnablesVar, enables, 1);
+#endif
+}
+
+ScopedLayerEnables::~ScopedLayerEnables() {
+#ifdef _WIN32
+    _putenv_s(kLayerEnablesVar, had_previous_ ? previous_.c_str() : "");
+#else
+    if (had_previous_) {
+        setenv(kLayerEnablesVar, previous_.c_str(), 1);
+    } else {
+        unsetenv(kLayerEnablesVar);
+    }
+#endif
+}
+
 #if GTEST_IS_THREADSAFE
 extern "C" void *AddToCommandBuffer(void *arg) {
     struct thread_data_struct *data = (struct thread_data_struct *)arg;
@@ -130,6 +157,43 @@ extern "C" void *AddToCommandBuffer(void *arg) {
     }
     return NULL;
 }
+
+double RecordOnSeparatePools(VkDeviceObj *device, ErrorMonitor *monitor, VkEvent event, uint32_t thread_count) {
+    // None of these command buffers or pools are shared, so no thread should ever wait on, or report, another
+    std::vector<std::unique_ptr<VkCommandPoolObj>> pools;
+    std::vector<std::unique_ptr<VkCommandBufferObj>> command_buffers;
+    std::vector<thread_data_struct> data(thread_count);
+    std::vector<test_platform_thread> threads(thread_count);
+    for (uint32_t i = 0; i < thread_count; i++) {
+        pools.emplace_back(new VkCommandPoolObj(device, device->graphics_queue_node_index_));
+        command_buffers.emplace_back(new VkCommandBufferObj(device, pools.back().get()));
+        command_buffers.back()->begin();
+        data[i].commandBuffer = command_buffers.back()->handle();
+        data[i].device = device->device();
+        data[i].event = event;
+        data[i].bailout = false;
+    }
+    monitor->SetBailout(&data[0].bailout);
+    for (uint32_t i = 1; i < thread_count; i++) {
+        monitor->AddBailout(&data[i].bailout);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 1; i < thread_count; i++) {
+        test_platform_thread_create(&threads[i], AddToCommandBuffer, (void *)&data[i]);
+    }
+    AddToCommandBuffer(&data[0]);
+    for (uint32_t i = 1; i < thread_count; i++) {
+        test_platform_thread_join(threads[i], NULL);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    for (auto &command_buffer : command_buffers) {
+        command_buffer->end();
+    }
+    monitor->SetBailout(NULL);
+    return elapsed.count();
+}
 #endif  // GTEST_IS_THREADSAFE
 
 extern "C" void *ReleaseNullFence(void *arg) {
@@ -144,6 +208,23 @@ extern "C" void *ReleaseNullFence(void *arg) {
     return NULL;
 }
 
+extern "C" void *CreateAndDestroyEvents(void *arg) {
+    struct thread_data_struct *data = (struct thread_data_struct *)arg;
+
+    VkEventCreateInfo event_info = {};
+    event_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    for (int i = 0; i < 20000; i++) {
+        VkEvent event = VK_NULL_HANDLE;
+        if (vkCreateEvent(data->device, &event_info, NULL, &event) == VK_SUCCESS) {
+            vkDestroyEvent(data->device, event, NULL);
+        }
+        if (data->bailout) {
+            break;
+        }
+    }
+    return NULL;
+}
+
 void TestRenderPassCreate(ErrorMonitor *error_monitor, const VkDevice device, const VkRenderPassCreateInfo *create_info,
                           bool rp2Supported, const char *rp1_vuid, const char *rp2_vuid) {
     VkRenderPass render_pass = VK_NULL_HANDLE;
@@ -453,7 +534,7 @@ ErrorMonitor::~ErrorMonitor() { test_platform_thread_delete_mutex(&mutex_); }
 
 void ErrorMonitor::Reset() {
     message_flags_ = VK_DEBUG_REPORT_ERROR_BIT_EXT;
-    bailout_ = NULL;
+    bailouts_.clear();
     message_found_ = VK_FALSE;
     failure_message_strings_.clear();
     desired_message_strings_.clear();
@@ -483,8 +564,8 @@ void ErrorMonitor::SetUnexpectedError(const char *const msg) {
 VkBool32 ErrorMonitor::CheckForDesiredMsg(const char *const msgString) {
     VkBool32 result = VK_FALSE;
     test_platform_thread_lock_mutex(&mutex_);
-    if (bailout_ != nullptr) {
-        *bailout_ = true;
+    for (auto bailout : bailouts_) {
+        *bailout = true;
     }
     string errorString(msgString);
     bool found_expected = false;
@@ -535,7 +616,12 @@ void ErrorMonitor::SetError(const char *const errorString) {
     failure_message_strings_.insert(errorString);
 }
 
-void ErrorMonitor::SetBailout(bool *bailout) { bailout_ = bailout; }
+void ErrorMonitor::SetBailout(bool *bailout) {
+    bailouts_.clear();
+    if (bailout != nullptr) bailouts_.push_back(bailout);
+}
+
+void ErrorMonitor::AddBailout(bool *bailout) { bailouts_.push_back(bailout); }
 
 void ErrorMonitor::DumpFailureMsgs() const {
     vector<string> otherMsgs = GetOtherFailureMsgs();
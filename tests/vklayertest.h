@@ -209,6 +209,8 @@ class ErrorMonitor {
     bool AllDesiredMsgsFound() const;
     void SetError(const char *const errorString);
     void SetBailout(bool *bailout);
+    // Set another flag along with the one passed to SetBailout, for tests that need to stop more than one thread
+    void AddBailout(bool *bailout);
     void DumpFailureMsgs() const;
 
     // Helpers
@@ -230,7 +232,7 @@ class ErrorMonitor {
     std::vector<std::string> ignore_message_strings_;
     vector<string> other_messages_;
     test_platform_thread_mutex mutex_;
-    bool *bailout_;
+    vector<bool *> bailouts_;
     bool message_found_;
 };
 
@@ -593,6 +595,18 @@ VKAPI_ATTR VkBool32 VKAPI_CALL DebugUtilsCallback(VkDebugUtilsMessageSeverityFla
                                                   VkDebugUtilsMessageTypeFlagsEXT messageTypes,
                                                   const VkDebugUtilsMessengerCallbackDataEXT *pCallbackData, void *pUserData);
 
+// Sets VK_LAYER_ENABLES while alive, so that the validation layers created meanwhile, i.e. by Init(), turn on the given
+// enable, e.g. "VALIDATION_CHECK_ENABLE_CONCURRENT_VALIDATION"
+class ScopedLayerEnables {
+   public:
+    explicit ScopedLayerEnables(const char *enables);
+    ~ScopedLayerEnables();
+
+   private:
+    bool had_previous_;
+    std::string previous_;
+};
+
 #if GTEST_IS_THREADSAFE
 struct thread_data_struct {
     VkCommandBuffer commandBuffer;
@@ -602,10 +616,16 @@ struct thread_data_struct {
 };
 
 extern "C" void *AddToCommandBuffer(void *arg);
+
+// Run AddToCommandBuffer on thread_count threads at once, each recording into a command buffer from its own pool, and
+// return how long the recording took, in seconds
+double RecordOnSeparatePools(VkDeviceObj *device, ErrorMonitor *monitor, VkEvent event, uint32_t thread_count);
 #endif  // GTEST_IS_THREADSAFE
 
 extern "C" void *ReleaseNullFence(void *arg);
 
+extern "C" void *CreateAndDestroyEvents(void *arg);
+
 void TestRenderPassCreate(ErrorMonitor *error_monitor, const VkDevice device, const VkRenderPassCreateInfo *create_info,
                           bool rp2Supported, const char *rp1_vuid, const char *rp2_vuid);
 
@@ -7507,6 +7507,163 @@ TEST_F(VkLayerTest, WriteDescriptorSetConsecutiveUpdates) {
     m_errorMonitor->VerifyFound();
 }
 
+TEST_F(VkLayerTest, DrawRevalidatedAfterDescriptorSetRebind) {
+    TEST_DESCRIPTION(
+        "Draw cleanly, then bind a descriptor set that was never updated and draw again, verifying that the repeated draw is "
+        "not skipped as unchanged.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+    ASSERT_NO_FATAL_FAILURE(InitViewport());
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+
+    OneOffDescriptorSet ds(m_device, {
+                                         {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                     });
+    OneOffDescriptorSet ds_not_updated(m_device, {
+                                                     {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                                 });
+    const VkPipelineLayoutObj pipeline_layout(m_device, {&ds.layout_});
+
+    VkBufferObj buffer;
+    buffer.init(*m_device, VkBufferObj::create_info(1024, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT), VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+    VkDescriptorBufferInfo buffer_info = {buffer.handle(), 0, 1024};
+    VkWriteDescriptorSet descriptor_write = {};
+    descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_write.dstSet = ds.set_;
+    descriptor_write.dstBinding = 0;
+    descriptor_write.descriptorCount = 1;
+    descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptor_write.pBufferInfo = &buffer_info;
+    vkUpdateDescriptorSets(m_device->device(), 1, &descriptor_write, 0, NULL);
+
+    char const *fsSource =
+        "#version 450\n"
+        "\n"
+        "layout(location=0) out vec4 x;\n"
+        "layout(set=0) layout(binding=0) uniform foo { int x; } bar;\n"
+        "void main(){\n"
+        "   x = vec4(bar.x);\n"
+        "}\n";
+    VkShaderObj vs(m_device, bindStateVertShaderText, VK_SHADER_STAGE_VERTEX_BIT, this);
+    VkShaderObj fs(m_device, fsSource, VK_SHADER_STAGE_FRAGMENT_BIT, this);
+    VkPipelineObj pipe(m_device);
+    pipe.AddShader(&vs);
+    pipe.AddShader(&fs);
+    pipe.AddDefaultColorAttachment();
+    pipe.SetViewport(m_viewports);
+    pipe.SetScissor(m_scissors);
+    ASSERT_VK_SUCCESS(pipe.CreateVKPipeline(pipeline_layout.handle(), renderPass()));
+
+    m_commandBuffer->begin();
+    m_commandBuffer->BeginRenderPass(m_renderPassBeginInfo);
+    vkCmdBindPipeline(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipe.handle());
+    vkCmdBindDescriptorSets(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1, &ds.set_,
+                            0, nullptr);
+    m_errorMonitor->ExpectSuccess();
+    m_commandBuffer->Draw(3, 1, 0, 0);
+    m_commandBuffer->Draw(3, 1, 0, 0);
+    m_errorMonitor->VerifyNotFound();
+
+    vkCmdBindDescriptorSets(m_commandBuffer->handle(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.handle(), 0, 1,
+                            &ds_not_updated.set_, 0, nullptr);
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, kVUID_Core_DrawState_DescriptorSetNotUpdated);
+    m_commandBuffer->Draw(3, 1, 0, 0);
+    m_errorMonitor->VerifyFound();
+
+    m_commandBuffer->EndRenderPass();
+    m_commandBuffer->end();
+}
+
+// Dispatch with one binding of many storage buffers, two of which are never written. Draw-time validation has to report the
+// first of them, and only that one, whether or not the binding's checks are split across the parallel descriptor workers.
+static void VerifyFirstUnwrittenDescriptorReported(VkLayerTest *test, VkDeviceObj *device, VkCommandBufferObj *command_buffer,
+                                                   ErrorMonitor *monitor) {
+    const uint32_t descriptor_count = 6000;  // Above the 4096 descriptors from which a binding is split into tasks of 1024
+    const uint32_t first_unwritten = 4500;   // In the fifth task
+    const uint32_t second_unwritten = 5500;  // In the sixth
+
+    const VkPhysicalDeviceLimits &limits = device->props.limits;
+    if ((limits.maxPerStageDescriptorStorageBuffers < descriptor_count) ||
+        (limits.maxDescriptorSetStorageBuffers < descriptor_count) || (limits.maxPerStageResources < descriptor_count)) {
+        printf("%s Device can't use %u storage buffers in one stage; skipped.\n", kSkipPrefix, descriptor_count);
+        return;
+    }
+
+    OneOffDescriptorSet ds(device,
+                           {{0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, descriptor_count, VK_SHADER_STAGE_COMPUTE_BIT, nullptr}});
+    ASSERT_TRUE(ds.Initialized());
+    const VkPipelineLayoutObj pipeline_layout(device, {&ds.layout_});
+
+    VkBufferObj buffer;
+    VkMemoryPropertyFlags reqs = 0;
+    buffer.init(*device, buffer.create_info(256, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT), reqs);
+
+    // Write every descriptor but the two unwritten ones, in the three runs between them
+    const std::vector<VkDescriptorBufferInfo> buffer_infos(descriptor_count, {buffer.handle(), 0, VK_WHOLE_SIZE});
+    const uint32_t run_starts[] = {0, first_unwritten + 1, second_unwritten + 1};
+    const uint32_t run_ends[] = {first_unwritten, second_unwritten, descriptor_count};
+    for (uint32_t run = 0; run < 3; ++run) {
+        VkWriteDescriptorSet write = {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = ds.set_;
+        write.dstBinding = 0;
+        write.dstArrayElement = run_starts[run];
+        write.descriptorCount = run_ends[run] - run_starts[run];
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = buffer_infos.data();
+        vkUpdateDescriptorSets(device->device(), 1, &write, 0, nullptr);
+    }
+
+    char const *csSource =
+        "#version 450\n"
+        "\n"
+        "layout(local_size_x=1) in;\n"
+        "layout(set=0, binding=0) buffer block { vec4 x; } blocks[6000];\n"
+        "void main(){\n"
+        "   blocks[0].x = vec4(1);\n"
+        "}\n";
+    VkShaderObj cs(device, csSource, VK_SHADER_STAGE_COMPUTE_BIT, test);
+
+    VkComputePipelineCreateInfo cpci = {VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+                                        nullptr,
+                                        0,
+                                        {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0,
+                                         VK_SHADER_STAGE_COMPUTE_BIT, cs.handle(), "main", nullptr},
+                                        pipeline_layout.handle(),
+                                        VK_NULL_HANDLE,
+                                        -1};
+    VkPipeline pipeline;
+    VkResult err = vkCreateComputePipelines(device->device(), VK_NULL_HANDLE, 1, &cpci, nullptr, &pipeline);
+    ASSERT_VK_SUCCESS(err);
+
+    command_buffer->begin();
+    vkCmdBindPipeline(command_buffer->handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+    vkCmdBindDescriptorSets(command_buffer->handle(), VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_layout.handle(), 0, 1, &ds.set_,
+                            0, nullptr);
+    monitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT,
+                                  "Descriptor in binding #0 index 4500 is being used in draw but has not been updated.");
+    vkCmdDispatch(command_buffer->handle(), 1, 1, 1);
+    monitor->VerifyFound();
+    command_buffer->end();
+
+    vkDestroyPipeline(device->device(), pipeline, nullptr);
+}
+
+TEST_F(VkLayerTest, DrawTimeManyDescriptorsFirstError) {
+    TEST_DESCRIPTION("Report the first unwritten descriptor of a binding of thousands, checked serially.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+    VerifyFirstUnwrittenDescriptorReported(this, m_device, m_commandBuffer, m_errorMonitor);
+}
+
+TEST_F(VkLayerTest, DrawTimeManyDescriptorsFirstErrorParallel) {
+    TEST_DESCRIPTION("Report the same first unwritten descriptor as a serial check, with the binding split across worker threads.");
+
+    ScopedLayerEnables enables("VALIDATION_CHECK_ENABLE_PARALLEL_DESCRIPTOR_VALIDATION");
+    ASSERT_NO_FATAL_FAILURE(Init());
+    VerifyFirstUnwrittenDescriptorReported(this, m_device, m_commandBuffer, m_errorMonitor);
+}
+
 TEST_F(VkLayerTest, CreatePipelineLayoutExceedsSetLimit) {
     TEST_DESCRIPTION("Attempt to create a pipeline layout using more than the physical limit of SetLayouts.");
 
@@ -14825,6 +14982,112 @@ TEST_F(VkLayerTest, DSBufferInfoErrors) {
     vkDestroyBuffer(m_device->device(), buffer, NULL);
 }
 
+TEST_F(VkLayerTest, DSBufferInfoTemplateRolloverErrors) {
+    TEST_DESCRIPTION("Report a bad buffer info that a packed template entry writes past the end of its first binding.");
+
+    // GPDDP2 needed for push descriptors support below
+    bool gpdp2_support = InstanceExtensionSupported(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME,
+                                                    VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_SPEC_VERSION);
+    if (gpdp2_support) {
+        m_instance_extension_names.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    }
+    ASSERT_NO_FATAL_FAILURE(InitFramework(myDbgFunc, m_errorMonitor));
+    if (DeviceExtensionSupported(gpu(), nullptr, VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME)) {
+        m_device_extension_names.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+    } else {
+        printf("%s Descriptor Update Template Extensions not supported, skipping tests\n", kSkipPrefix);
+        return;
+    }
+
+    bool push_descriptor_support = gpdp2_support &&
+                                   DeviceExtensionSupported(gpu(), nullptr, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) &&
+                                   (GetPushDescriptorProperties(instance(), gpu()).maxPushDescriptors >= 4);
+    if (push_descriptor_support) {
+        m_device_extension_names.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    } else {
+        printf("%s Push Descriptor Extension not supported, push descriptor cases skipped.\n", kSkipPrefix);
+    }
+    ASSERT_NO_FATAL_FAILURE(InitState(nullptr, nullptr, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT));
+
+    auto vkCreateDescriptorUpdateTemplateKHR =
+        (PFN_vkCreateDescriptorUpdateTemplateKHR)vkGetDeviceProcAddr(m_device->device(), "vkCreateDescriptorUpdateTemplateKHR");
+    auto vkDestroyDescriptorUpdateTemplateKHR =
+        (PFN_vkDestroyDescriptorUpdateTemplateKHR)vkGetDeviceProcAddr(m_device->device(), "vkDestroyDescriptorUpdateTemplateKHR");
+    auto vkUpdateDescriptorSetWithTemplateKHR =
+        (PFN_vkUpdateDescriptorSetWithTemplateKHR)vkGetDeviceProcAddr(m_device->device(), "vkUpdateDescriptorSetWithTemplateKHR");
+    ASSERT_NE(vkCreateDescriptorUpdateTemplateKHR, nullptr);
+    ASSERT_NE(vkDestroyDescriptorUpdateTemplateKHR, nullptr);
+    ASSERT_NE(vkUpdateDescriptorSetWithTemplateKHR, nullptr);
+
+    // Four descriptors from binding 0 run past its single element into all three of binding 1
+    std::vector<VkDescriptorSetLayoutBinding> ds_bindings = {
+        {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 3, VK_SHADER_STAGE_ALL, nullptr}};
+    OneOffDescriptorSet ds(m_device, ds_bindings);
+
+    VkBufferObj buffer;
+    VkMemoryPropertyFlags reqs = 0;
+    buffer.init(*m_device, buffer.create_info(256, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT), reqs);
+    VkDescriptorBufferInfo update_template_data[4];
+    for (auto &buff_info : update_template_data) buff_info = {buffer.handle(), 0, VK_WHOLE_SIZE};
+    // Only the last element of binding 1 is bad
+    update_template_data[3].offset = 256;
+
+    VkDescriptorUpdateTemplateEntry update_template_entry = {};
+    update_template_entry.dstBinding = 0;
+    update_template_entry.dstArrayElement = 0;
+    update_template_entry.descriptorCount = 4;
+    update_template_entry.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    update_template_entry.offset = 0;
+    update_template_entry.stride = sizeof(VkDescriptorBufferInfo);
+
+    auto update_template_ci = lvl_init_struct<VkDescriptorUpdateTemplateCreateInfoKHR>();
+    update_template_ci.descriptorUpdateEntryCount = 1;
+    update_template_ci.pDescriptorUpdateEntries = &update_template_entry;
+    update_template_ci.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    update_template_ci.descriptorSetLayout = ds.layout_.handle();
+
+    VkDescriptorUpdateTemplate update_template = VK_NULL_HANDLE;
+    VkResult err = vkCreateDescriptorUpdateTemplateKHR(m_device->device(), &update_template_ci, nullptr, &update_template);
+    ASSERT_VK_SUCCESS(err);
+
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "VUID-VkDescriptorBufferInfo-offset-00340");
+    vkUpdateDescriptorSetWithTemplateKHR(m_device->device(), ds.set_, update_template, update_template_data);
+    m_errorMonitor->VerifyFound();
+
+    if (push_descriptor_support) {
+        auto vkCmdPushDescriptorSetWithTemplateKHR = (PFN_vkCmdPushDescriptorSetWithTemplateKHR)vkGetDeviceProcAddr(
+            m_device->device(), "vkCmdPushDescriptorSetWithTemplateKHR");
+        ASSERT_NE(vkCmdPushDescriptorSetWithTemplateKHR, nullptr);
+
+        const VkDescriptorSetLayoutObj push_dsl(m_device, ds_bindings, VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR);
+        const VkPipelineLayoutObj pipeline_layout(m_device, {&push_dsl});
+
+        auto push_template_ci = lvl_init_struct<VkDescriptorUpdateTemplateCreateInfoKHR>();
+        push_template_ci.descriptorUpdateEntryCount = 1;
+        push_template_ci.pDescriptorUpdateEntries = &update_template_entry;
+        push_template_ci.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+        push_template_ci.descriptorSetLayout = VK_NULL_HANDLE;
+        push_template_ci.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        push_template_ci.pipelineLayout = pipeline_layout.handle();
+        push_template_ci.set = 0;
+        VkDescriptorUpdateTemplate push_template = VK_NULL_HANDLE;
+        err = vkCreateDescriptorUpdateTemplateKHR(m_device->device(), &push_template_ci, nullptr, &push_template);
+        ASSERT_VK_SUCCESS(err);
+
+        m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "VUID-VkDescriptorBufferInfo-offset-00340");
+        m_commandBuffer->begin();
+        vkCmdPushDescriptorSetWithTemplateKHR(m_commandBuffer->handle(), push_template, pipeline_layout.handle(), 0,
+                                              update_template_data);
+        m_commandBuffer->end();
+        m_errorMonitor->VerifyFound();
+
+        vkDestroyDescriptorUpdateTemplateKHR(m_device->device(), push_template, nullptr);
+    }
+
+    vkDestroyDescriptorUpdateTemplateKHR(m_device->device(), update_template, nullptr);
+}
+
 TEST_F(VkLayerTest, DSBufferLimitErrors) {
     TEST_DESCRIPTION(
         "Attempt to update buffer descriptor set that has VkDescriptorBufferInfo values that violate device limits.\n"
@@ -15258,6 +15521,174 @@ TEST_F(VkLayerTest, ImageViewDescriptorUpdateError) {
     vkDestroySampler(m_device->device(), sampler, NULL);
 }
 
+TEST_F(VkLayerTest, DescriptorRewriteAfterObjectDestroyed) {
+    TEST_DESCRIPTION("Write the same image view, buffer and sampler twice, destroying each in between; the rewrite must fail.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+    OneOffDescriptorSet ds(m_device, {
+                                         {0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                         {1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                         {2, VK_DESCRIPTOR_TYPE_SAMPLER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                     });
+
+    const VkFormat format = VK_FORMAT_B8G8R8A8_UNORM;
+    VkImageObj image(m_device);
+    image.Init(32, 32, 1, format, VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_TILING_OPTIMAL, 0);
+    ASSERT_TRUE(image.initialized());
+    VkImageViewCreateInfo ivci = SafeSaneImageViewCreateInfo(image, format, VK_IMAGE_ASPECT_COLOR_BIT);
+    VkImageView view;
+    VkResult err = vkCreateImageView(m_device->device(), &ivci, NULL, &view);
+    ASSERT_VK_SUCCESS(err);
+
+    VkBufferCreateInfo buffer_ci = {};
+    buffer_ci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_ci.size = 256;
+    buffer_ci.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    buffer_ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkBuffer buffer;
+    err = vkCreateBuffer(m_device->device(), &buffer_ci, NULL, &buffer);
+    ASSERT_VK_SUCCESS(err);
+    VkMemoryRequirements mem_reqs;
+    vkGetBufferMemoryRequirements(m_device->device(), buffer, &mem_reqs);
+    VkMemoryAllocateInfo mem_alloc = {};
+    mem_alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    mem_alloc.allocationSize = mem_reqs.size;
+    bool pass = m_device->phy().set_memory_type(mem_reqs.memoryTypeBits, &mem_alloc, 0);
+    ASSERT_TRUE(pass);
+    VkDeviceMemory buffer_memory;
+    err = vkAllocateMemory(m_device->device(), &mem_alloc, NULL, &buffer_memory);
+    ASSERT_VK_SUCCESS(err);
+    err = vkBindBufferMemory(m_device->device(), buffer, buffer_memory, 0);
+    ASSERT_VK_SUCCESS(err);
+
+    VkSamplerCreateInfo sampler_ci = SafeSaneSamplerCreateInfo();
+    VkSampler sampler;
+    err = vkCreateSampler(m_device->device(), &sampler_ci, NULL, &sampler);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorImageInfo view_info = {VK_NULL_HANDLE, view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+    VkDescriptorBufferInfo buffer_info = {buffer, 0, VK_WHOLE_SIZE};
+    VkDescriptorImageInfo sampler_info = {sampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED};
+
+    VkWriteDescriptorSet writes[3] = {};
+    for (uint32_t i = 0; i < 3; ++i) {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = ds.set_;
+        writes[i].dstBinding = i;
+        writes[i].descriptorCount = 1;
+    }
+    writes[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    writes[0].pImageInfo = &view_info;
+    writes[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    writes[1].pBufferInfo = &buffer_info;
+    writes[2].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    writes[2].pImageInfo = &sampler_info;
+
+    // Each first write is valid and leaves its descriptor marked as validated
+    m_errorMonitor->ExpectSuccess();
+    vkUpdateDescriptorSets(m_device->device(), 3, writes, 0, NULL);
+    m_errorMonitor->VerifyNotFound();
+
+    vkDestroyImageView(m_device->device(), view, NULL);
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "VUID-VkWriteDescriptorSet-descriptorType-00326");
+    vkUpdateDescriptorSets(m_device->device(), 1, &writes[0], 0, NULL);
+    m_errorMonitor->VerifyFound();
+
+    vkDestroyBuffer(m_device->device(), buffer, NULL);
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "VUID-VkDescriptorBufferInfo-buffer-parameter");
+    vkUpdateDescriptorSets(m_device->device(), 1, &writes[1], 0, NULL);
+    m_errorMonitor->VerifyFound();
+
+    // Samplers aren't tracked by the object lifetime checks, so this one is caught by core validation alone
+    vkDestroySampler(m_device->device(), sampler, NULL);
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "VUID-VkWriteDescriptorSet-descriptorType-00325");
+    vkUpdateDescriptorSets(m_device->device(), 1, &writes[2], 0, NULL);
+    m_errorMonitor->VerifyFound();
+
+    vkFreeMemory(m_device->device(), buffer_memory, NULL);
+}
+
+TEST_F(VkLayerTest, DescriptorRewriteAfterMemoryFreed) {
+    TEST_DESCRIPTION("Write the same buffer twice, freeing its memory in between; the second write must fail.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+    OneOffDescriptorSet ds(m_device, {
+                                         {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                     });
+
+    VkBufferCreateInfo buffer_ci = {};
+    buffer_ci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_ci.size = 256;
+    buffer_ci.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    buffer_ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VkBuffer buffer;
+    VkResult err = vkCreateBuffer(m_device->device(), &buffer_ci, NULL, &buffer);
+    ASSERT_VK_SUCCESS(err);
+    VkMemoryRequirements mem_reqs;
+    vkGetBufferMemoryRequirements(m_device->device(), buffer, &mem_reqs);
+    VkMemoryAllocateInfo mem_alloc = {};
+    mem_alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    mem_alloc.allocationSize = mem_reqs.size;
+    bool pass = m_device->phy().set_memory_type(mem_reqs.memoryTypeBits, &mem_alloc, 0);
+    ASSERT_TRUE(pass);
+    VkDeviceMemory buffer_memory;
+    err = vkAllocateMemory(m_device->device(), &mem_alloc, NULL, &buffer_memory);
+    ASSERT_VK_SUCCESS(err);
+    err = vkBindBufferMemory(m_device->device(), buffer, buffer_memory, 0);
+    ASSERT_VK_SUCCESS(err);
+
+    VkDescriptorBufferInfo buffer_info = {buffer, 0, VK_WHOLE_SIZE};
+    VkWriteDescriptorSet descriptor_write = {};
+    descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_write.dstSet = ds.set_;
+    descriptor_write.dstBinding = 0;
+    descriptor_write.descriptorCount = 1;
+    descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptor_write.pBufferInfo = &buffer_info;
+
+    m_errorMonitor->ExpectSuccess();
+    vkUpdateDescriptorSets(m_device->device(), 1, &descriptor_write, 0, NULL);
+    m_errorMonitor->VerifyNotFound();
+
+    // The buffer handle is still live, so only core validation can tell that its memory is gone
+    vkFreeMemory(m_device->device(), buffer_memory, NULL);
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "VUID-VkWriteDescriptorSet-descriptorType-00329");
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "VUID-VkWriteDescriptorSet-descriptorType-00329");
+    vkUpdateDescriptorSets(m_device->device(), 1, &descriptor_write, 0, NULL);
+    m_errorMonitor->VerifyFound();
+
+    vkDestroyBuffer(m_device->device(), buffer, NULL);
+}
+
+TEST_F(VkLayerTest, DescriptorRewriteInvalidRepeated) {
+    TEST_DESCRIPTION("Repeat an identical invalid descriptor write; each one must be reported.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+    OneOffDescriptorSet ds(m_device, {
+                                         {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+                                     });
+
+    VkBufferObj buffer;
+    VkMemoryPropertyFlags reqs = 0;
+    buffer.init(*m_device, buffer.create_info(256, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT), reqs);
+
+    // Offset equal to the buffer size
+    VkDescriptorBufferInfo buffer_info = {buffer.handle(), 256, VK_WHOLE_SIZE};
+    VkWriteDescriptorSet descriptor_write = {};
+    descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_write.dstSet = ds.set_;
+    descriptor_write.dstBinding = 0;
+    descriptor_write.descriptorCount = 1;
+    descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptor_write.pBufferInfo = &buffer_info;
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "VUID-VkDescriptorBufferInfo-offset-00340");
+        vkUpdateDescriptorSets(m_device->device(), 1, &descriptor_write, 0, NULL);
+        m_errorMonitor->VerifyFound();
+    }
+}
+
 TEST_F(VkLayerTest, CopyDescriptorUpdateErrors) {
     // Create DS w/ layout of 2 types, write update 1 and attempt to copy-update
     // into the other
@@ -16221,6 +16652,106 @@ TEST_F(VkLayerTest, InvalidVertexAttributeDescriptions) {
 }
 
 // INVALID_IMAGE_LAYOUT tests (one other case is hit by MapMemWithoutHostVisibleBit and not here)
+TEST_F(VkLayerTest, InvalidImageLayoutAfterPartialTransition) {
+    TEST_DESCRIPTION("Transition a layered image as a whole, then one of its subresources, and submit a command buffer expecting "
+                     "the whole image to still be in the first layout.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    VkImageCreateInfo image_ci = vk_testing::Image::create_info();
+    image_ci.imageType = VK_IMAGE_TYPE_2D;
+    image_ci.format = VK_FORMAT_R8G8B8A8_UNORM;
+    image_ci.extent = {32, 32, 1};
+    image_ci.mipLevels = 4;
+    image_ci.arrayLayers = 64;
+    image_ci.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_ci.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    VkImageObj image(m_device);
+    image.init(&image_ci);
+    ASSERT_TRUE(image.initialized());
+
+    VkImageSubresourceRange whole_image = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 4, 0, 64};
+    VkImageSubresourceRange one_layer = {VK_IMAGE_ASPECT_COLOR_BIT, 1, 1, 3, 1};
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &m_commandBuffer->handle();
+
+    auto submit_barrier = [&](VkImageLayout old_layout, VkImageLayout new_layout, const VkImageSubresourceRange &range) {
+        auto barrier = image.image_memory_barrier(VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, old_layout,
+                                                  new_layout, range);
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        m_commandBuffer->reset(0);
+        m_commandBuffer->begin();
+        vkCmdPipelineBarrier(m_commandBuffer->handle(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+                             nullptr, 0, nullptr, 1, &barrier);
+        m_commandBuffer->end();
+        vkQueueSubmit(m_device->m_queue, 1, &submit_info, VK_NULL_HANDLE);
+        vkQueueWaitIdle(m_device->m_queue);
+    };
+
+    m_errorMonitor->ExpectSuccess();
+    submit_barrier(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, whole_image);
+    submit_barrier(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL, one_layer);
+    m_errorMonitor->VerifyNotFound();
+
+    // Layer 3 of mip level 1 is now GENERAL
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "UNASSIGNED-CoreValidation-DrawState-InvalidImageLayout");
+    submit_barrier(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, whole_image);
+    m_errorMonitor->VerifyFound();
+}
+
+TEST_F(VkLayerTest, InvalidImageLayoutOnResubmit) {
+    TEST_DESCRIPTION("Resubmit a command buffer whose first use of an image matched, after another submission changed the layout.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    VkImageObj image(m_device);
+    image.Init(32, 32, 1, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+               VK_IMAGE_TILING_OPTIMAL, 0);
+    ASSERT_TRUE(image.initialized());
+
+    VkImageSubresourceRange whole_image = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    auto record_barrier = [&](VkCommandBufferObj &cb, VkImageLayout old_layout, VkImageLayout new_layout) {
+        auto barrier = image.image_memory_barrier(VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, old_layout,
+                                                  new_layout, whole_image);
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        cb.begin();
+        vkCmdPipelineBarrier(cb.handle(), VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+                             nullptr, 1, &barrier);
+        cb.end();
+    };
+    auto submit = [&](VkCommandBufferObj &cb) {
+        VkSubmitInfo submit_info = {};
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = &cb.handle();
+        vkQueueSubmit(m_device->m_queue, 1, &submit_info, VK_NULL_HANDLE);
+        vkQueueWaitIdle(m_device->m_queue);
+    };
+
+    // Expects GENERAL, and leaves it that way
+    VkCommandBufferObj reused_cb(m_device, m_commandPool);
+    record_barrier(reused_cb, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL);
+
+    m_errorMonitor->ExpectSuccess();
+    record_barrier(*m_commandBuffer, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL);
+    submit(*m_commandBuffer);
+    submit(reused_cb);
+    submit(reused_cb);
+    m_errorMonitor->VerifyNotFound();
+
+    m_commandBuffer->reset(0);
+    record_barrier(*m_commandBuffer, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    submit(*m_commandBuffer);
+
+    m_errorMonitor->SetDesiredFailureMsg(VK_DEBUG_REPORT_ERROR_BIT_EXT, "UNASSIGNED-CoreValidation-DrawState-InvalidImageLayout");
+    submit(reused_cb);
+    m_errorMonitor->VerifyFound();
+}
+
 TEST_F(VkLayerTest, InvalidImageLayout) {
     TEST_DESCRIPTION(
         "Hit all possible validation checks associated with the UNASSIGNED-CoreValidation-DrawState-InvalidImageLayout error. "
@@ -1915,6 +1915,63 @@ TEST_F(VkPositiveLayerTest, DeleteDescriptorSetLayoutsBeforeDescriptorSets) {
     m_errorMonitor->VerifyNotFound();
 }
 
+TEST_F(VkPositiveLayerTest, ResetDescriptorPoolAndReallocate) {
+    TEST_DESCRIPTION("Fill a pool without FREE_DESCRIPTOR_SET_BIT, update its sets, and reset it, repeatedly.");
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    m_errorMonitor->ExpectSuccess();
+
+    const uint32_t kSetCount = 16;
+    const uint32_t kDescriptorsPerSet = 4;
+    VkDescriptorPoolSize ds_type_count = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, kSetCount * kDescriptorsPerSet};
+
+    VkDescriptorPoolCreateInfo ds_pool_ci = {};
+    ds_pool_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    ds_pool_ci.flags = 0;
+    ds_pool_ci.maxSets = kSetCount;
+    ds_pool_ci.poolSizeCount = 1;
+    ds_pool_ci.pPoolSizes = &ds_type_count;
+    VkDescriptorPool ds_pool;
+    VkResult err = vkCreateDescriptorPool(m_device->device(), &ds_pool_ci, NULL, &ds_pool);
+    ASSERT_VK_SUCCESS(err);
+
+    const VkDescriptorSetLayoutObj ds_layout(
+        m_device, {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, kDescriptorsPerSet, VK_SHADER_STAGE_ALL, nullptr}});
+    std::vector<VkDescriptorSetLayout> set_layouts(kSetCount, ds_layout.handle());
+
+    static const float ubo_data[4] = {0.f, 1.f, 2.f, 3.f};
+    VkConstantBufferObj ubo(m_device, sizeof(ubo_data), (const void *)&ubo_data, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+    std::vector<VkDescriptorBufferInfo> buff_info(kDescriptorsPerSet, {ubo.handle(), 0, sizeof(ubo_data)});
+
+    // Each frame's sets reuse the storage released by the previous reset
+    for (uint32_t frame = 0; frame < 4; ++frame) {
+        VkDescriptorSetAllocateInfo alloc_info = {};
+        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        alloc_info.descriptorPool = ds_pool;
+        alloc_info.descriptorSetCount = kSetCount;
+        alloc_info.pSetLayouts = set_layouts.data();
+        std::vector<VkDescriptorSet> sets(kSetCount);
+        err = vkAllocateDescriptorSets(m_device->device(), &alloc_info, sets.data());
+        ASSERT_VK_SUCCESS(err);
+
+        for (auto set : sets) {
+            VkWriteDescriptorSet descriptor_write = {};
+            descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptor_write.dstSet = set;
+            descriptor_write.dstBinding = 0;
+            descriptor_write.descriptorCount = kDescriptorsPerSet;
+            descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            descriptor_write.pBufferInfo = buff_info.data();
+            vkUpdateDescriptorSets(m_device->device(), 1, &descriptor_write, 0, NULL);
+        }
+
+        vkResetDescriptorPool(m_device->device(), ds_pool, 0);
+    }
+
+    vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
+    m_errorMonitor->VerifyNotFound();
+}
+
 TEST_F(VkPositiveLayerTest, CommandPoolDeleteWithReferences) {
     TEST_DESCRIPTION("Ensure the validation layers bookkeeping tracks the implicit command buffer frees.");
     ASSERT_NO_FATAL_FAILURE(Init());
@@ -2634,6 +2691,195 @@ TEST_F(VkPositiveLayerTest, PushDescriptorUnboundSetTest) {
     vkDestroyDescriptorPool(m_device->device(), ds_pool, NULL);
 }
 
+// This is a positive test. No failures are expected.
+TEST_F(VkPositiveLayerTest, UpdateTemplateInlineUniformBlock) {
+    TEST_DESCRIPTION("Update part of an inline uniform block through a descriptor update template.");
+
+    if (InstanceExtensionSupported(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME)) {
+        m_instance_extension_names.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    } else {
+        printf("%s Did not find VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME; skipped.\n", kSkipPrefix);
+        return;
+    }
+    ASSERT_NO_FATAL_FAILURE(InitFramework(myDbgFunc, m_errorMonitor));
+    std::array<const char *, 3> required_device_extensions = {
+        VK_KHR_MAINTENANCE1_EXTENSION_NAME, VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME,
+        VK_EXT_INLINE_UNIFORM_BLOCK_EXTENSION_NAME};
+    for (auto device_extension : required_device_extensions) {
+        if (DeviceExtensionSupported(gpu(), nullptr, device_extension)) {
+            m_device_extension_names.push_back(device_extension);
+        } else {
+            printf("%s %s Extension not supported, skipping tests\n", kSkipPrefix, device_extension);
+            return;
+        }
+    }
+
+    PFN_vkGetPhysicalDeviceFeatures2KHR vkGetPhysicalDeviceFeatures2KHR =
+        (PFN_vkGetPhysicalDeviceFeatures2KHR)vkGetInstanceProcAddr(instance(), "vkGetPhysicalDeviceFeatures2KHR");
+    ASSERT_TRUE(vkGetPhysicalDeviceFeatures2KHR != nullptr);
+    auto inline_uniform_block_features = lvl_init_struct<VkPhysicalDeviceInlineUniformBlockFeaturesEXT>();
+    auto features2 = lvl_init_struct<VkPhysicalDeviceFeatures2KHR>(&inline_uniform_block_features);
+    vkGetPhysicalDeviceFeatures2KHR(gpu(), &features2);
+    if (!inline_uniform_block_features.inlineUniformBlock) {
+        printf("%s inlineUniformBlock feature not supported, skipping tests\n", kSkipPrefix);
+        return;
+    }
+    ASSERT_NO_FATAL_FAILURE(InitState(nullptr, &features2));
+
+    auto vkCreateDescriptorUpdateTemplateKHR =
+        (PFN_vkCreateDescriptorUpdateTemplateKHR)vkGetDeviceProcAddr(m_device->device(), "vkCreateDescriptorUpdateTemplateKHR");
+    auto vkDestroyDescriptorUpdateTemplateKHR =
+        (PFN_vkDestroyDescriptorUpdateTemplateKHR)vkGetDeviceProcAddr(m_device->device(), "vkDestroyDescriptorUpdateTemplateKHR");
+    auto vkUpdateDescriptorSetWithTemplateKHR =
+        (PFN_vkUpdateDescriptorSetWithTemplateKHR)vkGetDeviceProcAddr(m_device->device(), "vkUpdateDescriptorSetWithTemplateKHR");
+    ASSERT_NE(vkCreateDescriptorUpdateTemplateKHR, nullptr);
+    ASSERT_NE(vkDestroyDescriptorUpdateTemplateKHR, nullptr);
+    ASSERT_NE(vkUpdateDescriptorSetWithTemplateKHR, nullptr);
+
+    m_errorMonitor->ExpectSuccess();
+
+    OneOffDescriptorSet ds(m_device, {{0, VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT, 16, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr}});
+    ASSERT_TRUE(ds.Initialized());
+
+    // The descriptorCount of the entry is a byte count, and the whole 8 bytes go in one write
+    struct InlineTemplateData {
+        uint32_t padding;
+        uint32_t block[2];
+    };
+    InlineTemplateData update_template_data = {0, {1, 2}};
+
+    VkDescriptorUpdateTemplateEntry update_template_entry = {};
+    update_template_entry.dstBinding = 0;
+    update_template_entry.dstArrayElement = 4;
+    update_template_entry.descriptorCount = sizeof(update_template_data.block);
+    update_template_entry.descriptorType = VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT;
+    update_template_entry.offset = offsetof(InlineTemplateData, block);
+    update_template_entry.stride = 0;
+
+    auto update_template_ci = lvl_init_struct<VkDescriptorUpdateTemplateCreateInfoKHR>();
+    update_template_ci.descriptorUpdateEntryCount = 1;
+    update_template_ci.pDescriptorUpdateEntries = &update_template_entry;
+    update_template_ci.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    update_template_ci.descriptorSetLayout = ds.layout_.handle();
+
+    VkDescriptorUpdateTemplate update_template = VK_NULL_HANDLE;
+    VkResult err = vkCreateDescriptorUpdateTemplateKHR(m_device->device(), &update_template_ci, nullptr, &update_template);
+    ASSERT_VK_SUCCESS(err);
+
+    vkUpdateDescriptorSetWithTemplateKHR(m_device->device(), ds.set_, update_template, &update_template_data);
+
+    m_errorMonitor->VerifyNotFound();
+
+    vkDestroyDescriptorUpdateTemplateKHR(m_device->device(), update_template, nullptr);
+}
+
+// This is a positive test. No failures are expected.
+TEST_F(VkPositiveLayerTest, UpdateTemplatePackedBindingRollover) {
+    TEST_DESCRIPTION("Update descriptors spanning two bindings of different sizes from one packed template entry.");
+
+    // GPDDP2 needed for push descriptors support below
+    bool gpdp2_support = InstanceExtensionSupported(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME,
+                                                    VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_SPEC_VERSION);
+    if (gpdp2_support) {
+        m_instance_extension_names.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+    }
+    ASSERT_NO_FATAL_FAILURE(InitFramework(myDbgFunc, m_errorMonitor));
+    if (DeviceExtensionSupported(gpu(), nullptr, VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME)) {
+        m_device_extension_names.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+    } else {
+        printf("%s Descriptor Update Template Extensions not supported, skipping tests\n", kSkipPrefix);
+        return;
+    }
+
+    // Push descriptor templates are decoded separately, so cover them too when the device can push four descriptors
+    bool push_descriptor_support = gpdp2_support &&
+                                   DeviceExtensionSupported(gpu(), nullptr, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) &&
+                                   (GetPushDescriptorProperties(instance(), gpu()).maxPushDescriptors >= 4);
+    if (push_descriptor_support) {
+        m_device_extension_names.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+    } else {
+        printf("%s Push Descriptor Extension not supported, push descriptor cases skipped.\n", kSkipPrefix);
+    }
+    ASSERT_NO_FATAL_FAILURE(InitState());
+
+    auto vkCreateDescriptorUpdateTemplateKHR =
+        (PFN_vkCreateDescriptorUpdateTemplateKHR)vkGetDeviceProcAddr(m_device->device(), "vkCreateDescriptorUpdateTemplateKHR");
+    auto vkDestroyDescriptorUpdateTemplateKHR =
+        (PFN_vkDestroyDescriptorUpdateTemplateKHR)vkGetDeviceProcAddr(m_device->device(), "vkDestroyDescriptorUpdateTemplateKHR");
+    auto vkUpdateDescriptorSetWithTemplateKHR =
+        (PFN_vkUpdateDescriptorSetWithTemplateKHR)vkGetDeviceProcAddr(m_device->device(), "vkUpdateDescriptorSetWithTemplateKHR");
+    ASSERT_NE(vkCreateDescriptorUpdateTemplateKHR, nullptr);
+    ASSERT_NE(vkDestroyDescriptorUpdateTemplateKHR, nullptr);
+    ASSERT_NE(vkUpdateDescriptorSetWithTemplateKHR, nullptr);
+
+    m_errorMonitor->ExpectSuccess();
+
+    // Four descriptors from binding 0 run past its single element into all three of binding 1
+    std::vector<VkDescriptorSetLayoutBinding> ds_bindings = {
+        {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 3, VK_SHADER_STAGE_ALL, nullptr}};
+    OneOffDescriptorSet ds(m_device, ds_bindings);
+    ASSERT_TRUE(ds.Initialized());
+
+    VkBufferObj buffer;
+    VkMemoryPropertyFlags reqs = 0;
+    buffer.init(*m_device, buffer.create_info(256, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT), reqs);
+    VkDescriptorBufferInfo update_template_data[4];
+    for (auto &buff_info : update_template_data) buff_info = {buffer.handle(), 0, VK_WHOLE_SIZE};
+
+    VkDescriptorUpdateTemplateEntry update_template_entry = {};
+    update_template_entry.dstBinding = 0;
+    update_template_entry.dstArrayElement = 0;
+    update_template_entry.descriptorCount = 4;
+    update_template_entry.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    update_template_entry.offset = 0;
+    update_template_entry.stride = sizeof(VkDescriptorBufferInfo);
+
+    auto update_template_ci = lvl_init_struct<VkDescriptorUpdateTemplateCreateInfoKHR>();
+    update_template_ci.descriptorUpdateEntryCount = 1;
+    update_template_ci.pDescriptorUpdateEntries = &update_template_entry;
+    update_template_ci.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    update_template_ci.descriptorSetLayout = ds.layout_.handle();
+
+    VkDescriptorUpdateTemplate update_template = VK_NULL_HANDLE;
+    VkResult err = vkCreateDescriptorUpdateTemplateKHR(m_device->device(), &update_template_ci, nullptr, &update_template);
+    ASSERT_VK_SUCCESS(err);
+
+    vkUpdateDescriptorSetWithTemplateKHR(m_device->device(), ds.set_, update_template, update_template_data);
+
+    if (push_descriptor_support) {
+        auto vkCmdPushDescriptorSetWithTemplateKHR = (PFN_vkCmdPushDescriptorSetWithTemplateKHR)vkGetDeviceProcAddr(
+            m_device->device(), "vkCmdPushDescriptorSetWithTemplateKHR");
+        ASSERT_NE(vkCmdPushDescriptorSetWithTemplateKHR, nullptr);
+
+        const VkDescriptorSetLayoutObj push_dsl(m_device, ds_bindings, VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR);
+        const VkPipelineLayoutObj pipeline_layout(m_device, {&push_dsl});
+
+        auto push_template_ci = lvl_init_struct<VkDescriptorUpdateTemplateCreateInfoKHR>();
+        push_template_ci.descriptorUpdateEntryCount = 1;
+        push_template_ci.pDescriptorUpdateEntries = &update_template_entry;
+        push_template_ci.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+        push_template_ci.descriptorSetLayout = VK_NULL_HANDLE;
+        push_template_ci.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        push_template_ci.pipelineLayout = pipeline_layout.handle();
+        push_template_ci.set = 0;
+        VkDescriptorUpdateTemplate push_template = VK_NULL_HANDLE;
+        err = vkCreateDescriptorUpdateTemplateKHR(m_device->device(), &push_template_ci, nullptr, &push_template);
+        ASSERT_VK_SUCCESS(err);
+
+        m_commandBuffer->begin();
+        vkCmdPushDescriptorSetWithTemplateKHR(m_commandBuffer->handle(), push_template, pipeline_layout.handle(), 0,
+                                              update_template_data);
+        m_commandBuffer->end();
+
+        vkDestroyDescriptorUpdateTemplateKHR(m_device->device(), push_template, nullptr);
+    }
+
+    m_errorMonitor->VerifyNotFound();
+
+    vkDestroyDescriptorUpdateTemplateKHR(m_device->device(), update_template, nullptr);
+}
+
 // This is a positive test. No failures are expected.
 TEST_F(VkPositiveLayerTest, TestAliasedMemoryTracking) {
     VkResult err;
@@ -3205,6 +3451,66 @@ TEST_F(VkPositiveLayerTest, NonCoherentMemoryMapping) {
     vkFreeMemory(m_device->device(), mem, NULL);
 }
 
+#if defined(__linux__)
+TEST_F(VkPositiveLayerTest, NonCoherentMemoryGuardPageFlush) {
+    TEST_DESCRIPTION("Flush guard page shadows of non-coherent memory, and check that only the written pages reach the driver.");
+
+    ScopedLayerEnables enables("VALIDATION_CHECK_ENABLE_SHADOW_GUARD_PAGES");
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    // A multiple of any page size, so that the blocks never share a page
+    const VkDeviceSize block_size = 65536;
+    VkMemoryAllocateInfo alloc_info = {};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = 4 * block_size;
+    if (!m_device->phy().set_memory_type(0xFFFFFFFF, &alloc_info, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                                         VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+        printf("%s Couldn't find a memory type without a COHERENT bit.\n", kSkipPrefix);
+        return;
+    }
+    VkDeviceMemory mem;
+    VkResult err = vkAllocateMemory(m_device->device(), &alloc_info, NULL, &mem);
+    ASSERT_VK_SUCCESS(err);
+
+    VkMappedMemoryRange mmr = {};
+    mmr.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    mmr.memory = mem;
+    mmr.offset = 0;
+    mmr.size = VK_WHOLE_SIZE;
+
+    m_errorMonitor->ExpectSuccess();
+    uint8_t *data;
+    err = vkMapMemory(m_device->device(), mem, 0, VK_WHOLE_SIZE, 0, (void **)&data);
+    ASSERT_VK_SUCCESS(err);
+    memset(data, 0xAB, static_cast<size_t>(alloc_info.allocationSize));
+    err = vkFlushMappedMemoryRanges(m_device->device(), 1, &mmr);
+    ASSERT_VK_SUCCESS(err);
+    vkUnmapMemory(m_device->device(), mem);
+
+    // In a new shadow, leave block 0 untouched, only read block 1, write block 2, and write zeros to block 3
+    err = vkMapMemory(m_device->device(), mem, 0, VK_WHOLE_SIZE, 0, (void **)&data);
+    ASSERT_VK_SUCCESS(err);
+    volatile uint8_t read_back = 0;
+    for (VkDeviceSize i = block_size; i < 2 * block_size; i += 256) read_back = read_back + data[i];
+    memset(data + 2 * block_size, 0xCD, static_cast<size_t>(block_size));
+    memset(data + 3 * block_size, 0, static_cast<size_t>(block_size));
+    err = vkFlushMappedMemoryRanges(m_device->device(), 1, &mmr);
+    ASSERT_VK_SUCCESS(err);
+    err = vkInvalidateMappedMemoryRanges(m_device->device(), 1, &mmr);
+    ASSERT_VK_SUCCESS(err);
+    m_errorMonitor->VerifyNotFound();
+
+    const uint8_t expected[4] = {0xAB, 0xAB, 0xCD, 0};
+    for (uint32_t block = 0; block < 4; ++block) {
+        for (VkDeviceSize i = 0; i < block_size; i += 256) {
+            ASSERT_EQ(expected[block], data[block * block_size + i]) << "block " << block << ", offset " << i;
+        }
+    }
+    vkUnmapMemory(m_device->device(), mem);
+    vkFreeMemory(m_device->device(), mem, NULL);
+}
+#endif  // __linux__
+
 // This is a positive test. We used to expect error in this case but spec now allows it
 TEST_F(VkPositiveLayerTest, ResetUnsignaledFence) {
     m_errorMonitor->ExpectSuccess();
@@ -4172,6 +4478,61 @@ TEST_F(VkPositiveLayerTest, TwoFencesThreeFrames) {
         vkDestroyFence(m_device->device(), fences[i], nullptr);
     }
 }
+// With background retirement, whether destroying an object used by a completed but unwaited submission is an in-use error
+// depends on whether the worker has retired the submission yet. So this only destroys objects after their fence has been
+// waited on or found signaled, and no errors should be generated.
+TEST_F(VkPositiveLayerTest, BackgroundRetirementFencedFrames) {
+    TEST_DESCRIPTION(
+        "Submit fenced work, wait for it and destroy what it used, with fences retired on a background thread. Then destroy the "
+        "device while that thread is running.");
+
+    ScopedLayerEnables enables("VALIDATION_CHECK_ENABLE_BACKGROUND_RETIREMENT");
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    m_errorMonitor->ExpectSuccess();
+    {
+        // A device of the test's own, so that its retirement thread is stopped and joined before the test checks for errors
+        VkDeviceObj device(0, gpu(), m_device_extension_names);
+        VkCommandPoolObj pool(&device, device.graphics_queue_node_index_);
+        VkQueue queue = device.GetDefaultQueue()->handle();
+        VkMemoryPropertyFlags reqs = 0;
+
+        static const uint32_t NUM_FRAMES = 16;
+        for (uint32_t frame = 0; frame < NUM_FRAMES; ++frame) {
+            VkBufferObj buffer;
+            buffer.init_as_dst(device, 256, reqs);
+            VkCommandBufferObj command_buffer(&device, &pool);
+            VkFenceObj fence;
+            fence.init(device, VkFenceObj::create_info());
+
+            command_buffer.begin();
+            vkCmdFillBuffer(command_buffer.handle(), buffer.handle(), 0, VK_WHOLE_SIZE, frame);
+            command_buffer.end();
+
+            VkSubmitInfo submit_info = {};
+            submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submit_info.commandBufferCount = 1;
+            submit_info.pCommandBuffers = &command_buffer.handle();
+            VkResult err = vkQueueSubmit(queue, 1, &submit_info, fence.handle());
+            ASSERT_VK_SUCCESS(err);
+
+            // Alternate between waiting for the fence and polling it, so both race the background thread's retirement
+            if (frame % 2) {
+                err = fence.wait(VK_TRUE, UINT64_MAX);
+                ASSERT_VK_SUCCESS(err);
+            } else {
+                while ((err = fence.status()) == VK_NOT_READY) {
+                }
+                ASSERT_VK_SUCCESS(err);
+            }
+            // The fence, command buffer and buffer are destroyed here, none of which may be reported as still in use
+        }
+
+        // The background thread is still running here, and has to be stopped and joined as the device is destroyed
+    }
+    m_errorMonitor->VerifyNotFound();
+}
+
 // This is a positive test.  No errors should be generated.
 TEST_F(VkPositiveLayerTest, TwoQueueSubmitsSeparateQueuesWithSemaphoreAndOneFenceQWI) {
     TEST_DESCRIPTION(
@@ -6327,6 +6688,163 @@ TEST_F(VkPositiveLayerTest, ThreadNullFenceCollision) {
     m_errorMonitor->VerifyNotFound();
 }
 
+#if GTEST_IS_THREADSAFE
+struct bind_and_draw_thread_data {
+    VkCommandBuffer commandBuffer;
+    VkPipeline pipeline;
+    bool bailout;
+};
+
+static void *BindAndDraw(void *arg) {
+    auto *data = reinterpret_cast<bind_and_draw_thread_data *>(arg);
+
+    for (int i = 0; i < 20000; i++) {
+        vkCmdBindPipeline(data->commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, data->pipeline);
+        vkCmdDraw(data->commandBuffer, 3, 1, 0, 0);
+        if (data->bailout) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+TEST_F(VkPositiveLayerTest, ThreadConcurrentPipelineBindAndDraw) {
+    TEST_DESCRIPTION("Bind one pipeline and draw with it on two threads at once, with concurrent validation.");
+    const uint32_t thread_count = 2;
+
+    ScopedLayerEnables enables("VALIDATION_CHECK_ENABLE_CONCURRENT_VALIDATION");
+    ASSERT_NO_FATAL_FAILURE(Init());
+    ASSERT_NO_FATAL_FAILURE(InitRenderTarget());
+
+    // Blend constants are used, so every draw reads the pipeline state that binding used to write
+    CreatePipelineHelper pipe(*this);
+    pipe.InitInfo();
+    pipe.cb_attachments_.blendEnable = VK_TRUE;
+    pipe.cb_attachments_.srcColorBlendFactor = VK_BLEND_FACTOR_CONSTANT_COLOR;
+    pipe.cb_attachments_.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_CONSTANT_COLOR;
+    pipe.cb_attachments_.colorBlendOp = VK_BLEND_OP_ADD;
+    pipe.cb_attachments_.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    pipe.cb_attachments_.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    pipe.cb_attachments_.alphaBlendOp = VK_BLEND_OP_ADD;
+    pipe.cb_attachments_.colorWriteMask = 0xf;
+    pipe.InitState();
+    ASSERT_VK_SUCCESS(pipe.CreateGraphicsPipeline());
+
+    m_errorMonitor->ExpectSuccess();
+
+    std::vector<std::unique_ptr<VkCommandPoolObj>> pools;
+    std::vector<std::unique_ptr<VkCommandBufferObj>> command_buffers;
+    std::vector<bind_and_draw_thread_data> data(thread_count);
+    std::vector<test_platform_thread> threads(thread_count);
+    for (uint32_t i = 0; i < thread_count; i++) {
+        pools.emplace_back(new VkCommandPoolObj(m_device, m_device->graphics_queue_node_index_));
+        command_buffers.emplace_back(new VkCommandBufferObj(m_device, pools.back().get()));
+        command_buffers.back()->begin();
+        command_buffers.back()->BeginRenderPass(m_renderPassBeginInfo);
+        data[i].commandBuffer = command_buffers.back()->handle();
+        data[i].pipeline = pipe.pipeline_;
+        data[i].bailout = false;
+    }
+    m_errorMonitor->SetBailout(&data[0].bailout);
+    for (uint32_t i = 1; i < thread_count; i++) {
+        m_errorMonitor->AddBailout(&data[i].bailout);
+    }
+
+    for (uint32_t i = 1; i < thread_count; i++) {
+        test_platform_thread_create(&threads[i], BindAndDraw, (void *)&data[i]);
+    }
+    BindAndDraw(&data[0]);
+    for (uint32_t i = 1; i < thread_count; i++) {
+        test_platform_thread_join(threads[i], NULL);
+    }
+
+    for (auto &command_buffer : command_buffers) {
+        command_buffer->EndRenderPass();
+        command_buffer->end();
+    }
+
+    m_errorMonitor->SetBailout(NULL);
+    m_errorMonitor->VerifyNotFound();
+}
+
+TEST_F(VkPositiveLayerTest, ThreadHandleWrappingWhileRecording) {
+    TEST_DESCRIPTION("Create and destroy objects on one thread while recording commands that use other objects on another.");
+    test_platform_thread thread;
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    m_errorMonitor->ExpectSuccess();
+
+    VkEventCreateInfo event_info = {};
+    event_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    VkEvent event;
+    VkResult err = vkCreateEvent(device(), &event_info, NULL, &event);
+    ASSERT_VK_SUCCESS(err);
+
+    m_commandBuffer->begin();
+
+    struct thread_data_struct data;
+    data.commandBuffer = m_commandBuffer->handle();
+    data.device = device();
+    data.event = event;
+    data.bailout = false;
+    m_errorMonitor->SetBailout(&data.bailout);
+
+    // New handles are wrapped and retired on the second thread while this one unwraps the recorded event
+    test_platform_thread_create(&thread, CreateAndDestroyEvents, (void *)&data);
+    AddToCommandBuffer(&data);
+    test_platform_thread_join(thread, NULL);
+
+    m_commandBuffer->end();
+
+    m_errorMonitor->SetBailout(NULL);
+    m_errorMonitor->VerifyNotFound();
+
+    vkDestroyEvent(device(), event, NULL);
+}
+
+TEST_F(VkPositiveLayerTest, ThreadManyPoolsParallelRecording) {
+    TEST_DESCRIPTION("Record on many threads at once, each into a command buffer from its own pool.");
+
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    m_errorMonitor->ExpectSuccess();
+
+    VkEventCreateInfo event_info = {};
+    event_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    VkEvent event;
+    VkResult err = vkCreateEvent(device(), &event_info, NULL, &event);
+    ASSERT_VK_SUCCESS(err);
+
+    RecordOnSeparatePools(m_device, m_errorMonitor, event, 8);
+
+    m_errorMonitor->VerifyNotFound();
+
+    vkDestroyEvent(device(), event, NULL);
+}
+
+TEST_F(VkPositiveLayerTest, ThreadManyPoolsParallelRecordingConcurrent) {
+    TEST_DESCRIPTION("Record on many threads at once, each into a command buffer from its own pool, with concurrent validation.");
+
+    ScopedLayerEnables enables("VALIDATION_CHECK_ENABLE_CONCURRENT_VALIDATION");
+    ASSERT_NO_FATAL_FAILURE(Init());
+
+    m_errorMonitor->ExpectSuccess();
+
+    VkEventCreateInfo event_info = {};
+    event_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    VkEvent event;
+    VkResult err = vkCreateEvent(device(), &event_info, NULL, &event);
+    ASSERT_VK_SUCCESS(err);
+
+    RecordOnSeparatePools(m_device, m_errorMonitor, event, 8);
+
+    m_errorMonitor->VerifyNotFound();
+
+    vkDestroyEvent(device(), event, NULL);
+}
+#endif  // GTEST_IS_THREADSAFE
+
 TEST_F(VkPositiveLayerTest, ClearColorImageWithValidRange) {
     TEST_DESCRIPTION("Record clear color with a valid VkImageSubresourceRange");
 